@@ -26,6 +26,7 @@
  */
 
 #include "base.h"
+#include "record_cache.h"
 
 // global timer and path objects
 namespace base 
@@ -42,5 +43,12 @@ namespace base
 // init the base module
 bool base::init (const std::string & game, const std::string & userdatadir)
 {
-    return base::Paths().init (game, userdatadir);
+    if (!base::Paths().init (game, userdatadir)) return false;
+
+    // keep binary copies of the game's XML records
+    if (game != "")
+    {
+        base::record_cache::init (base::Paths().cfg_data_dir () + game + "-cache");
+    }
+    return true;
 }
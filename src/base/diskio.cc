@@ -28,18 +28,25 @@
 
 #include <cstdio>
 #include <fstream>
+#include <unistd.h>
 
 #include "base.h"
 #include "diskio.h"
 #include "logging.h"
 #include "diskwriter_gz.h"
+#include "diskwriter_lz.h"
+#include "diskwriter_mmap.h"
 #include "diskwriter_xml.h"
+#include "record_cache.h"
 
 using base::flat;
 using base::diskio;
 
+// records to write later
+std::list<diskio*> *diskio::Deferred = NULL;
+
 // ctor
-diskio::diskio (const diskio::file_format & format) : flat (256)
+diskio::diskio (const diskio::file_format & format) : flat (256), Format (format)
 {
     switch (format)
     {
@@ -53,6 +60,16 @@ diskio::diskio (const diskio::file_format & format) : flat (256)
             Writer = new base::disk_writer_xml ();
             break;
         }
+        case LZ_FILE:
+        {
+            Writer = new base::disk_writer_lz ();
+            break;
+        }
+        case MAPPED_FILE:
+        {
+            Writer = new base::disk_writer_mmap ();
+            break;
+        }
         case BY_EXTENSION:
         {
             Writer = NULL;
@@ -84,6 +101,12 @@ bool diskio::get_record (const std::string & filename)
         return "";
     }
 
+    return read_record (fullpath);
+}
+
+// read record from file found already
+bool diskio::read_record (const std::string & fullpath)
+{
     if (Writer == NULL)
     {
         get_writer_for_filemagic (fullpath);
@@ -91,6 +114,16 @@ bool diskio::get_record (const std::string & filename)
     
     if (Writer != NULL)
     {
+        // prefer binary copy of XML records
+        if (record_cache::enabled () && dynamic_cast<base::disk_writer_xml*> (Writer) != NULL)
+        {
+            if (record_cache::get (fullpath, *this)) return true;
+            if (!Writer->get_state (fullpath, *this)) return false;
+
+            record_cache::put (fullpath, *this);
+            return true;
+        }
+
         return Writer->get_state (fullpath, *this);
     }
     
@@ -100,6 +133,18 @@ bool diskio::get_record (const std::string & filename)
 // write record to file
 bool diskio::put_record (const std::string & filename)
 {
+    if (Deferred != NULL)
+    {
+        // keep a copy to write later
+        diskio *record = new diskio (Format);
+        record->copy (*this);
+        record->Filename = filename;
+        Deferred->push_back (record);
+
+        clear ();
+        return true;
+    }
+
     if (Writer == NULL)
     {
         get_writer_for_extension (filename);
@@ -113,17 +158,75 @@ bool diskio::put_record (const std::string & filename)
     return false;
 }
 
+// write deferred record
+bool diskio::write_record ()
+{
+    if (Writer == NULL)
+    {
+        get_writer_for_extension (Filename);
+    }
+
+    // make sure there never is a partially written file
+    std::string tmp = Filename + ".tmp";
+    if (Writer->put_state (tmp, *this))
+    {
+        if (rename (tmp.c_str (), Filename.c_str ()) == 0)
+        {
+            return true;
+        }
+
+        LOG(ERROR) << "*** diskio::write_record: cannot rename '" << tmp << "' to '" << Filename << "'!";
+    }
+
+    unlink (tmp.c_str ());
+    return false;
+}
+
 // determine file format from file extension
-void diskio::get_writer_for_extension (const std::string & filename)
+diskio::file_format diskio::format_for_extension (const std::string & filename)
 {
-    // treat file names with '.xml' extension as XML, for all others as binary
-    if (filename.compare (filename.length() - 4, 4, ".xml"))
+    if (filename.length() >= 4)
     {
-        Writer = new base::disk_writer_gz ();
+        // treat file names with '.xml' extension as XML
+        if (!filename.compare (filename.length() - 4, 4, ".xml")) return XML_FILE;
+        // and those with '.alz' extension as lz compressed
+        if (!filename.compare (filename.length() - 4, 4, ".alz")) return LZ_FILE;
     }
-    else
+    if (filename.length() >= 5)
     {
-        Writer = new base::disk_writer_xml ();
+        // those with '.amap' extension are mapped into memory
+        if (!filename.compare (filename.length() - 5, 5, ".amap")) return MAPPED_FILE;
+    }
+    
+    // all others as gz compressed binary
+    return GZ_FILE;
+}
+
+// determine writer from file extension
+void diskio::get_writer_for_extension (const std::string & filename)
+{
+    switch (format_for_extension (filename))
+    {
+        case XML_FILE:
+        {
+            Writer = new base::disk_writer_xml ();
+            break;
+        }
+        case LZ_FILE:
+        {
+            Writer = new base::disk_writer_lz ();
+            break;
+        }
+        case MAPPED_FILE:
+        {
+            Writer = new base::disk_writer_mmap ();
+            break;
+        }
+        default:
+        {
+            Writer = new base::disk_writer_gz ();
+            break;
+        }
     }
 }
 
@@ -132,19 +235,27 @@ void diskio::get_writer_for_filemagic (const std::string & filename)
 {
     static unsigned char GZ_MAGIC[2] = {0x1f, 0x8b};
 
-    char buffer[2] = { 0x00, 0x00 };
+    char buffer[4] = { 0x00, 0x00, 0x00, 0x00 };
     std::ifstream file (filename.c_str(), std::ios::binary);
     if (file.is_open())
     {
-        file.read(buffer, 2);
+        file.read(buffer, 4);
         file.close();
     }
 
-    // check for gz magic number, assume XML otherwise
+    // check for gz, lz or mapped magic number, assume XML otherwise
     if (!memcmp (buffer, GZ_MAGIC, 2))
     {
         Writer = new base::disk_writer_gz ();
     }
+    else if (!memcmp (buffer, base::disk_writer_lz::MAGIC, 4))
+    {
+        Writer = new base::disk_writer_lz ();
+    }
+    else if (!memcmp (buffer, base::disk_writer_mmap::MAGIC, 4))
+    {
+        Writer = new base::disk_writer_mmap ();
+    }
     else
     {
         Writer = new base::disk_writer_xml ();
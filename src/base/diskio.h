@@ -29,6 +29,7 @@
 #ifndef BASE_DISKIO
 #define BASE_DISKIO
 
+#include <list>
 #include "diskwriter_base.h"
 
 namespace base {
@@ -47,7 +48,9 @@ namespace base {
             {
                 GZ_FILE,
                 XML_FILE,
-                BY_EXTENSION
+                BY_EXTENSION,
+                LZ_FILE,
+                MAPPED_FILE
             } file_format;
         
             /**
@@ -71,11 +74,25 @@ namespace base {
              * resulting in an error if the checksum did not match. Data will
              * be read regardless of checksum errors, and it lies in the application's
              * responsibility whether it continues working with possibly corrupt data.
+             *
+             * Records read from XML files are taken from the record_cache instead,
+             * if it is enabled and holds an up to date copy.
              * 
              * @param filename file to read data from.
              * @return \b true on successful loading, \b false otherwise.
              */
             bool get_record (const std::string & filename);
+
+            /**
+             * Load this record from a file that has been located already,
+             * like get_record does after searching the data directories.
+             * As it does not access the search path, it is safe to call
+             * from any thread, even while the search path changes.
+             *
+             * @param fullpath full path of the file to read data from.
+             * @return \b true on successful loading, \b false otherwise.
+             */
+            bool read_record (const std::string & fullpath);
             
             /**
              * Save this record to given file, using the specified file type. 
@@ -86,14 +103,64 @@ namespace base {
              */
             bool put_record (const std::string & filename);
             //@}
+
+            /**
+             * Determine file format by file extension. File names ending in '.xml'
+             * are treated as XML files, those ending in '.alz' as lz compressed, those
+             * ending in '.amap' as uncompressed, memory mapped binary and all others as
+             * gz compressed binary.
+             *
+             * @param filename file to load or save.
+             * @return XML_FILE, LZ_FILE, MAPPED_FILE or GZ_FILE.
+             */
+            static file_format format_for_extension (const std::string & filename);
+
+#ifndef SWIG
+            /**
+             * @name Deferred Writing
+             */
+            //@{
+            /**
+             * Collect records passed to put_record() in the given list, instead
+             * of writing them to disk right away. Each record is a copy that is
+             * owned by the list. Pass NULL to write records immediately again.
+             * Only to be used from the main thread.
+             *
+             * @param records list receiving records to write later on.
+             */
+            static void set_deferred (std::list<diskio*> *records)
+            {
+                Deferred = records;
+            }
+
+            /**
+             * Check whether records are currently collected for writing them
+             * later.
+             * @return  true if put_record() defers writing.
+             */
+            static bool is_deferred ()
+            {
+                return Deferred != NULL;
+            }
+
+            /**
+             * Write a deferred record to the file originally passed to put_record().
+             * The record is written to a temporary file first, that is renamed once
+             * complete. Can be called from any thread.
+             *
+             * @return  true on success,  false otherwise.
+             */
+            bool write_record ();
+            //@}
+#endif
 #ifndef SWIG
             /// make this class available to python::pass_instance
             GET_TYPE_NAME(base::diskio)
                 
         private:
             /**
-             * Determine file format by file extension. File names ending in '.xml'
-             * are treated as XML files, all others as binary.
+             * Create file writer according to file extension.
+             * @see format_for_extension
              *
              * @param filename file to load or save.
              */
@@ -101,7 +168,9 @@ namespace base {
 
             /**
              * Determine file format by file content. Files beginning with '1f 8b'
-             * are treated as GZ compressed files, all others as XML.
+             * are treated as GZ compressed files, those beginning with '41 4c 5a 01' as
+             * LZ compressed files, those beginning with '41 4d 50 01' as mapped files,
+             * all others as XML.
              *
              * @param filename file to load or save.
              */
@@ -109,6 +178,12 @@ namespace base {
 
             /// writer to use for i/o operations
             base::disk_writer_base *Writer;
+            /// file format requested at construction
+            file_format Format;
+            /// name of the file to write a deferred record to
+            std::string Filename;
+            /// receives records while deferred writing is enabled
+            static std::list<diskio*> *Deferred;
 #endif
     };
 }
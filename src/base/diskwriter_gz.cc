@@ -26,6 +26,7 @@
  * @brief Read/write gz compressed data files.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include "base.h"
 #include "file.h"
@@ -34,6 +35,9 @@
 
 using base::disk_writer_gz;
 
+// marks records written in chunks
+const u_int32 disk_writer_gz::STREAMED;
+
 // write to gz-compressed binary file
 bool disk_writer_gz::put_state (const std::string & name, base::flat & data) const
 {
@@ -96,14 +100,57 @@ bool disk_writer_gz::get_state (const std::string & name, base::flat & data) con
     // get data size
     length << in;
     
-    // create buffer for reading data
-    char *buffer = new char[length];
-    if (!buffer) {
-        LOG(FATAL) << "disk_writer_gz::get_state: failed to allocate " << length << " bytes. Giving up ...";
+    char *buffer;
+    if (length == STREAMED)
+    {
+        // read data in chunks
+        u_int32 chunk, capacity = 1024;
+        buffer = new char[capacity];
+        length = 0;
+        
+        for (chunk << in; chunk != 0 && !in.eof (); chunk << in)
+        {
+            if (length + chunk > capacity)
+            {
+                capacity = std::max (capacity * 2, length + chunk);
+                char *tmp = new char[capacity];
+                memcpy (tmp, buffer, length);
+                delete[] buffer;
+                buffer = tmp;
+            }
+            
+            in.get_block (buffer + length, chunk);
+            length += chunk;
+        }
+        
+        // fill in values that were not known while writing the chunks
+        u_int32 count, pos, value;
+        for (count << in; count > 0 && !in.eof (); count--)
+        {
+            pos << in;
+            in.get_block (&value, 4);
+            
+            if (length < 4 || pos > length - 4)
+            {
+                LOG(ERROR) << "disk_writer_gz::get_state: invalid offset " << pos << " in file '" << name << "'.";
+                delete[] buffer;
+                return false;
+            }
+            memcpy (buffer + pos, &value, 4);
+        }
+    }
+    else
+    {
+        // create buffer for reading data
+        buffer = new char[length];
+        if (!buffer) {
+            LOG(FATAL) << "disk_writer_gz::get_state: failed to allocate " << length << " bytes. Giving up ...";
+        }
+        
+        // read data
+        in.get_block (buffer, length);
     }
     
-    // read data
-    in.get_block (buffer, length);
     data.setBuffer (buffer, length);
     
     // read checksum
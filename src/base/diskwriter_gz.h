@@ -61,6 +61,16 @@ namespace base {
         bool get_state (const std::string & name, base::flat & data) const;
 
 #ifndef SWIG
+        /**
+         * Length written to the header of records that have been saved
+         * by a base::flat_stream. The record follows as a sequence of
+         * chunks, each preceeded by its length and terminated by an
+         * empty chunk. After that come the number of values to replace
+         * in the record and pairs of offset and new value.
+         */
+        static const u_int32 STREAMED = 0xFFFFFFFF;
+
+
         /// make this class available to python::pass_instance
         GET_TYPE_NAME(base::disk_writer_gz)
 #endif // SWIG
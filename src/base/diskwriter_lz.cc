@@ -0,0 +1,294 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+ 
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software 
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file base/diskwriter_lz.cc
+ * @author agent <agent@local>
+ *
+ * @brief Read/write lz compressed data files.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "diskwriter_lz.h"
+#include "endians.h"
+#include "logging.h"
+
+using base::disk_writer_lz;
+
+// magic number of lz compressed files
+const char disk_writer_lz::MAGIC[4] = { 'A', 'L', 'Z', 1 };
+
+/// number of bits used for the match finder
+#define HASH_BITS 14
+/// matches must start at least this many bytes before the end
+#define MATCH_LIMIT 12
+/// the last bytes are always stored as literals
+#define LAST_LITERALS 5
+/// shortest possible match
+#define MIN_MATCH 4
+/// maximum distance of a match
+#define MAX_OFFSET 65535
+
+// read 4 bytes from arbitrary position
+static inline u_int32 read32 (const u_int8 *p)
+{
+    u_int32 v;
+    memcpy (&v, p, 4);
+    return v;
+}
+
+// store a length that did not fit into the token
+static inline u_int8 *put_length (u_int8 *op, u_int32 length)
+{
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = (u_int8) length;
+    return op;
+}
+
+// read a length that did not fit into the token
+static inline bool get_length (const u_int8 *& ip, const u_int8 *end, u_int32 & length)
+{
+    u_int8 b;
+    do
+    {
+        if (ip >= end) return false;
+        b = *ip++;
+        length += b;
+    }
+    while (b == 255);
+    return true;
+}
+
+// store literals and a match
+static inline u_int8 *put_sequence (u_int8 *op, const u_int8 *literals, const u_int32 & count, const u_int32 & offset, const u_int32 & match)
+{
+    u_int8 *token = op++;
+    *token = (count < 15 ? count : 15) << 4;
+    if (count >= 15) op = put_length (op, count - 15);
+
+    memcpy (op, literals, count);
+    op += count;
+
+    // last sequence has no match
+    if (match == 0) return op;
+
+    *op++ = offset & 0xFF;
+    *op++ = offset >> 8;
+
+    u_int32 extra = match - MIN_MATCH;
+    *token |= (extra < 15 ? extra : 15);
+    if (extra >= 15) op = put_length (op, extra - 15);
+
+    return op;
+}
+
+// compress block
+u_int32 disk_writer_lz::compress (const char *source, const u_int32 & length, char *dest)
+{
+    const u_int8 *src = (const u_int8 *) source;
+    u_int8 *op = (u_int8 *) dest;
+    u_int32 anchor = 0;
+
+    if (length > MATCH_LIMIT)
+    {
+        // last position seen for each hashed sequence of 4 bytes
+        std::vector<u_int32> table (1 << HASH_BITS, 0xFFFFFFFF);
+        const u_int32 limit = length - MATCH_LIMIT;
+        const u_int32 match_end = length - LAST_LITERALS;
+
+        for (u_int32 ip = 0; ip < limit; )
+        {
+            u_int32 seq = read32 (src + ip);
+            u_int32 h = (seq * 2654435761u) >> (32 - HASH_BITS);
+            u_int32 ref = table[h];
+            table[h] = ip;
+
+            if (ref == 0xFFFFFFFF || ip - ref > MAX_OFFSET || read32 (src + ref) != seq)
+            {
+                ip++;
+                continue;
+            }
+
+            u_int32 match = MIN_MATCH;
+            while (ip + match < match_end && src[ref + match] == src[ip + match]) match++;
+
+            op = put_sequence (op, src + anchor, ip - anchor, ip - ref, match);
+            ip += match;
+            anchor = ip;
+        }
+    }
+
+    op = put_sequence (op, src + anchor, length - anchor, 0, 0);
+    return op - (u_int8 *) dest;
+}
+
+// decompress block
+bool disk_writer_lz::decompress (const char *source, const u_int32 & length, char *dest, const u_int32 & size)
+{
+    const u_int8 *ip = (const u_int8 *) source;
+    const u_int8 *end = ip + length;
+    u_int8 *op = (u_int8 *) dest;
+    u_int8 *out_end = op + size;
+
+    while (ip < end)
+    {
+        u_int8 token = *ip++;
+
+        // copy literals
+        u_int32 count = token >> 4;
+        if (count == 15 && !get_length (ip, end, count)) return false;
+        if (count > (u_int32) (end - ip) || count > (u_int32) (out_end - op)) return false;
+
+        memcpy (op, ip, count);
+        ip += count;
+        op += count;
+
+        // last sequence has no match
+        if (ip == end) break;
+
+        // copy match
+        if (end - ip < 2) return false;
+        u_int32 offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (u_int32) (op - (u_int8 *) dest)) return false;
+
+        u_int32 match = token & 15;
+        if (match == 15 && !get_length (ip, end, match)) return false;
+        match += MIN_MATCH;
+        if (match > (u_int32) (out_end - op)) return false;
+
+        const u_int8 *ref = op - offset;
+        if (offset >= match)
+        {
+            memcpy (op, ref, match);
+            op += match;
+        }
+        else
+        {
+            // overlapping copy repeats the last offset bytes
+            while (match--) *op++ = *ref++;
+        }
+    }
+
+    return op == out_end;
+}
+
+// write lz compressed binary file
+bool disk_writer_lz::put_state (const std::string & name, base::flat & data) const
+{
+    FILE *out = fopen (name.c_str (), "wb");
+    if (!out)
+    {
+        LOG(ERROR) << "disk_writer_lz::put_state: cannot open '" << name << "' for writing!";
+        return false; 
+    }
+
+    char *packed = new char[bound (data.size ())];
+    u_int32 packed_length = compress (data.getBuffer (), data.size (), packed);
+
+    u_int32 header[2];
+    header[0] = SwapLE32 (data.size ());
+    header[1] = SwapLE32 (packed_length);
+    u_int32 checksum = SwapLE32 (data.checksum ());
+
+    bool result = fwrite (MAGIC, 4, 1, out) == 1 &&
+        fwrite (header, 8, 1, out) == 1 &&
+        fwrite (packed, packed_length, 1, out) == 1 &&
+        fwrite (&checksum, 4, 1, out) == 1;
+
+    result &= fclose (out) == 0;
+    delete[] packed;
+
+    if (!result)
+    {
+        LOG(ERROR) << "disk_writer_lz::put_state: error writing '" << name << "'!";
+    }
+
+    // reset
+    data.clear ();
+
+    return result;
+}
+
+// read from lz compressed binary file
+bool disk_writer_lz::get_state (const std::string & name, base::flat & data) const
+{
+    FILE *in = fopen (name.c_str (), "rb");
+    if (!in)
+    {
+        LOG(ERROR) << "disk_writer_lz::get_state: cannot open '" << name << "' for reading!";
+        return false; 
+    }
+
+    char magic[4];
+    u_int32 header[2];
+    if (fread (magic, 4, 1, in) != 1 || memcmp (magic, MAGIC, 4) != 0 ||
+        fread (header, 8, 1, in) != 1)
+    {
+        LOG(ERROR) << "disk_writer_lz::get_state: file '" << name << "' is not a valid record!";
+        fclose (in);
+        return false;
+    }
+
+    u_int32 length = SwapLE32 (header[0]);
+    u_int32 packed_length = SwapLE32 (header[1]);
+    u_int32 checksum = 0;
+
+    // the header must agree with the file size before allocating anything
+    long start = ftell (in);
+    long remaining = fseek (in, 0, SEEK_END) == 0 ? ftell (in) - start : -1;
+    if (start < 0 || remaining < 4 || packed_length > (u_int32) (remaining - 4) ||
+        length > (u_int64) packed_length * 255 || fseek (in, start, SEEK_SET) != 0)
+    {
+        LOG(ERROR) << "disk_writer_lz::get_state: file '" << name << "' is corrupt!";
+        fclose (in);
+        return false;
+    }
+
+    char *packed = new char[packed_length];
+    char *buffer = new char[length];
+
+    bool result = fread (packed, packed_length, 1, in) == 1 &&
+        fread (&checksum, 4, 1, in) == 1 &&
+        decompress (packed, packed_length, buffer, length);
+
+    fclose (in);
+    delete[] packed;
+
+    if (!result)
+    {
+        LOG(ERROR) << "disk_writer_lz::get_state: file '" << name << "' is corrupt!";
+        delete[] buffer;
+        return false;
+    }
+
+    data.setBuffer (buffer, length);
+
+    // validate checksum
+    if (SwapLE32 (checksum) != data.checksum ()) {
+        LOG(ERROR) << "disk_writer_lz::get_state: checksum error in file '" << name << "'.";
+        LOG(ERROR) << "Data might be corrupt.";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+ 
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software 
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file base/diskwriter_lz.h 
+ * @author agent <agent@local>
+ *
+ * @brief Read/write lz compressed data files.
+ */
+
+#ifndef BASE_DISKWRITER_LZ
+#define BASE_DISKWRITER_LZ
+
+#include "diskwriter_base.h"
+
+namespace base {
+    
+    /**
+     * This class provides a file writing/loading interface to the data flattener.
+     * It writes a flat object to a file compressed with a fast LZ77 codec, trading
+     * a somewhat larger file for much quicker saving and loading compared to the
+     * gz compressed format. The compressed data uses the LZ4 block format.
+     *
+     * A file consists of a 4 byte magic number, the length of the record and the
+     * length of the compressed data, followed by the compressed data and an adler32
+     * checksum of the record.
+     */
+    class disk_writer_lz : public disk_writer_base
+    {
+    public:
+        /**
+         * Save given record to file.
+         * @param name file to save record to.
+         * @param data record to save to file.
+         * @return \b true on success, \b false otherwise.
+         */
+        bool put_state (const std::string & name, base::flat & data) const;
+        
+        /**
+         * Initialize record from the given file. After loading, it will
+         * compare the checksum read from file with the one computed from
+         * the data read. It thus can detect data corruption.
+         * @param name file to read data from.
+         * @param data empty record to fill from file.
+         * @return \b true on successful loading, \b false otherwise.
+         */
+        bool get_state (const std::string & name, base::flat & data) const;
+
+#ifndef SWIG
+        /**
+         * Compress a block of data.
+         * @param src data to compress.
+         * @param length number of bytes to compress.
+         * @param dst buffer of at least bound(length) bytes.
+         * @return number of bytes written to dst.
+         */
+        static u_int32 compress (const char *src, const u_int32 & length, char *dst);
+
+        /**
+         * Decompress a block of data.
+         * @param src compressed data.
+         * @param length number of bytes of compressed data.
+         * @param dst buffer receiving the uncompressed data.
+         * @param size expected number of uncompressed bytes.
+         * @return \b true on success, \b false if the data is corrupt.
+         */
+        static bool decompress (const char *src, const u_int32 & length, char *dst, const u_int32 & size);
+
+        /**
+         * Return maximum size of compressing the given number of bytes.
+         * @param length number of bytes to compress.
+         * @return size of buffer required for compression.
+         */
+        static u_int32 bound (const u_int32 & length)
+        {
+            return length + length / 255 + 16;
+        }
+
+        /// magic number at the start of each file
+        static const char MAGIC[4];
+
+        /// make this class available to python::pass_instance
+        GET_TYPE_NAME(base::disk_writer_lz)
+#endif // SWIG
+    };
+}
+
+#endif // BASE_DISKWRITER_LZ
@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+ 
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software 
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file base/diskwriter_mmap.cc
+ * @author agent <agent@local>
+ *
+ * @brief Read/write uncompressed, memory mapped data files.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
+#include "diskwriter_mmap.h"
+#include "endians.h"
+#include "logging.h"
+
+using base::disk_writer_mmap;
+
+// magic number of mapped files
+const char disk_writer_mmap::MAGIC[4] = { 'A', 'M', 'P', 1 };
+
+/// size of the file header
+#define HEADER_SIZE 16
+
+// ctor
+disk_writer_mmap::disk_writer_mmap ()
+{
+    Mapping = NULL;
+    Length = 0;
+    Checksum = 0;
+}
+
+// dtor
+disk_writer_mmap::~disk_writer_mmap ()
+{
+    unmap ();
+}
+
+// save record to file
+bool disk_writer_mmap::put_state (const std::string & name, base::flat & data) const
+{
+    // never truncate a file that might be mapped
+    std::string tmp = name + ".tmp";
+    FILE *out = fopen (tmp.c_str (), "wb");
+    if (!out)
+    {
+        LOG(ERROR) << "disk_writer_mmap::put_state: cannot open '" << tmp << "' for writing!";
+        return false; 
+    }
+
+    u_int32 header[3];
+    header[0] = SwapLE32 (data.size ());
+    header[1] = SwapLE32 (data.checksum ());
+    header[2] = 0;
+
+    bool result = fwrite (MAGIC, 4, 1, out) == 1 &&
+        fwrite (header, 12, 1, out) == 1 &&
+        fwrite (data.getBuffer (), data.size (), 1, out) == 1;
+
+    result &= fclose (out) == 0;
+    result = result && rename (tmp.c_str (), name.c_str ()) == 0;
+
+    if (!result)
+    {
+        LOG(ERROR) << "disk_writer_mmap::put_state: error writing '" << name << "'!";
+        unlink (tmp.c_str ());
+    }
+
+    // reset
+    data.clear ();
+
+    return result;
+}
+
+// map record from file
+bool disk_writer_mmap::get_state (const std::string & name, base::flat & data) const
+{
+    FILE *in = fopen (name.c_str (), "rb");
+    if (!in)
+    {
+        LOG(ERROR) << "disk_writer_mmap::get_state: cannot open '" << name << "' for reading!";
+        return false; 
+    }
+
+    char magic[4];
+    u_int32 header[3];
+    struct stat statbuf;
+    if (fread (magic, 4, 1, in) != 1 || memcmp (magic, MAGIC, 4) != 0 ||
+        fread (header, 12, 1, in) != 1 || fstat (fileno (in), &statbuf) != 0 ||
+        (u_int64) statbuf.st_size != (u_int64) SwapLE32 (header[0]) + HEADER_SIZE || header[0] == 0)
+    {
+        LOG(ERROR) << "disk_writer_mmap::get_state: file '" << name << "' is not a valid record!";
+        fclose (in);
+        return false;
+    }
+
+    u_int32 length = SwapLE32 (header[0]);
+    u_int32 checksum = SwapLE32 (header[1]);
+
+#ifndef WIN32
+    // private, writable mapping, so that pages touched when converting
+    // the byte order of foreign files are copied instead of failing
+    void *mapping = mmap (NULL, length + HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno (in), 0);
+    fclose (in);
+
+    if (mapping == MAP_FAILED)
+    {
+        LOG(ERROR) << "disk_writer_mmap::get_state: cannot map '" << name << "'!";
+        return false;
+    }
+
+    // release previous file only after data no longer refers to it
+    char *previous = Mapping;
+    u_int32 previous_length = Length;
+
+    Mapping = (char *) mapping;
+    Length = length;
+    data.setView (Mapping + HEADER_SIZE, length);
+
+    if (previous != NULL)
+    {
+        munmap (previous, previous_length + HEADER_SIZE);
+    }
+#else
+    char *buffer = new char[length];
+    bool result = fread (buffer, length, 1, in) == 1;
+    fclose (in);
+
+    if (!result)
+    {
+        LOG(ERROR) << "disk_writer_mmap::get_state: file '" << name << "' is corrupt!";
+        delete[] buffer;
+        return false;
+    }
+
+    data.setBuffer (buffer, length);
+#endif
+
+    Checksum = checksum;
+    return true;
+}
+
+// compare checksum of loaded record
+bool disk_writer_mmap::verify (const base::flat & data) const
+{
+    if (data.checksum () != Checksum)
+    {
+        LOG(ERROR) << "disk_writer_mmap::verify: checksum error, data might be corrupt.";
+        return false;
+    }
+    return true;
+}
+
+// release mapping
+void disk_writer_mmap::unmap () const
+{
+#ifndef WIN32
+    if (Mapping != NULL)
+    {
+        munmap (Mapping, Length + HEADER_SIZE);
+    }
+#endif
+    Mapping = NULL;
+    Length = 0;
+}
@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+ 
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+ 
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software 
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file base/diskwriter_mmap.h 
+ * @author agent <agent@local>
+ *
+ * @brief Read/write uncompressed, memory mapped data files.
+ */
+
+#ifndef BASE_DISKWRITER_MMAP
+#define BASE_DISKWRITER_MMAP
+
+#include "diskwriter_base.h"
+
+namespace base {
+    
+    /**
+     * This class provides a file writing/loading interface to the data flattener.
+     * It writes a flat object uncompressed, so that loading it only requires to
+     * map the file into memory. The record then refers to the mapped file, and
+     * its pages are only read from disk once they are accessed. Since nested
+     * records are read through base::flat_view, retrieving parts of a large
+     * record, like a map, neither copies nor touches the remainder.
+     *
+     * A file consists of a 4 byte magic number, the length and checksum of the
+     * record and 4 reserved bytes, followed by the record itself.
+     *
+     * The mapping belongs to the writer and lasts until the writer is deleted
+     * or loads another file, so records loaded with it must not outlive it.
+     * As computing the checksum would read the whole file, it is not verified
+     * when loading; use verify() for that. Loading only checks that the file
+     * size matches the header, while the fields of the record and of nested
+     * records are checked to lie within their record once parsed.
+     */
+    class disk_writer_mmap : public disk_writer_base
+    {
+    public:
+        /**
+         * Create writer.
+         */
+        disk_writer_mmap ();
+
+        /**
+         * Delete writer, unmapping the file read last.
+         */
+        ~disk_writer_mmap ();
+
+        /**
+         * Save given record to file. The file is replaced once
+         * complete, so that mapped copies of it remain valid.
+         * @param name file to save record to.
+         * @param data record to save to file.
+         * @return \b true on success, \b false otherwise.
+         */
+        bool put_state (const std::string & name, base::flat & data) const;
+        
+        /**
+         * Map the given file into memory and let the record refer to it.
+         * Writing to the record will create a private copy first.
+         * @param name file to read data from.
+         * @param data empty record to fill from file.
+         * @return \b true on successful loading, \b false otherwise.
+         */
+        bool get_state (const std::string & name, base::flat & data) const;
+
+#ifndef SWIG
+        /**
+         * Compare checksum of the record loaded last with the one stored
+         * in the file. This reads the whole record.
+         * @param data record loaded last by this writer.
+         * @return \b true if the checksums match, \b false otherwise.
+         */
+        bool verify (const base::flat & data) const;
+
+        /// magic number at the start of each file
+        static const char MAGIC[4];
+
+        /// make this class available to python::pass_instance
+        GET_TYPE_NAME(base::disk_writer_mmap)
+
+    private:
+        /// release the current mapping
+        void unmap () const;
+
+        /// start of the mapped file
+        mutable char *Mapping;
+        /// size of the mapped file
+        mutable u_int32 Length;
+        /// checksum stored in the mapped file
+        mutable u_int32 Checksum;
+#endif // SWIG
+    };
+}
+
+#endif // BASE_DISKWRITER_MMAP
@@ -29,6 +29,8 @@
 #include <sstream>
 #include <vector>
 #include <libxml/parser.h>
+#include <strings.h>
+#include <sys/stat.h>
 
 #include "base.h"
 #include "diskwriter_xml.h"
@@ -178,85 +180,98 @@ static s_int32 string_to_sint (const char* value, const s_int32 & min, const s_i
     return intval;
 }
 
+/**
+ * Table for converting ascii to binary. Characters that
+ * are not hex digits map to 0.
+ */
+static const struct hex_table
+{
+    hex_table ()
+    {
+        memset (Value, 0, sizeof (Value));
+        for (u_int8 i = 0; i < 16; i++)
+        {
+            Value[(u_int8) disk_writer_xml::Bin2Hex[i]] = i;
+            Value[(u_int8) tolower (disk_writer_xml::Bin2Hex[i])] = i;
+        }
+    }
+
+    u_int8 Value[256];
+} Hex2Bin;
+
 // convert primitive params
-static void param_to_value (const data_sax_context *context)
+static void param_to_value (base::flat *record, const std::string & id, const flat::data_type & type, const char *value, const u_int32 & length)
 {
-    const char *value = context->Value.c_str();
-    
-    switch (context->Type)
+    switch (type)
     {
         case flat::T_BLOB:
         {
-            u_int32 j = 0;
-            u_int32 size = context->Value.size()/2;
+            const u_int8 *hex = (const u_int8 *) value;
+            u_int32 size = length/2;
             u_int8 *bin = new u_int8[size];
             
-            while (*value != '\0')
+            for (u_int32 j = 0; j < size; j++, hex += 2)
             {
-                bin[j] = (strchr(disk_writer_xml::Bin2Hex, *value) - disk_writer_xml::Bin2Hex) << 4;
-                bin[j] |= strchr(disk_writer_xml::Bin2Hex, *(value+1)) - disk_writer_xml::Bin2Hex;
-
-                value += 2;
-                j++;
+                bin[j] = (Hex2Bin.Value[hex[0]] << 4) | Hex2Bin.Value[hex[1]];
             }
 
-            context->Record->put_block (context->Id, bin, size);
+            record->put_block (id, bin, size);
             delete[] bin;
             break;
         }
         case flat::T_BOOL:
         {
-            context->Record->put_bool (context->Id, string_to_sint (value, 0, 1) == 1);
+            record->put_bool (id, string_to_sint (value, 0, 1) == 1);
             break;
         }
         case flat::T_CHAR:
         {
-            context->Record->put_char (context->Id, value[0]);
+            record->put_char (id, value[0]);
             break;
         }
         case flat::T_DOUBLE:
         {
-            context->Record->put_double (context->Id, strtod (value, NULL));
+            record->put_double (id, strtod (value, NULL));
             break;
         }
         case flat::T_FLOAT:
         {
-            context->Record->put_float (context->Id, strtod (value, NULL));
+            record->put_float (id, strtod (value, NULL));
             break;
         }
         case flat::T_SINT8:
         {
-            context->Record->put_sint8 (context->Id, (s_int8) string_to_sint (value, INT8_MIN, INT8_MAX));
+            record->put_sint8 (id, (s_int8) string_to_sint (value, INT8_MIN, INT8_MAX));
             break;
         }
         case flat::T_SINT16:
         {
-            context->Record->put_sint16 (context->Id, (s_int16) string_to_sint (value, INT16_MIN, INT16_MAX));
+            record->put_sint16 (id, (s_int16) string_to_sint (value, INT16_MIN, INT16_MAX));
             break;
         }
         case flat::T_SINT32:
         {
-            context->Record->put_sint32 (context->Id, (s_int32) string_to_sint (value, INT32_MIN, INT32_MAX));
+            record->put_sint32 (id, (s_int32) string_to_sint (value, INT32_MIN, INT32_MAX));
             break;
         }
         case flat::T_STRING:
         {
-            context->Record->put_string (context->Id, value);
+            record->put_string (id, value);
             break;
         }
         case flat::T_UINT8:
         {
-            context->Record->put_uint8 (context->Id, (u_int8) string_to_uint (value, UINT8_MAX));
+            record->put_uint8 (id, (u_int8) string_to_uint (value, UINT8_MAX));
             break;
         }
         case flat::T_UINT16:
         {
-            context->Record->put_uint16 (context->Id, (u_int16) string_to_uint (value, UINT16_MAX));
+            record->put_uint16 (id, (u_int16) string_to_uint (value, UINT16_MAX));
             break;
         }
         case flat::T_UINT32:
         {
-            context->Record->put_uint32 (context->Id, (u_int32) string_to_uint (value, UINT32_MAX));
+            record->put_uint32 (id, (u_int32) string_to_uint (value, UINT32_MAX));
             break;
         }
         default:
@@ -397,7 +412,7 @@ static void data_end_element (void *ctx, const xmlChar *name)
         case disk_writer_xml::PARAM:
         {
         	// convert and add value of param just read 
-            param_to_value (context);
+            param_to_value (context->Record, context->Id, context->Type, context->Value.c_str (), context->Value.size ());
             context->State = disk_writer_xml::LIST;
             break;
         }
@@ -503,13 +518,483 @@ xmlSAXHandler data_sax_handler = {
     NULL, /* getParameterEntity */
     NULL, /* cdataBlock; */
     NULL, /* externalSubset; */
-    XML_SAX2_MAGIC,
+    1, /* initialized; SAX1 callbacks only */
     NULL,
     NULL, /* startElementNsDebug */
     NULL, /* endElementNsDebug */
     NULL
 };
 
+/**
+ * Hand-written reader for the subset of XML written by disk_writer_xml.
+ * It parses the document in place, without building intermediate element
+ * or attribute lists, and reuses its string and record buffers for every
+ * element. Anything outside of that subset, such as a DTD, CDATA sections
+ * or non UTF-8 encodings, makes it give up, so that the file can still be
+ * read by libxml2.
+ */
+class data_xml_reader
+{
+public:
+    /**
+     * Create reader for the given document.
+     * @param buffer the xml document.
+     * @param length size of the document in bytes.
+     */
+    data_xml_reader (const char *buffer, const u_int32 & length)
+    {
+        Ptr = buffer;
+        End = buffer + length;
+    }
+
+    /**
+     * Delete reader and the records used for nested lists.
+     */
+    ~data_xml_reader ()
+    {
+        for (std::vector<base::flat*>::iterator i = Records.begin (); i != Records.end (); i++)
+        {
+            delete *i;
+        }
+    }
+
+    /**
+     * Read the whole document into the given record.
+     * @param data record to fill.
+     * @return \b true on success, \b false if document is not supported.
+     */
+    bool parse (base::flat & data)
+    {
+        // skip byte order mark
+        if (End - Ptr >= 3 && memcmp (Ptr, "\xEF\xBB\xBF", 3) == 0) Ptr += 3;
+
+        if (!skip_misc ()) return false;
+
+        // root node
+        const char *name;
+        u_int32 length;
+        bool empty;
+        if (!read_start_tag (&name, &length, NULL, &empty)) return false;
+        if (length != strlen (XML_ROOT_NODE) || memcmp (name, XML_ROOT_NODE, length) != 0) return false;
+
+        if (!empty && !read_list (data, 0, name, length)) return false;
+
+        // nothing but comments and whitespace may follow
+        return skip_misc () && Ptr == End;
+    }
+
+private:
+    /**
+     * Read the children of a list element, up to and including its end tag.
+     * @param record record to add children to.
+     * @param depth nesting level of list.
+     * @param tag name of the list element.
+     * @param tag_len length of the name.
+     * @return \b true on success, \b false otherwise.
+     */
+    bool read_list (base::flat & record, const u_int32 & depth, const char *tag, const u_int32 & tag_len)
+    {
+        // make sure id and record for child lists are available
+        if (Ids.size () <= depth)
+        {
+            Ids.resize (depth + 1);
+            Records.push_back (new base::flat (16));
+        }
+
+        const char *name;
+        u_int32 length;
+        bool empty;
+
+        while (true)
+        {
+            // character data between elements is ignored
+            Ptr = (const char *) memchr (Ptr, '<', End - Ptr);
+            if (Ptr == NULL || Ptr + 1 >= End) return false;
+
+            switch (Ptr[1])
+            {
+                case '/':
+                {
+                    return read_end_tag (tag, tag_len);
+                }
+                case '!':
+                case '?':
+                {
+                    if (!skip_markup ()) return false;
+                    continue;
+                }
+            }
+
+            if (!read_start_tag (&name, &length, &Ids[depth], &empty)) return false;
+
+            flat::data_type type = type_for_name (name, length);
+            switch (type)
+            {
+                case flat::T_UNKNOWN:
+                {
+                    return false;
+                }
+                case flat::T_FLAT:
+                {
+                    base::flat *child = Records[depth];
+                    child->clear ();
+                    if (!empty && !read_list (*child, depth + 1, name, length)) return false;
+                    // nested lists may have resized Ids
+                    record.put_flat (Ids[depth], *child);
+                    break;
+                }
+                default:
+                {
+                    Text.clear ();
+                    if (!empty && !read_text (name, length)) return false;
+                    param_to_value (&record, Ids[depth], type, Text.c_str (), Text.size ());
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Read the character data of a primitive element, up to and including
+     * its end tag.
+     * @param tag name of the element.
+     * @param tag_len length of the name.
+     * @return \b true on success, \b false otherwise.
+     */
+    bool read_text (const char *tag, const u_int32 & tag_len)
+    {
+        while (Ptr < End)
+        {
+            // copy plain characters in one go
+            const char *start = Ptr;
+            while (Ptr < End && *Ptr != '<' && *Ptr != '&' && *Ptr != '\r') Ptr++;
+            Text.append (start, Ptr - start);
+            if (Ptr == End) return false;
+
+            switch (*Ptr)
+            {
+                case '&':
+                {
+                    if (!read_reference (Text)) return false;
+                    break;
+                }
+                case '\r':
+                {
+                    // line ends are normalized to '\n'
+                    Text += '\n';
+                    if (++Ptr < End && *Ptr == '\n') Ptr++;
+                    break;
+                }
+                default:
+                {
+                    if (Ptr + 1 < End && Ptr[1] == '/') return read_end_tag (tag, tag_len);
+                    // only comments may appear inside primitive elements
+                    if (End - Ptr < 4 || memcmp (Ptr, "<!--", 4) != 0 || !skip_markup ()) return false;
+                    break;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Read an opening tag and its attributes.
+     * @param name will point to element name.
+     * @param length will receive length of element name.
+     * @param id will receive value of the id attribute, if not NULL.
+     * @param empty will be set if tag has no content.
+     * @return \b true on success, \b false otherwise.
+     */
+    bool read_start_tag (const char **name, u_int32 *length, std::string *id, bool *empty)
+    {
+        if (Ptr >= End || *Ptr != '<') return false;
+        *name = ++Ptr;
+        while (Ptr < End && !is_space (*Ptr) && *Ptr != '/' && *Ptr != '>') Ptr++;
+        *length = Ptr - *name;
+        if (*length == 0) return false;
+
+        if (id != NULL) id->clear ();
+        bool found_id = false;
+
+        while (true)
+        {
+            skip_space ();
+            if (Ptr >= End) return false;
+
+            if (*Ptr == '>')
+            {
+                Ptr++;
+                *empty = false;
+                return true;
+            }
+            if (*Ptr == '/')
+            {
+                if (++Ptr >= End || *Ptr != '>') return false;
+                Ptr++;
+                *empty = true;
+                return true;
+            }
+
+            // attribute name
+            const char *attr = Ptr;
+            while (Ptr < End && !is_space (*Ptr) && *Ptr != '=' && *Ptr != '>' && *Ptr != '/') Ptr++;
+            u_int32 attr_len = Ptr - attr;
+            skip_space ();
+            if (attr_len == 0 || Ptr >= End || *Ptr++ != '=') return false;
+            skip_space ();
+
+            // like the SAX reader, use the first attribute starting with "id"
+            if (id != NULL && !found_id && attr_len >= 2 && attr[0] == 'i' && attr[1] == 'd')
+            {
+                found_id = true;
+                if (!read_attribute_value (id)) return false;
+            }
+            else if (!read_attribute_value (NULL)) return false;
+        }
+    }
+
+    /**
+     * Read a closing tag.
+     * @param tag name the tag must have.
+     * @param tag_len length of the name.
+     * @return \b true on success, \b false otherwise.
+     */
+    bool read_end_tag (const char *tag, const u_int32 & tag_len)
+    {
+        Ptr += 2;
+        if (End - Ptr < (long) tag_len || memcmp (Ptr, tag, tag_len) != 0) return false;
+        Ptr += tag_len;
+        skip_space ();
+        if (Ptr >= End || *Ptr != '>') return false;
+        Ptr++;
+        return true;
+    }
+
+    /**
+     * Read a quoted attribute value.
+     * @param value will receive the normalized value, if not NULL.
+     * @return \b true on success, \b false otherwise.
+     */
+    bool read_attribute_value (std::string *value)
+    {
+        if (Ptr >= End || (*Ptr != '"' && *Ptr != '\'')) return false;
+        const char quote = *Ptr++;
+
+        while (Ptr < End && *Ptr != quote)
+        {
+            switch (*Ptr)
+            {
+                case '<':
+                {
+                    return false;
+                }
+                case '&':
+                {
+                    if (value != NULL)
+                    {
+                        if (!read_reference (*value)) return false;
+                    }
+                    else Ptr++;
+                    break;
+                }
+                case '\r':
+                {
+                    // line ends count as a single whitespace
+                    if (Ptr + 1 < End && Ptr[1] == '\n') Ptr++;
+                    // fall through
+                }
+                case '\t':
+                case '\n':
+                {
+                    if (value != NULL) *value += ' ';
+                    Ptr++;
+                    break;
+                }
+                default:
+                {
+                    if (value != NULL) *value += *Ptr;
+                    Ptr++;
+                    break;
+                }
+            }
+        }
+
+        if (Ptr >= End) return false;
+        Ptr++;
+        return true;
+    }
+
+    /**
+     * Decode a predefined entity or character reference.
+     * @param text string to append the decoded character to.
+     * @return \b true on success, \b false for other entities.
+     */
+    bool read_reference (std::string & text)
+    {
+        const char *start = ++Ptr;
+        while (Ptr < End && *Ptr != ';' && Ptr - start < 12) Ptr++;
+        if (Ptr >= End || *Ptr != ';') return false;
+        u_int32 length = Ptr++ - start;
+
+        if (length > 1 && start[0] == '#')
+        {
+            char *end = NULL;
+            u_int32 code = (start[1] == 'x') ?
+                strtoul (start + 2, &end, 16) : strtoul (start + 1, &end, 10);
+            if (end != start + length || code == 0 || code > 0x10FFFF) return false;
+
+            // encode as UTF-8
+            if (code < 0x80)
+            {
+                text += (char) code;
+            }
+            else if (code < 0x800)
+            {
+                text += (char) (0xC0 | (code >> 6));
+                text += (char) (0x80 | (code & 0x3F));
+            }
+            else if (code < 0x10000)
+            {
+                text += (char) (0xE0 | (code >> 12));
+                text += (char) (0x80 | ((code >> 6) & 0x3F));
+                text += (char) (0x80 | (code & 0x3F));
+            }
+            else
+            {
+                text += (char) (0xF0 | (code >> 18));
+                text += (char) (0x80 | ((code >> 12) & 0x3F));
+                text += (char) (0x80 | ((code >> 6) & 0x3F));
+                text += (char) (0x80 | (code & 0x3F));
+            }
+            return true;
+        }
+
+        if (length == 3 && memcmp (start, "amp", 3) == 0) text += '&';
+        else if (length == 2 && memcmp (start, "lt", 2) == 0) text += '<';
+        else if (length == 2 && memcmp (start, "gt", 2) == 0) text += '>';
+        else if (length == 4 && memcmp (start, "quot", 4) == 0) text += '"';
+        else if (length == 4 && memcmp (start, "apos", 4) == 0) text += '\'';
+        else return false;
+
+        return true;
+    }
+
+    /**
+     * Skip whitespace, comments and processing instructions.
+     * @return \b true on success, \b false on unsupported markup.
+     */
+    bool skip_misc ()
+    {
+        while (true)
+        {
+            skip_space ();
+            if (End - Ptr < 2 || *Ptr != '<' || (Ptr[1] != '!' && Ptr[1] != '?')) return true;
+            if (!skip_markup ()) return false;
+        }
+    }
+
+    /**
+     * Skip a comment or processing instruction. The xml declaration
+     * is checked for an encoding other than UTF-8.
+     * @return \b true on success, \b false on unsupported markup.
+     */
+    bool skip_markup ()
+    {
+        if (End - Ptr >= 4 && memcmp (Ptr, "<!--", 4) == 0)
+        {
+            return skip_past ("-->", Ptr + 4);
+        }
+        if (End - Ptr >= 2 && Ptr[1] == '?')
+        {
+            const char *start = Ptr;
+            if (!skip_past ("?>", Ptr + 2)) return false;
+            if (Ptr - start > 5 && memcmp (start, "<?xml", 5) == 0 && is_space (start[5]))
+            {
+                std::string decl (start, Ptr - start);
+                std::string::size_type pos = decl.find ("encoding");
+                if (pos != std::string::npos)
+                {
+                    pos = decl.find_first_of ("\"'", pos);
+                    if (pos == std::string::npos) return false;
+                    if (decl.size () < pos + 7 || strncasecmp (decl.c_str () + pos + 1, "UTF-8", 5) != 0 || decl[pos + 6] != decl[pos]) return false;
+                }
+            }
+            return true;
+        }
+
+        // DOCTYPE, CDATA
+        return false;
+    }
+
+    /**
+     * Move past the next occurrence of the given string.
+     * @param marker string to search for.
+     * @param from position to start searching.
+     * @return \b true on success, \b false if marker was not found.
+     */
+    bool skip_past (const char *marker, const char *from)
+    {
+        const u_int32 length = strlen (marker);
+        for (Ptr = from; End - Ptr >= (long) length; Ptr++)
+        {
+            if (*Ptr == *marker && memcmp (Ptr, marker, length) == 0)
+            {
+                Ptr += length;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Move past whitespace.
+     */
+    void skip_space ()
+    {
+        while (Ptr < End && is_space (*Ptr)) Ptr++;
+    }
+
+    /**
+     * Check for xml whitespace.
+     * @param c character to check.
+     * @return \b true if character is whitespace.
+     */
+    static bool is_space (const char & c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+    /**
+     * Get type for given element name, without logging unknown names.
+     * @param name element name.
+     * @param length length of element name.
+     * @return type of element or T_UNKNOWN.
+     */
+    static flat::data_type type_for_name (const char *name, const u_int32 & length)
+    {
+        for (int i = 0; i < flat::NBR_TYPES; i++)
+        {
+            const char *type = flat::name_for_type ((flat::data_type) i);
+            if (strncmp (type, name, length) == 0 && type[length] == '\0')
+            {
+                return (flat::data_type) i;
+            }
+        }
+        return flat::T_UNKNOWN;
+    }
+
+    /// current position in document
+    const char *Ptr;
+    /// end of document
+    const char *End;
+    /// value of primitive element
+    std::string Text;
+    /// id attribute of element, for each nesting level
+    std::vector<std::string> Ids;
+    /// records for nested lists, for each nesting level
+    std::vector<base::flat*> Records;
+};
+
 // save record to XML file
 bool disk_writer_xml::put_state (const std::string & name, base::flat & data) const
 {
@@ -539,6 +1024,41 @@ bool disk_writer_xml::put_state (const std::string & name, base::flat & data) co
 
 // read record from XML file
 bool disk_writer_xml::get_state (const std::string & name, base::flat & data) const
+{
+    // clear contents of data
+    data.clear ();
+
+    // read whole file and parse it in place
+    FILE *file = fopen (name.c_str (), "rb");
+    if (file != NULL)
+    {
+        std::vector<char> buffer;
+        struct stat statbuf;
+        if (fstat (fileno (file), &statbuf) == 0 && statbuf.st_size > 0)
+        {
+            buffer.resize (statbuf.st_size);
+            buffer.resize (fread (&buffer[0], 1, buffer.size (), file));
+        }
+        fclose (file);
+        if (!buffer.empty () && parse (&buffer[0], buffer.size (), data)) return true;
+    }
+
+    // not something the fast reader understands
+    VLOG(1) << "disk_writer_xml::get_state: reading '" << name << "' with libxml2";
+    return get_state_sax (name, data);
+}
+
+// read XML document from memory
+bool disk_writer_xml::parse (const char *buffer, const u_int32 & length, base::flat & data)
+{
+    data.clear ();
+
+    data_xml_reader reader (buffer, length);
+    return reader.parse (data);
+}
+
+// read record from XML file with libxml2
+bool disk_writer_xml::get_state_sax (const std::string & name, base::flat & data) const
 {
     // clear contents of data
     data.clear ();
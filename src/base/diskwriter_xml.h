@@ -66,6 +66,30 @@ namespace base {
         bool get_state (const std::string & name, base::flat & data) const;
         
 #ifndef SWIG
+        /**
+         * Initialize record from an xml file, using the libxml2 SAX parser.
+         * Unlike get_state, this accepts any well-formed document, but it is
+         * much slower and not reentrant.
+         * @param name file to read data from.
+         * @param data empty record to fill from file.
+         * @return \b true on successful loading, \b false otherwise.
+         */
+        bool get_state_sax (const std::string & name, base::flat & data) const;
+
+        /**
+         * Initialize record from an xml document in memory. This only
+         * understands the subset of XML written by put_state (plus comments
+         * and whitespace), but is several times faster than libxml2.
+         * get_state uses it for every file, falling back to libxml2 if it
+         * fails.
+         * @param buffer the xml document.
+         * @param length size of the document.
+         * @param data empty record to fill.
+         * @return \b true on success, \b false if document cannot be read.
+         */
+        static bool parse (const char *buffer, const u_int32 & length, base::flat & data);
+
+
         /// Table storing hex characters
         static const char *Bin2Hex;
 
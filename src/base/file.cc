@@ -64,10 +64,12 @@ bool gz_file::open (const string & fname, gz_type t)
     return true;
 }
 
-void gz_file::close ()
+bool gz_file::close ()
 {
-    if (is_open ()) gzclose (file);
+    bool result = true;
+    if (is_open ()) result = gzclose (file) == Z_OK;
     opened = false;
+    return result;
 }
 
 igzstream::igzstream () : gz_file ()
@@ -91,8 +91,9 @@ namespace base
         /** 
          * Close the file that was opened.
          * 
+         * @return false if pending data could not be written.
          */
-        void close ();
+        bool close ();
     
         /** 
          * Returns whether the file is opened or not.
@@ -112,6 +113,18 @@ namespace base
         {
             return gzeof (file); 
         }
+
+        /**
+         * Returns whether all operations on the file succeeded so far.
+         *
+         * @return false if reading or writing failed.
+         */
+        bool good ()
+        {
+            int error = Z_OK;
+            if (is_open ()) gzerror (file, &error);
+            return error == Z_OK || error == Z_STREAM_END;
+        }
         
     protected:
         /** 
@@ -41,6 +41,9 @@
 
 using base::flat;
 
+// buffer of an empty record
+char flat::EmptyRecord[1] = { DATA_BYTE_ORDER };
+
 // names for supported data types
 const char* flat::TypeName[flat::NBR_TYPES] =  {
         "bool", "char", "u_int8", "s_int8", "u_int16", "s_int16",
@@ -50,14 +53,25 @@ const char* flat::TypeName[flat::NBR_TYPES] =  {
 // ctor
 flat::flat (const u_int16 & size)
 {
-    // this is the maximum capacity of the buffer
-    Capacity = (size != 0 ? size : 1);
-    
-    Buffer = new char[Capacity];
-    memset (Buffer, '\0', Capacity);
-    
-    // first byte in the buffer contains the byte order
-    Buffer[0] = DATA_BYTE_ORDER;
+    if (size != 0)
+    {
+        // this is the maximum capacity of the buffer
+        Capacity = size;
+
+        Buffer = new char[Capacity];
+        memset (Buffer, '\0', Capacity);
+
+        // first byte in the buffer contains the byte order
+        Buffer[0] = DATA_BYTE_ORDER;
+        Owned = true;
+    }
+    else
+    {
+        // no need to allocate anything until data is added
+        Capacity = 1;
+        Buffer = EmptyRecord;
+        Owned = false;
+    }
     
     // this is the current size of content in the buffer
     Size = 1;
@@ -65,13 +79,18 @@ flat::flat (const u_int16 & size)
     Success = true;
     Ptr = Buffer + 1;
     Data = NULL;
+    Index = NULL;
+    Count = 0;
+    Decoded = 0;
 }
 
 // create a flat from internal buffer of another flat
 flat::flat (const char *buffer, const u_int32 & size)
 {
     Data = NULL;
+    Index = NULL;
     Buffer = NULL;
+    Owned = false;
     
     char *tmp = new char[size];
     memcpy (tmp, buffer, size);
@@ -82,7 +101,9 @@ flat::flat (const char *buffer, const u_int32 & size)
 flat::flat (const flat & f) 
 {
     Data = NULL;
+    Index = NULL;
     Buffer = NULL;
+    Owned = false;
 
     copy (f);
 }
@@ -101,7 +122,10 @@ void flat::put (const string & name, const data_type & type, const u_int32 & siz
 	u_int8 t = type;
     u_int32 nl = name.length () + 1;
     u_int32 need = size + nl + 5;
-    while (Size + need > Capacity) grow ();
+    if (!Owned || Size + need > Capacity) overflow (need);
+    
+    // fields decoded so far might refer to a buffer that has been replaced
+    if (Data != NULL) unparse ();
     
     memcpy (Ptr, name.c_str (), nl);
     Ptr += nl;
@@ -114,37 +138,44 @@ void flat::put (const string & name, const data_type & type, const u_int32 & siz
     Size += need;
 }
 
+// start a nested record
+u_int32 flat::begin_flat (const string & name)
+{
+    // the nested record starts with its byte order
+    const char order = DATA_BYTE_ORDER;
+    put (name, T_FLAT, 1, &order);
+    
+    // its size is filled in once it is complete
+    const u_int32 start = position () - 5;
+    patch (start, 0);
+    
+    return start;
+}
+
+// finish a nested record
+void flat::end_flat (const u_int32 & start)
+{
+    patch (start, position () - start - 4);
+}
+
 // retrieve given data
 flat::data* flat::get (const string & name, const data_type & type, const bool & optional)
 {
     if (Data == NULL) 
     {
         parse ();
-        Decoded = Data;
+        Decoded = 0;
     }
     
-    data *result = NULL;
-    data *current = Decoded;
-    
     // search from current position
-    for (; Decoded != NULL; Decoded = Decoded->Next)
-        if (strcmp (Decoded->Name, name.c_str ()) == 0) {
-            result = Decoded;
-            break;
-        }
-        
-    // not found, so restart from beginning
-    if (result == NULL)
-        for (Decoded = Data; Decoded != current; Decoded = Decoded->Next)
-            if (strcmp (Decoded->Name, name.c_str ()) == 0) {
-                result = Decoded;
-                break;
-            }
-
+    u_int32 pos = find (name.c_str ());
+    
     // in case we have a result ...
-    if (result != NULL) {
+    if (pos < Count) {
+        data *result = Data + pos;
+
         // fetch next piece of data
-        Decoded = Decoded->Next;
+        Decoded = pos + 1;
         
         // check whether types match
         if (result->Type == type) {
@@ -166,25 +197,103 @@ flat::data* flat::get (const string & name, const data_type & type, const bool &
     return NULL;
 }
 
+// hash a field name (FNV-1a)
+static u_int32 hash_name (const char *name)
+{
+    u_int32 h = 2166136261u;
+    while (*name) 
+    {
+        h = (h ^ (u_int8) *name++) * 16777619u;
+    }
+    return h;
+}
+
+// locate field by name
+u_int32 flat::find (const char *name)
+{
+    // usually, fields are read in the order they have been written
+    if (Decoded < Count && strcmp (Data[Decoded].Name, name) == 0)
+        return Decoded;
+    
+    // small records are searched sequentially
+    if (Count <= 8)
+    {
+        for (u_int32 i = Decoded; i < Count; i++)
+            if (strcmp (Data[i].Name, name) == 0) return i;
+        
+        // not found, so restart from beginning
+        for (u_int32 i = 0; i < Decoded && i < Count; i++)
+            if (strcmp (Data[i].Name, name) == 0) return i;
+        
+        return Count;
+    }
+    
+    if (Index == NULL) index ();
+    
+    for (u_int32 slot = hash_name (name) & IndexMask; Index[slot] != 0; slot = (slot + 1) & IndexMask)
+    {
+        u_int32 first = Index[slot] - 1;
+        if (strcmp (Data[first].Name, name) != 0) continue;
+        
+        // in case of duplicate names, prefer the first at or after current position
+        for (u_int32 i = first; i < Count; i = Data[i].Same)
+            if (i >= Decoded) return i;
+        
+        // otherwise restart from beginning
+        return first;
+    }
+    
+    return Count;
+}
+
+// build hash table of field names
+void flat::index ()
+{
+    u_int32 slots = 16;
+    while (slots < Count * 2) slots *= 2;
+    
+    IndexMask = slots - 1;
+    Index = new u_int32[slots];
+    memset (Index, 0, slots * sizeof (u_int32));
+    
+    for (u_int32 pos = 0; pos < Count; pos++)
+    {
+        u_int32 slot = hash_name (Data[pos].Name) & IndexMask;
+        for (; Index[slot] != 0; slot = (slot + 1) & IndexMask)
+        {
+            u_int32 i = Index[slot] - 1;
+            if (strcmp (Data[i].Name, Data[pos].Name) == 0)
+            {
+                // append duplicate name to the end of the chain
+                while (Data[i].Same < Count) i = Data[i].Same;
+                Data[i].Same = pos;
+                break;
+            }
+        }
+        
+        if (Index[slot] == 0) Index[slot] = pos + 1;
+    }
+}
+
 // iterate over data
 flat::data_type flat::next (void **value, u_int32 *size, char **name)
 {
     if (Data == NULL)
     {
         parse ();
-        Decoded = Data;
+        Decoded = 0;
     }
     
-    if (Decoded != NULL)
+    if (Decoded < Count)
     {
-        data_type type = Decoded->Type;
-        *value = Decoded->Content;
+        data *decoded = Data + Decoded;
+        *value = decoded->Content;
 
-        if (size != NULL) *size = Decoded->Size;
-        if (name != NULL) *name = Decoded->Name;
+        if (size != NULL) *size = decoded->Size;
+        if (name != NULL) *name = decoded->Name;
     
-        Decoded = Decoded->Next;
-        return type;
+        Decoded++;
+        return decoded->Type;
     }
     
     // error respectively EOF
@@ -198,17 +307,42 @@ void flat::parse ()
     
     // whether we need to swap byte order or not
     bool swap = (Buffer[0] != DATA_BYTE_ORDER);
-    Buffer[0] = DATA_BYTE_ORDER;
     
-    data *first = 0, *decoded = 0;
+    // count fields, so that they can be stored in a single array
     u_int32 pos = 1;
+    Count = 0;
+    while (pos < Size)
+    {
+        // records that have not been checksummed might be corrupt,
+        // so fields must not extend past the end of the buffer
+        const char *end = (const char *) memchr (Buffer + pos, 0, Size - pos);
+        if (end == NULL || (u_int32) (end - Buffer) + 6 > Size) break;
+        pos = end - Buffer + 2;
+        
+        u_int32 size = *((u_int32*) (Buffer + pos));
+        if (swap) size = Swap32 (size);
+        if (size > Size - pos - 4) break;
+        
+        pos += size + 4;
+        Count++;
+    }
+    
+    if (pos < Size)
+    {
+        LOG(ERROR) << "*** flat::parse: record is corrupt, ignoring last " << Size - pos << " bytes";
+        Success = false;
+    }
+    
+    Data = new data[Count];
+    
+    // avoid writing to buffers that are only read
+    if (swap) Buffer[0] = DATA_BYTE_ORDER;
     Ptr = Buffer + 1;
     
-    while (pos < Size) 
+    for (u_int32 i = 0; i < Count; i++)
     {
-        decoded = new data;
-        if (Data != NULL) Data->Next = decoded;
-        else first = decoded;
+        data *decoded = Data + i;
+        decoded->Same = Count;
         
         decoded->Name = (char *) Ptr;
         Ptr += (strlen ((char*) Ptr) + 1);
@@ -259,13 +393,19 @@ void flat::parse ()
         
         decoded->Content = Ptr;
         Ptr = Ptr + decoded->Size;
-        
-        Data = decoded;
-        pos += strlen (decoded->Name) + decoded->Size + 6;
     }
+}
 
-    decoded->Next = NULL;
-    Data = first;
+// discard unflattened data
+void flat::unparse ()
+{
+    delete[] Data;
+    delete[] Index;
+    
+    Data = NULL;
+    Index = NULL;
+    Count = 0;
+    Decoded = 0;
 }
 
 // calculate checksum of internal buffer
@@ -275,6 +415,19 @@ u_int32 flat::checksum () const
     return adler32 (a32, (Bytef*) Buffer, Size);
 }
 
+// make room for more data
+void flat::overflow (const u_int32 & need)
+{
+    while (!Owned || Size + need > Capacity) grow ();
+}
+
+// overwrite value in buffer
+void flat::patch (const u_int32 & pos, const u_int32 & value)
+{
+    if (Data != NULL) unparse ();
+    memcpy (Buffer + pos, &value, 4);
+}
+
 // grow internal buffer
 void flat::grow ()
 {
@@ -285,10 +438,24 @@ void flat::grow ()
         LOG(FATAL) << "*** flat::grow: failed to allocate " << Capacity << " more bytes. Giving up ...";
     }
     
+    // no need to clear the remainder, as it is never read before written
     memcpy (tmp, Buffer, Size);
-    memset (tmp + Size, '\0', Capacity - Size);
-    delete[] Buffer;
+    if (Owned) delete[] Buffer;
     
     Buffer = tmp;
     Ptr = Buffer + Size;
+    Owned = true;
+}
+
+// refer to a nested record
+base::flat_view::flat_view (flat & parent, const string & name, bool optional) : flat (0)
+{
+    data *d = parent.get (name, T_FLAT, optional);
+    if (d) setView (d->Content, d->Size);
+}
+
+// refer to a nested record returned by next()
+base::flat_view::flat_view (void *value, const u_int32 & size) : flat (0)
+{
+    setView ((char *) value, size);
 }
@@ -101,9 +101,8 @@ namespace base
 		            u_int32 Size;
 		            char* Content;
                     
-		            data *Next;
-		                
-		            ~data () { delete Next; }
+		            /// index of the next field with the same name
+		            u_int32 Same;
 		    };
 #endif // SWIG
         
@@ -141,8 +140,8 @@ namespace base
              * Destructor
              */
             virtual ~flat () {
-                delete[] Buffer;
-                delete Data;
+                if (Owned) delete[] Buffer;
+                unparse ();
             }
 
             /**
@@ -151,8 +150,7 @@ namespace base
              */
             void clear () {
                 Size = 1;
-                delete Data;
-                Data = NULL;
+                unparse ();
                 Ptr = Buffer + 1;
                 Success = true;
             }
@@ -313,6 +311,24 @@ namespace base
             void put_flat (const string & name, const flat & out) {
                 put (name, T_FLAT, out.size (), out.getBuffer ());
             }
+
+            /**
+             * Start a nested record. Everything stored until the matching
+             * call to end_flat() goes into the nested record, which can be
+             * retrieved as if it had been stored with put_flat(). Unlike
+             * the latter, this does not require building the nested
+             * record in memory first. Nested records may be started
+             * within each other, as long as they are ended in reverse order.
+             * @param name id used to retrieve the record later on.
+             * @return position to pass to end_flat().
+             */
+            u_int32 begin_flat (const string & name);
+
+            /**
+             * Finish a nested record started with begin_flat().
+             * @param start the value returned by begin_flat().
+             */
+            void end_flat (const u_int32 & start);
             //@}
             
             /**
@@ -506,7 +522,7 @@ namespace base
              */
             void first ()
             {
-                Decoded = Data;
+                Decoded = 0;
             }
             
             /**
@@ -601,15 +617,15 @@ namespace base
              * @param size length of the byte array.
              */
             void setBuffer (char* buffer, const u_int32 & size) {
-                delete[] Buffer;
-                delete Data;
+                if (Owned) delete[] Buffer;
+                unparse ();
 
                 Buffer = buffer;
                 Capacity = size;
                 Success = true;
                 Ptr = Buffer + 1;
                 Size = size;
-                Data = NULL;
+                Owned = true;
             }
 #endif // SWIG
             
@@ -620,12 +636,64 @@ namespace base
             void copy (const flat & source);
 	        //@}
             
+#ifndef SWIG
+        protected:
+            /**
+             * Refer to the given buffer instead of owning a copy of it.
+             * Writing to the flattener will create a private copy first.
+             * @param buffer byte array containing flattened data.
+             * @param size length of the byte array.
+             */
+            void setView (char* buffer, const u_int32 & size) {
+                setBuffer (buffer, size);
+                Owned = false;
+            }
+
+            /**
+             * Called when data is added that does not fit into the buffer,
+             * or if the buffer is not owned by this object. The default
+             * implementation grows the buffer until the data fits.
+             * @param need number of bytes about to be added.
+             */
+            virtual void overflow (const u_int32 & need);
+
+            /**
+             * Return the size of the record written so far. This may
+             * differ from size() if parts of it have been passed on.
+             * @return offset of the next byte added to the record.
+             */
+            virtual u_int32 position () const { return Size; }
+
+            /**
+             * Replace a 32 bit value written earlier.
+             * @param pos offset of the value in the record.
+             * @param value the new value.
+             */
+            virtual void patch (const u_int32 & pos, const u_int32 & value);
+#endif // SWIG
+
         private:
-            /// Pointer to unflattened data. Valid after first call to parse().
+            /// allow views to access nested records
+            friend class flat_view;
+            /// allow streams to write out the buffer
+            friend class flat_stream;
+            /// allow records to refer to mapped files
+            friend class disk_writer_mmap;
+
+            /// Unflattened data in order of appearance. Valid after first call to parse().
             data *Data;
             
-            /// Points to record last fetched with get_*() or next()
-            data *Decoded;
+            /// Number of fields in Data
+            u_int32 Count;
+            
+            /// Index of the field following the one last fetched with get_*() or next()
+            u_int32 Decoded;
+            
+            /// Open addressing hash table of field names. Built on first lookup by name.
+            u_int32 *Index;
+            
+            /// Number of slots in Index minus one
+            u_int32 IndexMask;
             
             /**
              * Writes data into the buffer, growing it if neccessary.
@@ -654,8 +722,28 @@ namespace base
              */
             void parse ();
             
+            /**
+             * Discard unflattened data and the field name index.
+             */
+            void unparse ();
+            
+            /**
+             * Find the next field with the given name, starting at the current
+             * position and wrapping around at the end of the record.
+             * @param name Identifier of data to find.
+             * @return index of the field in Data, or Count if not found.
+             */
+            u_int32 find (const char *name);
+            
+            /**
+             * Create the hash table of field names.
+             */
+            void index ();
+            
             /**
              * Grow the internal buffer. This will double its current capacity.
+             * If the buffer is not owned by this object, a private copy is
+             * created.
              */
             void grow ();
             
@@ -673,9 +761,44 @@ namespace base
             
             /// Indicates an error during get
             bool Success;
+
+            /// Whether Buffer belongs to this object
+            bool Owned;
             
             /// names for datatypes
             static const char* TypeName[NBR_TYPES];
+
+            /// buffer of an empty record
+            static char EmptyRecord[1];
     };
+
+#ifndef SWIG
+    /**
+     * A %flat that refers to a record nested inside another %flat, instead
+     * of holding a copy of it. This allows reading nested records without
+     * copying their contents once per nesting level. A view must not be
+     * used after the %flat it refers to has been destroyed or modified.
+     * Writing to a view will create a private copy of its contents first.
+     */
+    class flat_view : public flat
+    {
+        public:
+            /**
+             * Refer to the nested record with given id. Call success() of
+             * the parent to check whether retrieval was successful.
+             * @param parent the %flat containing the record.
+             * @param name id of the nested record.
+             * @param optional whether to gracefully ignore missing data.
+             */
+            flat_view (flat & parent, const string & name, bool optional = false);
+
+            /**
+             * Refer to a nested record returned by flat::next().
+             * @param value pointer to the nested record.
+             * @param size length of the nested record.
+             */
+            flat_view (void *value, const u_int32 & size);
+    };
+#endif // SWIG
 }
 #endif // BASE_FLAT
@@ -0,0 +1,192 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file   base/flat_stream.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Write a record to a gz compressed file while it is being filled.
+ *
+ *
+ */
+
+#include <cstdio>
+#include <zlib.h>
+
+#include "flat_stream.h"
+#include "diskwriter_gz.h"
+#include "logging.h"
+
+using base::flat_stream;
+
+/// adjust adler32 checksum for zero bytes of a record replaced by value
+static u_int32 replace_zero (const u_int32 & checksum, const u_int32 & length, const u_int32 & pos, const u_int32 & value)
+{
+    // largest prime smaller than 65536, as used by adler32
+    const u_int32 BASE = 65521;
+    u_int32 a = checksum & 0xffff;
+    u_int32 b = checksum >> 16;
+    
+    // each byte adds to the first sum once, and to the second sum 
+    // once for every byte from its position to the end of the record
+    const u_int8 *bytes = (const u_int8 *) &value;
+    for (u_int32 i = 0; i < 4; i++)
+    {
+        a = (a + bytes[i]) % BASE;
+        b = (b + ((length - pos - i) % BASE) * bytes[i]) % BASE;
+    }
+    
+    return (b << 16) | a;
+}
+
+// ctor
+flat_stream::flat_stream (const u_int32 & chunk) : flat (0), Chunk (chunk), Written (0)
+{
+    Checksum = adler32 (0, NULL, 0);
+}
+
+// dtor
+flat_stream::~flat_stream ()
+{
+    if (File.is_open ())
+    {
+        File.close ();
+        remove ((Filename + ".tmp").c_str ());
+    }
+}
+
+// start writing record
+bool flat_stream::open (const std::string & filename)
+{
+    // make sure there never is a partially written file
+    if (!File.open (filename + ".tmp"))
+    {
+        LOG(ERROR) << "flat_stream::open: cannot open '" << filename << ".tmp' for writing!";
+        return false;
+    }
+
+    Filename = filename;
+    clear ();
+    Written = 0;
+    Checksum = adler32 (0, NULL, 0);
+    Patches.clear ();
+
+    // write byte order
+    byte_order () >> File;
+
+    // the length is not known in advance
+    disk_writer_gz::STREAMED >> File;
+
+    return true;
+}
+
+// finish writing record
+bool flat_stream::close ()
+{
+    if (!File.is_open ())
+    {
+        LOG(ERROR) << "flat_stream::close: no file open!";
+        return false;
+    }
+
+    // write what's left, but at least the byte order
+    if (Size > 1 || Written == 0) flush ();
+
+    // terminate record
+    const u_int32 end = 0;
+    end >> File;
+
+    // write values that changed after being written, i.e. the
+    // size of nested records that did not fit into one chunk
+    const u_int32 count = Patches.size () / 2;
+    count >> File;
+    for (std::vector<u_int32>::const_iterator i = Patches.begin (); i != Patches.end (); i += 2)
+    {
+        i[0] >> File;
+        File.put_block ((void*) &i[1], 4);
+        Checksum = replace_zero (Checksum, Written, i[0], i[1]);
+    }
+    Patches.clear ();
+
+    // write checksum
+    Checksum >> File;
+
+    // clear () resets the success flag, so check the file first
+    bool result = File.good ();
+    result &= File.close ();
+    clear ();
+
+    std::string tmp = Filename + ".tmp";
+    if (result && rename (tmp.c_str (), Filename.c_str ()) == 0)
+    {
+        return true;
+    }
+
+    LOG(ERROR) << "flat_stream::close: error writing '" << Filename << "'!";
+    remove (tmp.c_str ());
+    return false;
+}
+
+// write out data before growing the buffer
+void flat_stream::overflow (const u_int32 & need)
+{
+    if (File.is_open () && Size > 1) flush ();
+
+    // either start with a fresh buffer or make room for a large value
+    while (!Owned || Capacity < Chunk || Size + need > Capacity) grow ();
+}
+
+// write buffer contents to file
+void flat_stream::flush ()
+{
+    // the byte order is only written once
+    const u_int32 start = Written == 0 ? 0 : 1;
+    const u_int32 length = Size - start;
+
+    length >> File;
+    File.put_block (Buffer + start, length);
+    Checksum = adler32 (Checksum, (Bytef*) Buffer + start, length);
+    Written += length;
+
+    // reuse buffer
+    Size = 1;
+    Ptr = Buffer + 1;
+}
+
+// size of record including data written to file
+u_int32 flat_stream::position () const
+{
+    // the byte order is only written once
+    return Written + Size - (Written == 0 ? 0 : 1);
+}
+
+// replace value written earlier
+void flat_stream::patch (const u_int32 & pos, const u_int32 & value)
+{
+    if (pos >= Written)
+    {
+        // still in the buffer
+        flat::patch (pos - Written + (Written == 0 ? 0 : 1), value);
+    }
+    else
+    {
+        Patches.push_back (pos);
+        Patches.push_back (value);
+    }
+}
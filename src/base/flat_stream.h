@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file   base/flat_stream.h
+ * @author agent <agent@local>
+ *
+ * @brief  Write a record to a gz compressed file while it is being filled.
+ *
+ *
+ */
+
+#ifndef BASE_FLAT_STREAM_H
+#define BASE_FLAT_STREAM_H
+
+#include <vector>
+
+#include "flat.h"
+#include "file.h"
+
+namespace base
+{
+    /**
+     * A %flat that writes its contents to a gz compressed file while data
+     * is being added, instead of keeping the whole record in memory. Once
+     * the internal buffer is full, its contents are compressed and added
+     * to the checksum, and the buffer is reused. Memory use is thus
+     * bounded by the chunk size or the largest single value added,
+     * whatever is bigger.
+     *
+     * Nested records started with begin_flat() are streamed as well.
+     * Should a nested record span more than one chunk, its size is
+     * appended to the file once known, so that memory use remains
+     * independent of the size of nested records.
+     *
+     * Files written this way can be loaded by base::disk_writer_gz and
+     * thus base::diskio. As the contents are gone once written, data
+     * cannot be retrieved from the stream itself.
+     *
+     * Like base::diskio, the record goes to a temporary file first,
+     * which only replaces the target file once it is complete.
+     */
+    class flat_stream : public flat
+    {
+        public:
+            /**
+             * Create a stream that is not yet connected to a file.
+             * @param chunk number of bytes to collect before writing them.
+             */
+            flat_stream (const u_int32 & chunk = 65536);
+
+            /**
+             * Destructor. A record that has not been closed is discarded,
+             * leaving the target file untouched.
+             */
+            ~flat_stream ();
+
+            /**
+             * Start writing a record to the given file.
+             * @param filename file to save record to.
+             * @return \b true on success, \b false otherwise.
+             */
+            bool open (const std::string & filename);
+
+            /**
+             * Write out remaining data and the checksum of the record,
+             * then move it to the file given to open().
+             * @return \b true on success, \b false otherwise.
+             */
+            bool close ();
+
+            /**
+             * Return checksum of all data written so far.
+             * @return adler32 checksum of the record.
+             */
+            u_int32 checksum () const { return Checksum; }
+
+        protected:
+            /**
+             * Write out the buffer before growing it.
+             * @param need number of bytes about to be added.
+             */
+            void overflow (const u_int32 & need);
+
+            /**
+             * Return the size of the record written so far, including
+             * data already written to file.
+             * @return offset of the next byte added to the record.
+             */
+            u_int32 position () const;
+
+            /**
+             * Replace a 32 bit value written earlier. If it has already
+             * been written to file, the new value is appended to the
+             * file when closing it.
+             * @param pos offset of the value in the record.
+             * @param value the new value.
+             */
+            void patch (const u_int32 & pos, const u_int32 & value);
+
+        private:
+            /// forbid copying
+            flat_stream (const flat_stream & s);
+
+            /**
+             * Write contents of the buffer to file and empty it.
+             */
+            void flush ();
+
+            /// the file being written
+            ogzstream File;
+            /// name of the file to write
+            std::string Filename;
+            /// preferred size of the buffer
+            u_int32 Chunk;
+            /// number of bytes written so far
+            u_int32 Written;
+            /// checksum of the bytes written so far
+            u_int32 Checksum;
+            /// offset and value of values replaced after being written
+            std::vector<u_int32> Patches;
+    };
+}
+
+#endif
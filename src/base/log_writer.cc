@@ -0,0 +1,312 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/log_writer.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Writes log messages from a background thread.
+ *
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "log_writer.h"
+#include "mpsc_queue.h"
+
+using logging::log_writer;
+
+namespace
+{
+    /// a message waiting to be written
+    struct entry
+    {
+        /// repeats of the previous message not queued
+        u_int32 Repeats;
+        /// number of characters in Text
+        u_int16 Length;
+        /// the message, not 0-terminated
+        char Text[log_writer::MAX_LENGTH];
+    };
+
+    typedef std::chrono::steady_clock log_clock;
+
+    /// messages waiting to be written
+    base::mpsc_queue<entry> *Queue = NULL;
+    /// the background thread
+    std::thread *Thread = NULL;
+    /// serializes start () and stop ()
+    std::mutex Control;
+    /// whether messages should be queued
+    std::atomic<bool> Running (false);
+    /// threads currently inside write ()
+    std::atomic<u_int32> Writers (0);
+    /// messages dropped since last reported
+    std::atomic<u_int32> Dropped (0);
+    /// messages dropped since start
+    std::atomic<u_int32> DroppedTotal (0);
+    /// guards LastQueued and PendingRepeats
+    std::mutex Queued;
+    /// the message queued last
+    std::string LastQueued;
+    /// repeats of the message queued last
+    u_int32 PendingRepeats = 0;
+    /// where messages are written to
+    FILE *Out = stderr;
+
+    /// the last message written, for detecting repeats
+    std::string Last;
+    /// number of repeats of Last not yet reported
+    u_int32 Repeats = 0;
+    /// when repeats of Last were last reported
+    log_clock::time_point RepeatsSince;
+    /// output not yet written to Out
+    std::string Batch;
+
+    /// add pending repeats and dropped messages to output
+    void report ()
+    {
+        char buf[64];
+        if (Repeats > 0)
+        {
+            snprintf (buf, sizeof (buf), "*** last message repeated %u times\n", Repeats);
+            Batch += buf;
+            Repeats = 0;
+        }
+
+        u_int32 dropped = Dropped.exchange (0);
+        if (dropped > 0)
+        {
+            snprintf (buf, sizeof (buf), "*** %u log messages dropped\n", dropped);
+            Batch += buf;
+        }
+
+        RepeatsSince = log_clock::now ();
+    }
+
+    /// add a message to output, unless it repeats the previous one
+    void handle (const entry & e)
+    {
+        Repeats += e.Repeats;
+        if (e.Length == Last.length () && memcmp (e.Text, Last.data (), e.Length) == 0)
+        {
+            Repeats++;
+            if (log_clock::now () - RepeatsSince >= std::chrono::seconds (1))
+            {
+                report ();
+            }
+            return;
+        }
+
+        report ();
+        Last.assign (e.Text, e.Length);
+        Batch.append (e.Text, e.Length);
+        Batch += '\n';
+    }
+
+    /// write pending output
+    void flush ()
+    {
+        if (!Batch.empty ())
+        {
+            fwrite (Batch.data (), 1, Batch.length (), Out);
+            fflush (Out);
+            Batch.clear ();
+        }
+    }
+
+    /// add repeats not queued yet to those of the message written last
+    void take_repeats ()
+    {
+        std::lock_guard<std::mutex> lock (Queued);
+        Repeats += PendingRepeats;
+        PendingRepeats = 0;
+    }
+
+    /// write everything that is still queued
+    void drain ()
+    {
+        entry e;
+        while (Queue->pop (e))
+        {
+            handle (e);
+        }
+
+        take_repeats ();
+        report ();
+        flush ();
+    }
+}
+
+// start background thread
+bool log_writer::start (FILE *out, const u_int32 & capacity)
+{
+#if HAVE_GLOG_H
+    return false;
+#else
+    std::lock_guard<std::mutex> lock (Control);
+    if (Running) return true;
+
+    static bool registered = false;
+    if (!registered)
+    {
+        atexit (log_writer::stop);
+        registered = true;
+    }
+
+    delete Queue;
+    Queue = new base::mpsc_queue<entry> (capacity);
+
+    Out = out;
+    Last.clear ();
+    Repeats = 0;
+    LastQueued.clear ();
+    PendingRepeats = 0;
+    Dropped = 0;
+    DroppedTotal = 0;
+    RepeatsSince = log_clock::now ();
+
+    Running = true;
+    Thread = new std::thread (log_writer::run);
+    return true;
+#endif
+}
+
+// stop background thread
+void log_writer::stop ()
+{
+    std::lock_guard<std::mutex> lock (Control);
+    if (!Running.exchange (false)) return;
+
+    // wait for messages still being queued
+    while (Writers > 0) std::this_thread::yield ();
+
+    Thread->join ();
+    delete Thread;
+    Thread = NULL;
+
+    // pick up anything queued while stopping
+    drain ();
+}
+
+// check if running
+bool log_writer::is_running ()
+{
+    return Running;
+}
+
+// queue a message
+bool log_writer::write (const std::string & msg)
+{
+    // keep stop () from draining the queue before we are done
+    Writers++;
+    if (!Running)
+    {
+        Writers--;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (Queued);
+
+        // only count repeats, so they cannot crowd out other messages
+        if (msg == LastQueued)
+        {
+            PendingRepeats++;
+            Writers--;
+            return true;
+        }
+
+        entry e;
+        e.Repeats = PendingRepeats;
+        e.Length = msg.length () < MAX_LENGTH ? msg.length () : MAX_LENGTH;
+        memcpy (e.Text, msg.data (), e.Length);
+
+        if (Queue->push (e))
+        {
+            LastQueued = msg;
+            PendingRepeats = 0;
+        }
+        else
+        {
+            // repeats still belong to the message queued last
+            Dropped++;
+            DroppedTotal++;
+        }
+    }
+
+    Writers--;
+    return true;
+}
+
+// number of dropped messages
+u_int32 log_writer::dropped ()
+{
+    return DroppedTotal;
+}
+
+// write messages until stopped
+void log_writer::run ()
+{
+    entry e;
+    while (true)
+    {
+        // check before popping, so nothing queued before stop() is missed
+        bool running = Running;
+
+        u_int32 count = 0;
+        while (count < 64 && Queue->pop (e))
+        {
+            handle (e);
+            count++;
+        }
+
+        if (Batch.length () >= 4096)
+        {
+            flush ();
+        }
+
+        if (count == 0)
+        {
+            if (!running) break;
+
+            // report ongoing repeats even if nothing else is logged
+            if (log_clock::now () - RepeatsSince >= std::chrono::seconds (1))
+            {
+                take_repeats ();
+                if (Repeats > 0) report ();
+            }
+
+            flush ();
+            std::this_thread::sleep_for (std::chrono::milliseconds (10));
+        }
+    }
+
+    flush ();
+}
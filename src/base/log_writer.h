@@ -0,0 +1,109 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/log_writer.h
+ * @author agent <agent@local>
+ *
+ * @brief  Writes log messages from a background thread.
+ *
+ *
+ */
+
+#ifndef BASE_LOG_WRITER_H
+#define BASE_LOG_WRITER_H
+
+#include <cstdio>
+#include <string>
+
+#include "types.h"
+
+namespace logging
+{
+    /**
+     * Moves writing of log messages off the threads producing them.
+     * Messages are copied into a fixed number of slots of a lock-free
+     * queue, which a background thread empties in batches. Logging
+     * thus never waits for the terminal, nor for other threads.
+     *
+     * Memory use is bounded: messages are truncated to MAX_LENGTH
+     * characters, and if the queue is full, messages are dropped and
+     * only their number is reported.
+     *
+     * Messages identical to the one before are not written again. The
+     * number of repeats is written instead, once the message changes,
+     * and at least once per second while the repeats continue.
+     *
+     * Without glog, LOG statements use the writer while it is running
+     * and write directly to stderr otherwise. glog does its own
+     * buffering, so there the writer is never started.
+     */
+    class log_writer
+    {
+    public:
+        /// maximum length of a single message
+        static const u_int32 MAX_LENGTH = 480;
+
+        /**
+         * Start the background thread. Does nothing if already running.
+         * @param out the stream to write messages to.
+         * @param capacity maximum number of messages waiting to be
+         *      written.
+         * @return \b true if messages are written in the background.
+         */
+        static bool start (FILE *out = stderr, const u_int32 & capacity = 512);
+
+        /**
+         * Write all pending messages and stop the background thread.
+         * Waits for messages other threads are queueing at the time.
+         * Called automatically at program exit.
+         */
+        static void stop ();
+
+        /**
+         * Return whether the background thread is running.
+         * @return \b true if messages are written in the background.
+         */
+        static bool is_running ();
+
+        /**
+         * Queue a message for writing. Safe to call from any thread.
+         * @param msg the message, without trailing line break.
+         * @return \b false if the writer is not running, in which case
+         *      the caller should write the message itself. Messages
+         *      dropped because the queue is full count as written.
+         */
+        static bool write (const std::string & msg);
+
+        /**
+         * Return the number of messages dropped since start().
+         * @return number of dropped messages.
+         */
+        static u_int32 dropped ();
+
+    private:
+        /// forbid instantiation
+        log_writer ();
+
+        /// main loop of the background thread
+        static void run ();
+    };
+}
+
+#endif // BASE_LOG_WRITER_H
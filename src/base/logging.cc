@@ -26,30 +26,48 @@
  */
 
 #include "logging.h"
+#include "log_writer.h"
 
 #include <string>
-#include <cstring>
 
 namespace base
 {
     void stderr_to_log::write (const char *msg)
     {
-        if (strchr(msg, '\n') == NULL)
-        {
-            Buffer << msg;
-        }
-        else
+        Buffer += msg;
+
+        // log each complete line separately
+        std::string::size_type start = 0, end;
+        while ((end = Buffer.find ('\n', start)) != std::string::npos)
         {
-            const std::string& buf = Buffer.str();
-            LOG(ERROR) << buf << msg;
-            Buffer.str("");
+            LOG(ERROR) << Buffer.substr (start, end - start);
+            start = end + 1;
         }
+        Buffer.erase (0, start);
     }
 }
 
 namespace google
 {
     int log_level = 3;
+
+#if !HAVE_GLOG_H
+    LogMessage::~LogMessage()
+    {
+        if (LogLevel >= FATAL)
+        {
+            // make sure everything logged so far ends up on screen
+            logging::log_writer::stop ();
+            std::cerr << Stream.str () << std::endl;
+            exit (1);
+        }
+
+        if (!logging::log_writer::write (Stream.str ()))
+        {
+            std::cerr << Stream.str () << std::endl;
+        }
+    }
+#endif
 }
 
 /**
@@ -57,7 +57,7 @@ namespace base
         void write (const char *msg);
     private:
         /// buffer log output until we get a linebreak
-        std::ostringstream Buffer;
+        std::string Buffer;
     };
 }
 
@@ -105,33 +105,44 @@ namespace google
 
     }
 
+    /**
+     * Collects a single log message and passes it on to the
+     * log_writer once complete.
+     */
+    class LogMessage {
+    public:
+        LogMessage(const int & logLevel) : LogLevel(logLevel) { }
+
+        /// write message, exit if it was fatal
+        ~LogMessage();
+
+        std::ostream & stream() { return Stream; }
+
+    private:
+        int LogLevel;
+        std::ostringstream Stream;
+    };
+
     class LogMessageVoidify {
     public:
-        LogMessageVoidify(const int & logLevel) 
-        {
-            LogLevel = logLevel;
-        }
-        
-        ~LogMessageVoidify()
-        {
-            if (LogLevel >= FATAL)
-            {
-                exit(1);
-            }
-        }
-        
         // This has to be an operator with a precedence lower than << but
         // higher than ?:
-        void operator&(std::ostream& x ) { x << std::endl; }
-        
-    private:
-        int LogLevel;
+        void operator&(std::ostream& x ) { }
     };
 }
 
 #define VLOG(x) LOG(-x)
-#define LOG(x) x < google::log_level ? (void) 0 : google::LogMessageVoidify(x) & std::cerr
+#define VLOG_IS_ON(x) (-(x) >= google::log_level)
+#define LOG(x) x < google::log_level ? (void) 0 : google::LogMessageVoidify() & google::LogMessage(x).stream()
+
+#endif
 
+// compile out verbose logging entirely, including its arguments
+#ifdef STRIP_VLOG
+#undef VLOG
+#undef VLOG_IS_ON
+#define VLOG_IS_ON(x) false
+#define VLOG(x) true ? (void) 0 : logging::voidify() & std::cerr
 #endif
 
 #include "types.h"
@@ -159,6 +170,91 @@ namespace logging
      */
     const u_int8 increment_log_indent_level();
 
+    /**
+     * Indent log messages for the lifetime of this object, but only
+     * if verbose logging at the given level is enabled. Unlike calling
+     * increment_log_indent_level() and decrement_log_indent_level(),
+     * this costs nothing when verbose logging has been compiled out.
+     */
+    class vlog_indent
+    {
+    public:
+#ifdef STRIP_VLOG
+        vlog_indent (const int & level) { }
+#else
+        /**
+         * Increment log indentation if verbose logging is on.
+         * @param level the verbose logging level.
+         */
+        vlog_indent (const int & level) : Active (VLOG_IS_ON(level))
+        {
+            if (Active) increment_log_indent_level ();
+        }
+
+        /**
+         * Restore log indentation.
+         */
+        ~vlog_indent ()
+        {
+            if (Active) decrement_log_indent_level ();
+        }
+
+    private:
+        /// whether indentation has been incremented
+        bool Active;
+#endif
+    };
+
+    /**
+     * A named value written to the log as " name=value". Use with
+     * field() to log values in a format that is easy to parse:
+     *
+     * VLOG(1) << "update_velocity" << logging::field ("vx", vx);
+     *
+     * Like all arguments of VLOG, the value is only evaluated if
+     * verbose logging at that level is enabled.
+     */
+    template <class T>
+    struct log_field
+    {
+        /// name of the value
+        const char *Name;
+        /// the value
+        const T & Value;
+    };
+
+    /**
+     * Create a named value for logging.
+     * @param name name of the value.
+     * @param value the value.
+     * @return named value that can be written to the log.
+     */
+    template <class T>
+    inline log_field<T> field (const char *name, const T & value)
+    {
+        log_field<T> result = { name, value };
+        return result;
+    }
+
+    /**
+     * Write named value to the log.
+     */
+    template <class T>
+    inline std::ostream & operator<< (std::ostream & out, const log_field<T> & f)
+    {
+        return out << ' ' << f.Name << '=' << f.Value;
+    }
+
+    /**
+     * Swallows the log stream of disabled log statements.
+     */
+    class voidify
+    {
+    public:
+        /// has a lower precedence than << but higher than ?:
+        void operator& (std::ostream & out) { }
+    };
+
 } // namespace{}
 
 #endif
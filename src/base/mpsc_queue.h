@@ -0,0 +1,175 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/mpsc_queue.h
+ * @author agent <agent@local>
+ *
+ * @brief  A bounded, lock-free queue with many producers and one consumer.
+ *
+ *
+ */
+
+#ifndef BASE_MPSC_QUEUE_H
+#define BASE_MPSC_QUEUE_H
+
+#include <atomic>
+
+#include "types.h"
+
+namespace base
+{
+    /**
+     * A fixed size ring buffer that any number of threads can push to
+     * while a single thread pops from it. Neither side ever blocks: if
+     * the queue is full, push() fails and the caller decides what to do
+     * with the item.
+     *
+     * Each slot carries a sequence number that tells whether it is free
+     * for the producer claiming that position, or filled and ready for
+     * the consumer. Producers claim positions with a compare-and-swap on
+     * the tail, so a slow producer only delays the consumer, never the
+     * other producers.
+     */
+    template <class T>
+    class mpsc_queue
+    {
+    public:
+        /**
+         * Create a queue.
+         * @param capacity number of slots, rounded up to a power of two.
+         */
+        mpsc_queue (const u_int32 & capacity)
+        {
+            Size = 2;
+            while (Size < capacity) Size <<= 1;
+
+            Slots = new slot[Size];
+            for (u_int32 i = 0; i < Size; i++)
+            {
+                Slots[i].Sequence.store (i, std::memory_order_relaxed);
+            }
+
+            Head = 0;
+            Tail.store (0, std::memory_order_relaxed);
+        }
+
+        /**
+         * Destroy the queue, dropping items not yet popped.
+         */
+        ~mpsc_queue ()
+        {
+            delete[] Slots;
+        }
+
+        /**
+         * Return the number of slots.
+         * @return maximum number of items in the queue.
+         */
+        u_int32 capacity () const
+        {
+            return Size;
+        }
+
+        /**
+         * Add an item to the queue. Safe to call from any thread.
+         * @param item the item to copy into the queue.
+         * @return \b false if the queue is full.
+         */
+        bool push (const T & item)
+        {
+            u_int32 pos = Tail.load (std::memory_order_relaxed);
+            slot *s;
+
+            while (true)
+            {
+                s = Slots + (pos & (Size - 1));
+                s_int32 diff = (s_int32) (s->Sequence.load (std::memory_order_acquire) - pos);
+
+                // slot is free for this position, try claiming it
+                if (diff == 0)
+                {
+                    if (Tail.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                // slot still holds an item from the previous round
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                // another producer was faster
+                else
+                {
+                    pos = Tail.load (std::memory_order_relaxed);
+                }
+            }
+
+            s->Item = item;
+            s->Sequence.store (pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Remove the oldest item from the queue. Must only be called
+         * from a single thread at a time.
+         * @param item receives the removed item.
+         * @return \b false if the queue is empty.
+         */
+        bool pop (T & item)
+        {
+            slot *s = Slots + (Head & (Size - 1));
+            if ((s_int32) (s->Sequence.load (std::memory_order_acquire) - (Head + 1)) < 0)
+            {
+                return false;
+            }
+
+            item = s->Item;
+            s->Sequence.store (Head + Size, std::memory_order_release);
+            Head++;
+            return true;
+        }
+
+    private:
+        /// forbid copying
+        mpsc_queue (const mpsc_queue & q);
+        /// forbid assignment
+        mpsc_queue & operator= (const mpsc_queue & q);
+
+        /// an item and its state
+        struct slot
+        {
+            /// position the slot is ready for
+            std::atomic<u_int32> Sequence;
+            /// the item
+            T Item;
+        };
+
+        /// the ring buffer
+        slot *Slots;
+        /// number of slots, a power of two
+        u_int32 Size;
+        /// position of the next item to pop, only used by the consumer
+        u_int32 Head;
+        /// keep producers and consumer on separate cache lines
+        char Padding[64];
+        /// position of the next item to push
+        std::atomic<u_int32> Tail;
+    };
+}
+
+#endif // BASE_MPSC_QUEUE_H
@@ -0,0 +1,252 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file   base/record_cache.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Keeps binary copies of records read from XML files.
+ *
+ *
+ */
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include "record_cache.h"
+#include "diskwriter_lz.h"
+#include "diskwriter_xml.h"
+#include "logging.h"
+
+using base::record_cache;
+
+// directory containing cached records
+std::string record_cache::Dir;
+
+// cache statistics
+std::atomic<u_int32> record_cache::Hits (0);
+std::atomic<u_int32> record_cache::Misses (0);
+
+// number of temporary files created so far
+std::atomic<u_int32> record_cache::TempCount (0);
+
+// enable cache
+bool record_cache::init (const std::string & dir)
+{
+    Dir = "";
+    if (dir.empty ()) return true;
+
+    struct stat statbuf;
+    if (stat (dir.c_str (), &statbuf) == -1)
+    {
+#ifdef WIN32
+        if (mkdir (dir.c_str ()))
+#else
+        if (mkdir (dir.c_str (), 0700))
+#endif
+        {
+            LOG(ERROR) << "*** record_cache::init: failed to create directory '" << dir << "'!";
+            return false;
+        }
+    }
+
+    Dir = dir;
+    if (Dir[Dir.length () - 1] != '/') Dir += '/';
+    return true;
+}
+
+// load cached record
+bool record_cache::get (const std::string & path, base::flat & record)
+{
+    struct stat cached;
+    std::string filename = cache_file (path);
+
+    std::vector<char> buffer;
+    if (stat (filename.c_str (), &cached) == -1 || !read_source (path, buffer))
+    {
+        Misses++;
+        return false;
+    }
+
+    base::flat entry;
+    base::disk_writer_lz writer;
+    if (writer.get_state (filename, entry) &&
+        entry.get_string ("source", true) == path &&
+        entry.get_uint32 ("size", true) == buffer.size () &&
+        entry.get_uint32 ("source_checksum", true) == checksum (buffer))
+    {
+        u_int32 checksum = entry.get_uint32 ("checksum", true);
+        base::flat_view data (entry, "record");
+        if (entry.success ())
+        {
+            record.copy (data);
+            if (record.checksum () == checksum)
+            {
+                Hits++;
+                return true;
+            }
+            record.clear ();
+        }
+    }
+
+    // outdated or damaged
+    VLOG(1) << "record_cache::get: discarding '" << filename << "' for '" << path << "'";
+    unlink (filename.c_str ());
+    Misses++;
+    return false;
+}
+
+// cache record
+bool record_cache::put (const std::string & path, const base::flat & record)
+{
+    std::vector<char> buffer;
+    if (Dir.empty () || !read_source (path, buffer))
+    {
+        return false;
+    }
+
+    return store (path, buffer, record);
+}
+
+// cache all records below given directory
+u_int32 record_cache::prebuild (const std::string & dir)
+{
+    u_int32 count = 0;
+    DIR *handle = opendir (dir.c_str ());
+    if (handle == NULL || Dir.empty ())
+    {
+        if (handle != NULL) closedir (handle);
+        return count;
+    }
+
+    struct dirent *dirent;
+    std::vector<char> buffer;
+
+    while ((dirent = readdir (handle)) != NULL)
+    {
+        if (dirent->d_name[0] == '.') continue;
+
+        std::string path = dir + dirent->d_name;
+        struct stat statbuf;
+        if (stat (path.c_str (), &statbuf) == -1) continue;
+
+        if (S_ISDIR (statbuf.st_mode))
+        {
+            count += prebuild (path + "/");
+            continue;
+        }
+
+        if (path.length () < 4 || path.compare (path.length () - 4, 4, ".xml") != 0)
+        {
+            continue;
+        }
+
+        if (!read_source (path, buffer) || buffer.empty ())
+        {
+            continue;
+        }
+
+        // anything that is not a record is skipped quietly
+        base::flat record;
+        if (base::disk_writer_xml::parse (&buffer[0], buffer.size (), record) && store (path, buffer, record))
+        {
+            count++;
+        }
+    }
+
+    closedir (handle);
+    return count;
+}
+
+// write record to cache
+bool record_cache::store (const std::string & path, const std::vector<char> & source, const base::flat & record)
+{
+    base::flat entry;
+    entry.put_string ("source", path);
+    entry.put_uint32 ("size", (u_int32) source.size ());
+    entry.put_uint32 ("source_checksum", checksum (source));
+    entry.put_uint32 ("checksum", record.checksum ());
+    entry.put_flat ("record", record);
+
+    // concurrent loaders, in this or another process, must never see a partial file
+    std::ostringstream tmp;
+    tmp << cache_file (path) << "." << getpid () << "." << TempCount++;
+
+    base::disk_writer_lz writer;
+    if (!writer.put_state (tmp.str (), entry) || rename (tmp.str ().c_str (), cache_file (path).c_str ()) != 0)
+    {
+        LOG(WARNING) << "*** record_cache::put: failed caching '" << path << "'";
+        unlink (tmp.str ().c_str ());
+        return false;
+    }
+
+    return true;
+}
+
+// read contents of xml file
+bool record_cache::read_source (const std::string & path, std::vector<char> & buffer)
+{
+    FILE *file = fopen (path.c_str (), "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    buffer.clear ();
+
+    char chunk[16384];
+    size_t count;
+    while ((count = fread (chunk, 1, sizeof (chunk), file)) > 0)
+    {
+        buffer.insert (buffer.end (), chunk, chunk + count);
+    }
+
+    bool result = !ferror (file);
+    fclose (file);
+    return result;
+}
+
+// checksum of xml file
+u_int32 record_cache::checksum (const std::vector<char> & source)
+{
+    u_int32 a32 = adler32 (0, NULL, 0);
+    if (source.empty ()) return a32;
+    return adler32 (a32, (const Bytef*) &source[0], source.size ());
+}
+
+// name of cached record
+std::string record_cache::cache_file (const std::string & path)
+{
+    // FNV-1a hash of the path; collisions are detected by
+    // comparing the path stored with the cached record
+    u_int32 hash = 2166136261u;
+    for (std::string::const_iterator i = path.begin (); i != path.end (); i++)
+    {
+        hash = (hash ^ (u_int8) *i) * 16777619u;
+    }
+
+    std::ostringstream name;
+    name << Dir << std::hex << hash << ".alz";
+    return name.str ();
+}
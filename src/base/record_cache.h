@@ -0,0 +1,155 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file   base/record_cache.h
+ * @author agent <agent@local>
+ *
+ * @brief  Keeps binary copies of records read from XML files.
+ */
+
+#ifndef BASE_RECORD_CACHE_H
+#define BASE_RECORD_CACHE_H
+
+#include <atomic>
+#include <vector>
+#include "flat.h"
+
+namespace base
+{
+    /**
+     * Models, sprites and other data are authored as XML files, which take
+     * much longer to read than the binary formats. Once the cache is enabled,
+     * every record read from an XML file by diskio::get_record is also stored
+     * in lz compressed form in the cache directory, and loaded from there the
+     * next time. A cached record is only used while the XML file keeps its
+     * path, size and checksum and the record matches its checksum. Reading
+     * the XML file to compute its checksum is still much cheaper than
+     * parsing it.
+     *
+     * All methods are static and may be called from any thread once init()
+     * has been called.
+     */
+    class record_cache
+    {
+    public:
+        /**
+         * Enable the cache, creating the cache directory if necessary.
+         * @param dir directory to keep cached records in. An empty
+         *      string disables the cache.
+         * @return \b true on success, \b false otherwise.
+         */
+        static bool init (const std::string & dir);
+
+        /**
+         * Check whether records are cached at all.
+         * @return \b true if the cache has been enabled.
+         */
+        static bool enabled ()
+        {
+            return !Dir.empty ();
+        }
+
+        /**
+         * Load the cached version of an XML file.
+         * @param path full path of the XML file.
+         * @param record empty record to fill.
+         * @return \b true if an up to date version was found, \b false otherwise.
+         */
+        static bool get (const std::string & path, base::flat & record);
+
+        /**
+         * Store the record read from an XML file.
+         * @param path full path of the XML file.
+         * @param record the record read from that file.
+         * @return \b true on success, \b false otherwise.
+         */
+        static bool put (const std::string & path, const base::flat & record);
+
+        /**
+         * Store all XML records found in the given directory and its
+         * subdirectories in the cache. Files that do not contain a
+         * record, like configuration files, are skipped.
+         * @param dir directory to search, ending in a path separator.
+         * @return number of records added to the cache.
+         */
+        static u_int32 prebuild (const std::string & dir);
+
+        /**
+         * Return number of records loaded from the cache.
+         * @return number of cache hits.
+         */
+        static u_int32 hits ()
+        {
+            return Hits;
+        }
+
+        /**
+         * Return number of XML files not found in the cache.
+         * @return number of cache misses.
+         */
+        static u_int32 misses ()
+        {
+            return Misses;
+        }
+
+    private:
+        /**
+         * Get name of the file caching the given XML file.
+         * @param path full path of the XML file.
+         * @return path of cached record.
+         */
+        static std::string cache_file (const std::string & path);
+
+        /**
+         * Write record to the cache, replacing any previous version.
+         * @param path full path of the XML file.
+         * @param source contents of the XML file.
+         * @param record the record read from that file.
+         * @return \b true on success, \b false otherwise.
+         */
+        static bool store (const std::string & path, const std::vector<char> & source, const base::flat & record);
+
+        /**
+         * Read the contents of an XML file.
+         * @param path full path of the XML file.
+         * @param buffer receives the file contents.
+         * @return \b true on success, \b false otherwise.
+         */
+        static bool read_source (const std::string & path, std::vector<char> & buffer);
+
+        /**
+         * Compute checksum of an XML file.
+         * @param source contents of the XML file.
+         * @return adler32 checksum of the contents.
+         */
+        static u_int32 checksum (const std::vector<char> & source);
+
+        /// directory containing cached records
+        static std::string Dir;
+        /// number of records loaded from the cache
+        static std::atomic<u_int32> Hits;
+        /// number of XML files that had to be parsed
+        static std::atomic<u_int32> Misses;
+        /// number of temporary files created, to keep their names unique
+        static std::atomic<u_int32> TempCount;
+    };
+}
+
+#endif // BASE_RECORD_CACHE_H
@@ -27,6 +27,7 @@
  */
 
 #include <algorithm>
+#include <cstdio>
 #include <unistd.h>
 #include <dirent.h>
 #include <sys/stat.h>
@@ -53,9 +54,48 @@ static int get_file_type (const std::string & path, const std::string & name)
 }
 #endif
 
+/// directory a saved game is written to before replacing the given one
+static std::string temp_dir (const std::string & dir, const char *suffix = ".new")
+{
+    // hide it from the list of saved games
+    std::string::size_type pos = dir.rfind ('/') + 1;
+    return dir.substr (0, pos) + "." + dir.substr (pos) + suffix;
+}
+
+/// delete regular files in given directory, return false if it does not exist
+static bool delete_files (const std::string & name)
+{
+    struct dirent *dirent;
+    DIR *dir;
+
+    if ((dir = opendir (name.c_str ())) == NULL)
+    {
+        return false;
+    }
+
+    while ((dirent = readdir (dir)) != NULL)
+    {
+#ifdef WIN32
+        if (S_ISREG (get_file_type (name, dirent->d_name)))
+#else
+        if (dirent->d_type == DT_REG)
+#endif
+        {
+            std::string file = name + "/" + dirent->d_name;
+            unlink (file.c_str());
+        }
+    }
+
+    closedir (dir);
+    return true;
+}
+
 /// current slot
 s_int32 savegame::CurrentSlot = savegame::INITIAL_SAVE;
 
+/// instance saving in background
+savegame *savegame::Active = NULL;
+
 // ctor
 savegame_data::savegame_data (const std::string & dir, const std::string & desc, const u_int32 & time)
 {
@@ -74,6 +114,7 @@ void savegame_data::update (const std::string & desc, const u_int32 & time)
 
 // ctor
 savegame::savegame (base::functor_1<const s_int32> *callback)
+    : Writer (NULL), Written (0), Success (false), Slot (0), Data (NULL)
 {
     ProgressCallback = callback;
 }
@@ -81,15 +122,28 @@ savegame::savegame (base::functor_1<const s_int32> *callback)
 // dtor
 savegame::~savegame ()
 {
+    wait ();
     delete ProgressCallback;
 }
 
+// report progress
+void savegame::progress (const s_int32 & percent)
+{
+    if (ProgressCallback != NULL)
+    {
+        (*ProgressCallback)(percent);
+    }
+}
+
 // load a saved game
 bool savegame::load (const s_int32 & slot)
 {
     savegame_data *data = get (slot);
     if (data == NULL) return false;
     
+    // finish writing game first
+    if (Active != NULL) Active->wait ();
+    
     u_int32 current = 1;
     u_int32 count = Serializer().size();
     
@@ -107,10 +161,7 @@ bool savegame::load (const s_int32 & slot)
             return false;
         }
 
-        if (ProgressCallback != NULL)
-        {
-            (*ProgressCallback)((s_int32)((current * 100.0) / count));
-        }
+        progress ((s_int32)((current * 100.0) / count));
 
         current++;
     }
@@ -121,10 +172,13 @@ bool savegame::load (const s_int32 & slot)
 }
 
 // save the game
-bool savegame::save (const s_int32 & slot, const std::string & desc, const u_int32 & gametime)
+bool savegame::save (const s_int32 & slot, const std::string & desc, const u_int32 & gametime, const bool & background)
 {
     if (slot == INITIAL_SAVE) return false;
 
+    // only one game can be written at a time
+    if (Active != NULL) Active->wait ();
+
     savegame_data *data = get (slot);
     if (data == NULL)
     {
@@ -169,32 +223,130 @@ bool savegame::save (const s_int32 & slot, const std::string & desc, const u_int
         data->update (desc, gametime);
     }
 
-    // prepare the directory before saving
-    cleanup (data->directory());
+    // prepare the directory before saving, leaving the
+    // existing saved game intact until the new one is complete
+    const std::string path = temp_dir (data->directory());
+    cleanup (path);
+
+    // capture records in memory instead of writing them
+    if (background) base::diskio::set_deferred (&Records);
 
     // save game data
     u_int32 current = 1;
     u_int32 size = Serializer().size();
+    
+    // in background mode, writing takes the second half of the progress
+    double scale = background ? 50.0 : 100.0;
+    
     std::list<base::serializer_base*>::iterator i;
     for (i = Serializer().begin(); i != Serializer().end(); i++)
     {
-        if (!(*i)->save (data->directory()))
+        if (!(*i)->save (path))
         {
-            cleanup (data->directory());
+            base::diskio::set_deferred (NULL);
+            for (std::list<base::diskio*>::iterator r = Records.begin(); r != Records.end(); r++)
+            {
+                delete *r;
+            }
+            Records.clear ();
+            
+            remove_dir (path);
             return false;
         }
         
-        if (ProgressCallback != NULL)
+        progress ((s_int32)((current * scale) / size));
+        current++;
+    }
+    
+    // finally save meta data, making the saved game valid
+    save_meta_data (data, path);
+
+    if (background)
+    {
+        base::diskio::set_deferred (NULL);
+        
+        // write records in the background
+        Slot = slot;
+        Data = data;
+        Written = 0;
+        Success = true;
+        Active = this;
+        Writer = new std::thread (&savegame::write, this);
+        
+        base::Timer.synch();
+        return true;
+    }
+    
+    if (!commit (data)) return false;
+    
+    finish (slot, data);
+    return true;
+}
+
+// write captured records
+void savegame::write ()
+{
+    for (std::list<base::diskio*>::iterator i = Records.begin(); i != Records.end(); i++)
+    {
+        // stop at the first error, as the saved game is unusable anyway
+        if (Success && !(*i)->write_record ())
         {
-            (*ProgressCallback)((s_int32)((current * 100.0) / size));
+            Success = false;
         }
         
-        current++;
+        // free memory as soon as possible
+        delete *i;
+        *i = NULL;
+        
+        Written++;
     }
+}
+
+// check for background save to complete
+bool savegame::in_progress ()
+{
+    if (Writer == NULL) return false;
     
-    // finally save meta data, making the saved game valid
-    save_meta_data (data);
+    u_int32 size = Records.size ();
+    if (Written < size)
+    {
+        progress ((s_int32)(50 + (Written * 50.0) / size));
+        return true;
+    }
+    
+    wait ();
+    return false;
+}
 
+// block until background save is complete
+bool savegame::wait ()
+{
+    if (Writer == NULL) return true;
+    
+    Writer->join ();
+    delete Writer;
+    Writer = NULL;
+    Records.clear ();
+    Active = NULL;
+    
+    if (!Success)
+    {
+        LOG(ERROR) << "*** savegame::wait: failed writing saved game to";
+        LOG(ERROR) << "    " << temp_dir (Data->directory());
+        remove_dir (temp_dir (Data->directory()));
+        return false;
+    }
+    
+    if (!commit (Data)) return false;
+    
+    progress (100);
+    finish (Slot, Data);
+    return true;
+}
+
+// update saved game list
+void savegame::finish (const s_int32 & slot, savegame_data *data)
+{
     // update timestamp ...
     data->set_last_modified (time (NULL));
     
@@ -203,7 +355,6 @@ bool savegame::save (const s_int32 & slot, const std::string & desc, const u_int
 
     base::Timer.synch();
     CurrentSlot = slot;
-    return true;
 }
 
 // read available games
@@ -269,27 +420,7 @@ void savegame::cleanup()
 // remove files from a saved game directory
 void savegame::cleanup (const std::string & name)
 {
-    struct dirent *dirent;
-    DIR *dir;
-
-    if ((dir = opendir (name.c_str ())) != NULL)
-    {
-        while ((dirent = readdir (dir)) != NULL)
-        {
-#ifdef WIN32
-            if (S_ISREG (get_file_type (name, dirent->d_name)))
-#else
-            if (dirent->d_type == DT_REG)
-#endif
-            {
-                std::string file = name + "/" + dirent->d_name;
-                unlink (file.c_str());
-            }
-        }
-        
-        closedir (dir);
-    }
-    else
+    if (!delete_files (name))
     {
 #ifdef WIN32
         if (mkdir (name.c_str()))
@@ -303,6 +434,41 @@ void savegame::cleanup (const std::string & name)
     }
 }
 
+// remove a saved game directory
+void savegame::remove_dir (const std::string & name)
+{
+    if (delete_files (name))
+    {
+        rmdir (name.c_str ());
+    }
+}
+
+// move newly written game into place
+bool savegame::commit (savegame_data *data)
+{
+    const std::string & dir = data->directory();
+    const std::string path = temp_dir (dir);
+    const std::string old = temp_dir (dir, ".old");
+    
+    // move the previous game out of the way ...
+    remove_dir (old);
+    bool replace = rename (dir.c_str (), old.c_str ()) == 0;
+    
+    // ... and the new one in its place
+    if (rename (path.c_str (), dir.c_str ()) != 0)
+    {
+        LOG(ERROR) << "*** savegame::commit: failed to rename " << path;
+        LOG(ERROR) << "    to " << dir;
+        
+        if (replace) rename (old.c_str (), dir.c_str ());
+        remove_dir (path);
+        return false;
+    }
+    
+    remove_dir (old);
+    return true;
+}
+
 // get game at given slot
 savegame_data *savegame::get (const s_int32 & slot)
 {
@@ -321,14 +487,14 @@ savegame_data *savegame::get (const s_int32 & slot)
 }
 
 // save meta data
-bool savegame::save_meta_data (savegame_data *data)
+bool savegame::save_meta_data (savegame_data *data, const std::string & path)
 {
     base::diskio file;
     
     file.put_string ("desc", data->description());
     file.put_uint32 ("time", data->gametime());
     
-    return file.put_record (data->directory() + "/meta.data");
+    return file.put_record (path + "/meta.data");
 }
 
 // load saved game meta data
@@ -35,6 +35,10 @@
 #include <vector>
 #include <list>
 #include <string>
+#ifndef SWIG
+#include <atomic>
+#include <thread>
+#endif
 
 #include "types.h"
 #include "serializer.h"
@@ -136,6 +140,8 @@ namespace base
      * \li - quick save: This slot can be used to save/load without bringing
      *       up a GUI.
      */
+    class diskio;
+
     class savegame
     {
     public:
@@ -206,12 +212,41 @@ namespace base
          * it is not allowed to overwrite INITIAL_SAVE.
          * Pass NEW_SAVE to write to an unused slot.
          *
+         * The game is written to a temporary directory next to the
+         * slot, which replaces the existing saved game only once all
+         * files have been written successfully.
+         *
+         * In background mode, the serializers only capture the game
+         * state in memory, which is then compressed and written to
+         * disk by a separate thread. Call in_progress() regularly to
+         * report progress and to complete the save once all files have
+         * been written, or wait() to block until then.
+         *
          * @param slot index of saved game slot.
          * @param desc user supplied description of the game.
          * @param gametime in-game timestamp.
-         * @return true on success, false otherwise.
+         * @param background whether to write files in the background.
+         * @return true on success, false otherwise. In background mode,
+         *      whether the game state could be captured.
+         */
+        bool save (const s_int32 & slot, const std::string & desc, const u_int32 & gametime, const bool & background = false);
+
+        /**
+         * Check whether a save started in background mode is still
+         * being written. Reports progress to the callback and completes
+         * the save once finished. Must be called from the main thread.
+         *
+         * @return true while files are being written, false otherwise.
          */
-        bool save (const s_int32 & slot, const std::string & desc, const u_int32 & gametime);
+        bool in_progress ();
+
+        /**
+         * Block until a save started in background mode has been written.
+         * Must be called from the main thread.
+         *
+         * @return false if writing the game failed, true otherwise.
+         */
+        bool wait ();
         //@}
         
         /**
@@ -248,17 +283,34 @@ namespace base
         
     protected:
         /**
-         * Delete all regular files in the given directory.
+         * Delete all regular files in the given directory. The
+         * directory is created if it does not exist yet.
          * @param name the directory name.
          */
         void cleanup (const std::string & name);
-            
+
+        /**
+         * Delete all regular files in the given directory and
+         * the directory itself.
+         * @param name the directory name.
+         */
+        void remove_dir (const std::string & name);
+
+        /**
+         * Replace the given saved game with the files written to
+         * its temporary directory.
+         * @param data the saved game.
+         * @return true on success, false otherwise.
+         */
+        bool commit (savegame_data *data);
+
         /**
          * Save meta information for the given saved gaem.
          * @param data the game data structure to save.
+         * @param path directory to write the meta information to.
          * @return true on success, false otherwise.
          */
-        bool save_meta_data (savegame_data *data);
+        bool save_meta_data (savegame_data *data, const std::string & path);
         
         /**
          * Load meta information of given saved game. If
@@ -271,6 +323,41 @@ namespace base
         static bool load_meta_data (const std::string & filepath);
         
     private:
+#ifndef SWIG
+        /**
+         * Report progress of saving or loading.
+         * @param percent the progress between 0 and 100.
+         */
+        void progress (const s_int32 & percent);
+
+        /**
+         * Update list of saved games after successful save.
+         * @param slot index of saved game slot.
+         * @param data the saved game.
+         */
+        void finish (const s_int32 & slot, savegame_data *data);
+
+        /**
+         * Write captured records to disk. Runs in a separate thread.
+         */
+        void write ();
+
+        /// thread writing records in background mode
+        std::thread *Writer;
+        /// records waiting to be written
+        std::list<base::diskio*> Records;
+        /// number of records written so far
+        std::atomic<u_int32> Written;
+        /// whether all records have been written successfully
+        std::atomic<bool> Success;
+        /// slot being saved in background mode
+        s_int32 Slot;
+        /// game being saved in background mode
+        savegame_data *Data;
+        /// the instance currently saving in the background
+        static savegame *Active;
+#endif
+
         /// the slot the current game is running from
         static s_int32 CurrentSlot;
         /// list of available saved games
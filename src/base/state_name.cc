@@ -0,0 +1,96 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/state_name.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Small integer ids for names of object states.
+ *
+ *
+ */
+
+#include <deque>
+#include <map>
+#include <mutex>
+
+#include "state_name.h"
+#include "logging.h"
+
+using base::state_name;
+
+namespace
+{
+    /// the known names, by id. Never shrinks, so references stay valid.
+    std::deque<std::string> & names ()
+    {
+        static std::deque<std::string> Names (1, std::string ());
+        return Names;
+    }
+
+    /// the known ids, by name
+    std::map<std::string, u_int16> & ids ()
+    {
+        static std::map<std::string, u_int16> Ids;
+        if (Ids.empty ()) Ids[std::string ()] = 0;
+        return Ids;
+    }
+
+    /// names may be looked up while loading in the background
+    std::mutex Mutex;
+}
+
+// get id of state name
+u_int16 state_name::id (const std::string & name)
+{
+    std::lock_guard<std::mutex> lock (Mutex);
+
+    std::map<std::string, u_int16> & known = ids ();
+    std::map<std::string, u_int16>::const_iterator i = known.find (name);
+    if (i != known.end ()) return i->second;
+
+    std::deque<std::string> & by_id = names ();
+    if (by_id.size () >= 0xFFFF)
+    {
+        LOG(ERROR) << "state_name::id: too many state names, ignoring '" << name << "'";
+        return 0;
+    }
+
+    u_int16 result = by_id.size ();
+    by_id.push_back (name);
+    known[name] = result;
+    return result;
+}
+
+// get state name of id
+const std::string & state_name::name (const u_int16 & id)
+{
+    std::lock_guard<std::mutex> lock (Mutex);
+
+    std::deque<std::string> & by_id = names ();
+    if (id >= by_id.size ()) return by_id[0];
+    return by_id[id];
+}
+
+// get number of ids
+u_int16 state_name::count ()
+{
+    std::lock_guard<std::mutex> lock (Mutex);
+    return names ().size ();
+}
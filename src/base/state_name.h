@@ -0,0 +1,78 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/state_name.h
+ * @author agent <agent@local>
+ *
+ * @brief  Small integer ids for names of object states.
+ *
+ *
+ */
+
+#ifndef BASE_STATE_NAME_H
+#define BASE_STATE_NAME_H
+
+#include <string>
+#include "types.h"
+
+namespace base
+{
+    /**
+     * Maps names of object states, such as the shapes of a model or the
+     * animations of a sprite, to small integer ids. Ids are handed out in
+     * order, starting with 0 for the empty name, and remain valid for the
+     * lifetime of the program. They are not meant to be saved.
+     *
+     * Objects that change their state frequently can look up the id once
+     * and use it instead of the name, which saves building and comparing
+     * strings. Users of ids can keep dense tables indexed by id.
+     */
+    class state_name
+    {
+    public:
+        /**
+         * Return the id of the given name, creating a new one if required.
+         * @param name a state name.
+         * @return id of the state name.
+         */
+        static u_int16 id (const std::string & name);
+
+        /**
+         * Return the name of the given id.
+         * @param id an id returned by state_name::id().
+         * @return the name belonging to the id, or the empty name for
+         *      unknown ids.
+         */
+        static const std::string & name (const u_int16 & id);
+
+        /**
+         * Return the number of ids handed out so far. All ids are less
+         * than this number.
+         * @return number of known state names.
+         */
+        static u_int16 count ();
+
+    private:
+        /// forbid instantiation
+        state_name ();
+    };
+}
+
+#endif // BASE_STATE_NAME_H
@@ -0,0 +1,111 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/telemetry.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Implements the frame timing telemetry.
+ *
+ *
+ */
+
+#include <algorithm>
+#include <iomanip>
+
+#include "telemetry.h"
+
+using base::telemetry;
+
+// telemetry state
+const u_int32 telemetry::WINDOW;
+std::atomic<u_int32> telemetry::Current[NUM_PHASES];
+u_int32 telemetry::Recent[NUM_PHASES][WINDOW];
+u_int32 telemetry::Next = 0;
+u_int32 telemetry::Count = 0;
+
+/// names of the phases
+static const char *PhaseNames[telemetry::NUM_PHASES] = {
+    "frame", "input", "events", "world", "pathfinding", "render", "present"
+};
+
+// complete the current frame
+void telemetry::next_frame (const u_int32 & busy)
+{
+    Current[FRAME] = busy;
+    for (u_int32 p = 0; p < NUM_PHASES; p++)
+    {
+        Recent[p][Next] = Current[p].exchange (0);
+    }
+
+    Next = (Next + 1) % WINDOW;
+    if (Count < WINDOW) Count++;
+}
+
+// time spent in phase by given percentage of recent frames
+u_int32 telemetry::percentile (const phase & p, const u_int32 & percent)
+{
+    if (Count == 0 || p >= NUM_PHASES) return 0;
+
+    u_int32 sorted[WINDOW];
+    std::copy (Recent[p], Recent[p] + Count, sorted);
+
+    // nearest rank
+    u_int32 rank = (percent * Count + 99) / 100;
+    u_int32 index = rank > 0 ? std::min (rank, Count) - 1 : 0;
+
+    std::nth_element (sorted, sorted + index, sorted + Count);
+    return sorted[index];
+}
+
+// get name of phase
+const char *telemetry::name (const phase & p)
+{
+    return p < NUM_PHASES ? PhaseNames[p] : "";
+}
+
+// drop all data
+void telemetry::reset ()
+{
+    for (u_int32 p = 0; p < NUM_PHASES; p++)
+    {
+        Current[p] = 0;
+    }
+
+    Next = 0;
+    Count = 0;
+}
+
+// write percentiles
+void telemetry::dump (std::ostream & out)
+{
+    out << std::setw (12) << std::left << "phase"
+        << std::right << std::setw (9) << "p50" << std::setw (9) << "p95"
+        << std::setw (9) << "p99" << std::setw (9) << "max" << std::endl;
+
+    for (u_int32 p = 0; p < NUM_PHASES; p++)
+    {
+        phase ph = (phase) p;
+        out << std::setw (12) << std::left << name (ph) << std::right
+            << std::setw (9) << percentile (ph, 50)
+            << std::setw (9) << percentile (ph, 95)
+            << std::setw (9) << percentile (ph, 99)
+            << std::setw (9) << percentile (ph, 100) << std::endl;
+    }
+}
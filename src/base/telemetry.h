@@ -0,0 +1,179 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/telemetry.h
+ * @author agent <agent@local>
+ *
+ * @brief  Declares the frame timing telemetry.
+ *
+ *
+ */
+
+#ifndef BASE_TELEMETRY_H
+#define BASE_TELEMETRY_H
+
+#include <atomic>
+#include <ostream>
+
+#include "timer.h"
+
+namespace base
+{
+    /**
+     * Collects the time spent in each phase of a frame, such as updating
+     * the world or rendering it, over the most recent frames. From those,
+     * percentiles can be queried at any time, to tell typical frames from
+     * the occasional spike.
+     *
+     * The engine measures its phases by itself. Each frame ends with the
+     * next call to base::Timer.update(). Phases may be measured from any
+     * thread, and a phase may be measured several times per frame, in
+     * which case the times are added. Phases may be nested: pathfinding,
+     * for example, is part of the world update.
+     */
+    class telemetry
+    {
+    public:
+        /// phases of a frame
+        enum phase
+        {
+            /// time spent computing the whole frame, not counting waiting for the next
+            FRAME,
+            /// processing input
+            INPUT,
+            /// updating game time and raising time events
+            EVENTS,
+            /// updating the active map, including pathfinding
+            WORLD,
+            /// updating pathfinding tasks
+            PATHFINDING,
+            /// drawing the map view
+            RENDER,
+            /// copying the frame to the screen
+            PRESENT,
+            /// number of phases
+            NUM_PHASES
+        };
+
+        /// number of frames that percentiles are calculated over
+        static const u_int32 WINDOW = 128;
+
+        /**
+         * Add time spent in a phase during the current frame.
+         * @param p the phase.
+         * @param usecs time spent in microseconds.
+         */
+        static void add (const phase & p, const u_int32 & usecs)
+        {
+            Current[p] += usecs;
+        }
+
+        /**
+         * Complete the current frame. Called by base::timer::update().
+         * @param busy time spent on the frame, in microseconds.
+         */
+        static void next_frame (const u_int32 & busy);
+
+        /**
+         * Return the time that the given percentage of recent frames
+         * spent in a phase at most. The 50th percentile is the median,
+         * the 100th the slowest frame.
+         * @param p the phase.
+         * @param percent a value between 1 and 100.
+         * @return time spent in microseconds.
+         */
+        static u_int32 percentile (const phase & p, const u_int32 & percent);
+
+        /**
+         * Return the number of frames that percentiles are calculated
+         * over, which is less than WINDOW right after start up.
+         * @return number of recent frames.
+         */
+        static u_int32 frames () { return Count; }
+
+        /**
+         * Return the name of a phase.
+         * @param p the phase.
+         * @return the name, e.g. "render".
+         */
+        static const char *name (const phase & p);
+
+        /**
+         * Drop all data collected so far.
+         */
+        static void reset ();
+
+#ifndef SWIG
+        /**
+         * Write median, 95th and 99th percentile and maximum of each
+         * phase, in microseconds, as a table.
+         * @param out stream to write to.
+         */
+        static void dump (std::ostream & out);
+
+        /**
+         * Measure the time spent in a phase for the lifetime of this
+         * object.
+         */
+        class scope
+        {
+        public:
+            /**
+             * Start measuring.
+             * @param p the phase.
+             */
+            scope (const phase & p) : Phase (p), Start (timer::monotonic ())
+            {
+            }
+
+            /**
+             * Stop measuring and add the time to the phase.
+             */
+            ~scope ()
+            {
+                add (Phase, timer::monotonic () - Start);
+            }
+
+        private:
+            /// the phase being measured
+            phase Phase;
+            /// when measuring started
+            u_int32 Start;
+        };
+#endif // SWIG
+
+    private:
+        /// forbid instantiation
+        telemetry ();
+
+#ifndef SWIG
+        /// time spent in each phase during the current frame
+        static std::atomic<u_int32> Current[NUM_PHASES];
+#endif
+        /// time spent in each phase during recent frames
+        static u_int32 Recent[NUM_PHASES][WINDOW];
+        /// index of the oldest recent frame
+        static u_int32 Next;
+        /// number of recent frames
+        static u_int32 Count;
+    };
+}
+
+#endif // BASE_TELEMETRY_H
@@ -0,0 +1,332 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_diskio.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for saving and loading records.
+ *
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "diskio.h"
+#include "diskwriter_lz.h"
+
+#include <gtest/gtest.h>
+
+namespace base
+{
+    class diskio_Test : public ::testing::Test {
+
+    protected:
+        /**
+         * Compress and decompress the given data.
+         */
+        void roundtrip (const std::string & data)
+        {
+            std::vector<char> packed (disk_writer_lz::bound (data.size ()));
+            u_int32 length = disk_writer_lz::compress (data.data (), data.size (), &packed[0]);
+            ASSERT_LE(length, packed.size ());
+
+            std::vector<char> result (data.size () + 1);
+            ASSERT_TRUE(disk_writer_lz::decompress (&packed[0], length, &result[0], data.size ()));
+            EXPECT_EQ(data, std::string (&result[0], data.size ()));
+
+            // wrong size is detected
+            EXPECT_FALSE(disk_writer_lz::decompress (&packed[0], length, &result[0], data.size () + 1));
+        }
+
+        /**
+         * Fill a record with some data.
+         */
+        void fill (flat & record)
+        {
+            flat nested;
+            nested.put_string ("name", "nested");
+            nested.put_float ("f", 3.1415f);
+
+            for (u_int32 i = 0; i < 500; i++)
+            {
+                std::ostringstream id;
+                id << "field_" << i;
+                record.put_sint32 (id.str (), i * 7 - 1000);
+            }
+            record.put_flat ("nested", nested);
+            record.put_string ("last", "end");
+        }
+
+        /**
+         * Save a record to file and load it again.
+         */
+        void save_and_load (const std::string & filename, const diskio::file_format & format)
+        {
+            diskio out (format);
+            fill (out);
+            u_int32 checksum = out.checksum ();
+            ASSERT_TRUE(out.put_record (filename));
+
+            // file type is detected from the file content
+            diskio in;
+            ASSERT_TRUE(in.get_record (filename));
+            EXPECT_EQ(checksum, in.checksum ());
+            EXPECT_EQ(491, in.get_sint32 ("field_213"));
+            EXPECT_EQ("end", in.get_string ("last"));
+            EXPECT_TRUE(in.success ());
+
+            remove (filename.c_str ());
+        }
+    }; // class{}
+
+    TEST_F(diskio_Test, lz_roundtrip) {
+        roundtrip ("");
+        roundtrip ("a");
+        roundtrip ("abcdefghijklm");
+        roundtrip (std::string (1000, 'x'));
+        roundtrip (std::string (100000, '\0') + "abcd");
+
+        // repeating pattern with long matches and literal runs
+        std::string pattern;
+        for (u_int32 i = 0; i < 20000; i++)
+        {
+            pattern += (char) ('a' + (i % 7) + (i % 1000 < 300 ? i % 13 : 0));
+        }
+        roundtrip (pattern);
+
+        // incompressible data
+        std::string noise;
+        srand (42);
+        for (u_int32 i = 0; i < 70000; i++)
+        {
+            noise += (char) (rand () & 0xFF);
+        }
+        roundtrip (noise);
+        roundtrip (noise + noise);
+    }
+
+    TEST_F(diskio_Test, lz_compresses) {
+        std::string data;
+        for (u_int32 i = 0; i < 1000; i++)
+        {
+            data += "a fairly repetitive string ";
+        }
+
+        std::vector<char> packed (disk_writer_lz::bound (data.size ()));
+        u_int32 length = disk_writer_lz::compress (data.data (), data.size (), &packed[0]);
+        EXPECT_LT(length, data.size () / 10);
+    }
+
+    TEST_F(diskio_Test, lz_corrupt_data) {
+        std::string data (5000, 'y');
+        data += "some literals at the end";
+
+        std::vector<char> packed (disk_writer_lz::bound (data.size ()));
+        u_int32 length = disk_writer_lz::compress (data.data (), data.size (), &packed[0]);
+        std::vector<char> result (data.size ());
+
+        // truncated data
+        EXPECT_FALSE(disk_writer_lz::decompress (&packed[0], length / 2, &result[0], data.size ()));
+
+        // offset pointing before the start of the data
+        packed[2] = (char) 0xFF;
+        packed[3] = (char) 0xFF;
+        EXPECT_FALSE(disk_writer_lz::decompress (&packed[0], length, &result[0], data.size ()));
+    }
+
+    TEST_F(diskio_Test, lz_corrupt_header) {
+        const std::string filename = "/tmp/test_diskio_header.alz";
+        disk_writer_lz writer;
+        flat data;
+
+        // sizes that do not match the file are rejected before allocating
+        const u_int8 sizes[][8] = {
+            { 0x00, 0x00, 0x00, 0x80, 0x10, 0x00, 0x00, 0x00 },
+            { 0x10, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x7f },
+            { 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }
+        };
+
+        for (u_int32 i = 0; i < 3; i++)
+        {
+            FILE *out = fopen (filename.c_str (), "wb");
+            ASSERT_TRUE(out != NULL);
+            fwrite (disk_writer_lz::MAGIC, 4, 1, out);
+            fwrite (sizes[i], 8, 1, out);
+            fwrite (std::string (20, 'z').data (), 20, 1, out);
+            fclose (out);
+
+            EXPECT_FALSE(writer.get_state (filename, data));
+        }
+
+        remove (filename.c_str ());
+    }
+
+    TEST_F(diskio_Test, formats) {
+        save_and_load ("/tmp/test_diskio.data", diskio::GZ_FILE);
+        save_and_load ("/tmp/test_diskio.data", diskio::LZ_FILE);
+        save_and_load ("/tmp/test_diskio.data", diskio::XML_FILE);
+        save_and_load ("/tmp/test_diskio.data", diskio::MAPPED_FILE);
+    }
+
+    TEST_F(diskio_Test, by_extension) {
+        EXPECT_EQ(diskio::XML_FILE, diskio::format_for_extension ("map.xml"));
+        EXPECT_EQ(diskio::LZ_FILE, diskio::format_for_extension ("map.alz"));
+        EXPECT_EQ(diskio::MAPPED_FILE, diskio::format_for_extension ("map.amap"));
+        EXPECT_EQ(diskio::GZ_FILE, diskio::format_for_extension ("map.data"));
+        EXPECT_EQ(diskio::GZ_FILE, diskio::format_for_extension ("x"));
+
+        save_and_load ("/tmp/test_diskio.alz", diskio::BY_EXTENSION);
+        save_and_load ("/tmp/test_diskio.amap", diskio::BY_EXTENSION);
+    }
+
+    TEST_F(diskio_Test, mapped) {
+        const std::string filename = "/tmp/test_diskio_mapped.amap";
+
+        diskio out;
+        fill (out);
+        u_int32 checksum = out.checksum ();
+        ASSERT_TRUE(out.put_record (filename));
+
+        diskio in;
+        ASSERT_TRUE(in.get_record (filename));
+        EXPECT_EQ(checksum, in.checksum ());
+
+        // nested records refer to the mapped file
+        flat_view nested (in, "nested");
+        EXPECT_EQ("nested", nested.get_string ("name"));
+
+        // writing creates a private copy, leaving the file alone
+        in.put_string ("added", "value");
+        EXPECT_EQ("value", in.get_string ("added"));
+
+        // saving to the mapped file does not disturb records still using it
+        diskio again;
+        ASSERT_TRUE(again.get_record (filename));
+        fill (out);
+        out.put_string ("more", "data");
+        ASSERT_TRUE(out.put_record (filename));
+        EXPECT_EQ(checksum, again.checksum ());
+
+        // loading another file replaces the mapping
+        ASSERT_TRUE(again.get_record (filename));
+        EXPECT_EQ("data", again.get_string ("more"));
+
+        diskio unchanged;
+        ASSERT_TRUE(unchanged.get_record (filename));
+        EXPECT_FALSE(unchanged.get_string ("added", true) == "value");
+
+        remove (filename.c_str ());
+    }
+
+    TEST_F(diskio_Test, mapped_corrupt) {
+        const std::string filename = "/tmp/test_diskio_corrupt.amap";
+
+        diskio out;
+        fill (out);
+        ASSERT_TRUE(out.put_record (filename));
+
+        // the size of the first field reaches past the end of the record
+        std::string data;
+        {
+            std::ifstream in (filename.c_str (), std::ios::binary);
+            std::ostringstream content;
+            content << in.rdbuf ();
+            data = content.str ();
+        }
+        std::string::size_type pos = data.find ('\0', 17) + 2;
+        data.replace (pos, 4, 4, (char) 0x7f);
+        {
+            std::ofstream corrupt (filename.c_str (), std::ios::binary);
+            corrupt << data;
+        }
+
+        // loading is fast, but reading fails
+        diskio in;
+        ASSERT_TRUE(in.get_record (filename));
+        EXPECT_EQ("", in.get_string ("last", true));
+        EXPECT_FALSE(in.success ());
+
+        // a truncated file is rejected right away
+        truncate (filename.c_str (), data.length () - 1);
+        diskio truncated;
+        EXPECT_FALSE(truncated.get_record (filename));
+
+        remove (filename.c_str ());
+    }
+
+    TEST_F(diskio_Test, read_record) {
+        const std::string filename = "/tmp/test_diskio_read.alz";
+        diskio out;
+        fill (out);
+        u_int32 checksum = out.checksum ();
+        ASSERT_TRUE(out.put_record (filename));
+
+        // file is read from given path, without searching for it
+        diskio in;
+        ASSERT_TRUE(in.read_record (filename));
+        EXPECT_EQ(checksum, in.checksum ());
+        remove (filename.c_str ());
+
+        diskio missing;
+        EXPECT_FALSE(missing.read_record (filename));
+    }
+
+    TEST_F(diskio_Test, deferred) {
+        const std::string filename = "/tmp/test_diskio_deferred.data";
+        std::list<diskio*> records;
+        struct stat statbuf;
+
+        diskio::set_deferred (&records);
+        EXPECT_TRUE(diskio::is_deferred ());
+
+        diskio out;
+        fill (out);
+        u_int32 checksum = out.checksum ();
+        ASSERT_TRUE(out.put_record (filename));
+        diskio::set_deferred (NULL);
+
+        // nothing written yet
+        ASSERT_EQ(1u, records.size ());
+        EXPECT_NE(0, stat (filename.c_str (), &statbuf));
+
+        ASSERT_TRUE(records.front ()->write_record ());
+        delete records.front ();
+        EXPECT_EQ(0, stat (filename.c_str (), &statbuf));
+        EXPECT_NE(0, stat ((filename + ".tmp").c_str (), &statbuf));
+
+        diskio in;
+        ASSERT_TRUE(in.get_record (filename));
+        EXPECT_EQ(checksum, in.checksum ());
+
+        remove (filename.c_str ());
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
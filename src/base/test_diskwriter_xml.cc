@@ -0,0 +1,205 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_diskwriter_xml.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for reading xml records.
+ *
+ *
+ */
+
+#include <cstdio>
+
+#include "diskwriter_xml.h"
+
+#include <gtest/gtest.h>
+
+namespace base
+{
+    class diskwriter_xml_Test : public ::testing::Test {
+
+    protected:
+        /**
+         * Read the given file with both the fast reader and libxml2
+         * and check that they agree.
+         * @return \b true if fast reader was able to read the file.
+         */
+        bool compare (const std::string & filename)
+        {
+            disk_writer_xml writer;
+            flat expected, fast;
+            EXPECT_TRUE(writer.get_state_sax (filename, expected));
+
+            // fast reader on its own
+            FILE *file = fopen (filename.c_str (), "rb");
+            std::vector<char> buffer (65536);
+            u_int32 length = fread (&buffer[0], 1, buffer.size (), file);
+            fclose (file);
+            bool result = disk_writer_xml::parse (&buffer[0], length, fast);
+            if (result)
+            {
+                EXPECT_EQ(expected.size (), fast.size ());
+                EXPECT_EQ(expected.checksum (), fast.checksum ());
+            }
+
+            // get_state falls back to libxml2 where necessary
+            flat record;
+            EXPECT_TRUE(writer.get_state (filename, record));
+            EXPECT_EQ(expected.checksum (), record.checksum ());
+            return result;
+        }
+
+        /**
+         * Write an xml document to file.
+         */
+        void write (const std::string & filename, const std::string & document)
+        {
+            FILE *file = fopen (filename.c_str (), "wb");
+            fwrite (document.data (), 1, document.size (), file);
+            fclose (file);
+        }
+    }; // class{}
+
+    TEST_F(diskwriter_xml_Test, written_records) {
+        const std::string filename = "/tmp/test_diskwriter_xml.xml";
+
+        u_int8 blob[256];
+        for (u_int32 i = 0; i < 256; i++)
+        {
+            blob[i] = (u_int8) i;
+        }
+
+        flat empty, inner, nested;
+        inner.put_string ("markup", "<list id=\"x\"> & 'quoted' </list>");
+        inner.put_flat ("empty", empty);
+        nested.put_flat ("inner", inner);
+        nested.put_flat ("", empty);
+
+        flat record;
+        record.put_bool ("bool", true);
+        record.put_char ("char", '&');
+        record.put_uint8 ("u8", 255);
+        record.put_sint8 ("s8", -128);
+        record.put_uint16 ("u16", 65535);
+        record.put_sint16 ("s16", -32768);
+        record.put_uint32 ("u32", 4000000000u);
+        record.put_sint32 ("s32", -2000000000);
+        record.put_float ("float", 3.1415f);
+        record.put_double ("double", -1.0e-100);
+        record.put_string ("empty", "");
+        record.put_string ("spaces", "  leading and trailing\twhitespace\n\n ");
+        record.put_string ("utf-8", "gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xF0\x9D\x84\x9E");
+        record.put_string ("id with <markup> \"quotes\"\n", "value");
+        record.put_block ("blob", blob, sizeof (blob));
+        record.put_flat ("nested", nested);
+        record.put_uint8 ("u8", 1);
+
+        disk_writer_xml writer;
+        ASSERT_TRUE(writer.put_state (filename, record));
+        EXPECT_TRUE(compare (filename));
+
+        flat result;
+        ASSERT_TRUE(writer.get_state (filename, result));
+        EXPECT_EQ(record.checksum (), result.checksum ());
+
+        // libxml2 turns '&' in attributes into "&#38;" when entities
+        // are not replaced, so only check the fast reader for that
+        flat ampersand;
+        ampersand.put_string ("id & ampersand", "value");
+        ASSERT_TRUE(writer.put_state (filename, ampersand));
+        ASSERT_TRUE(writer.get_state (filename, result));
+        EXPECT_EQ(ampersand.checksum (), result.checksum ());
+        EXPECT_EQ("value", result.get_string ("id & ampersand"));
+
+        remove (filename.c_str ());
+    }
+
+    TEST_F(diskwriter_xml_Test, hand_written) {
+        const std::string filename = "/tmp/test_diskwriter_xml.xml";
+
+        write (filename,
+            "\xEF\xBB\xBF<?xml version='1.0' encoding='utf-8'?>\r\n"
+            "<!-- edited by hand -->\r\n"
+            "<Data cs=\"0\">\r\n"
+            "  <string id='single\tquoted'>line\r\nbreaks\rand &#x41;&#66; &amp;&lt;&gt;&quot;&apos;</string>\r\n"
+            "  <list id = \"a\" >\r\n"
+            "    <!-- comment in list -->\r\n"
+            "    <u_int16 id=\"x\">  12 </u_int16>\r\n"
+            "    <s_int32 id=\"y\">-<!-- split -->42</s_int32>\r\n"
+            "    <list/>\r\n"
+            "    <blob id=\"b\">00ff7F80</blob>\r\n"
+            "  </list  >\r\n"
+            "  <bool idx=\"first\" id=\"second\">1</bool>\r\n"
+            "  <string/>\r\n"
+            "</Data>\r\n"
+            "<?pi after root?>\r\n");
+
+        EXPECT_TRUE(compare (filename));
+        remove (filename.c_str ());
+    }
+
+    TEST_F(diskwriter_xml_Test, unsupported) {
+        const std::string filename = "/tmp/test_diskwriter_xml.xml";
+        const char *documents[] = {
+            "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><Data><string id=\"a\">\xE4</string></Data>",
+            "<!DOCTYPE Data><Data><u_int8 id=\"a\">1</u_int8></Data>",
+            "<Data><string id=\"a\"><![CDATA[<text>]]></string></Data>",
+            NULL
+        };
+
+        // fast reader gives up, but the result is the same
+        for (u_int32 i = 0; documents[i] != NULL; i++)
+        {
+            write (filename, documents[i]);
+            EXPECT_FALSE(compare (filename)) << documents[i];
+        }
+
+        remove (filename.c_str ());
+    }
+
+    TEST_F(diskwriter_xml_Test, malformed) {
+        const char *documents[] = {
+            "",
+            "<Data>",
+            "<Root></Root>",
+            "<Data><u_int8 id=\"a\">1</u_int16></Data>",
+            "<Data><list><u_int8>1</u_int8></Data>",
+            "<Data><unknown id=\"a\">1</unknown></Data>",
+            "<Data><string id=\"a\">&nbsp;</string></Data>",
+            "<Data><string id=\"a>x</string></Data>",
+            "<Data></Data>trailing",
+            NULL
+        };
+
+        for (u_int32 i = 0; documents[i] != NULL; i++)
+        {
+            flat record;
+            EXPECT_FALSE(disk_writer_xml::parse (documents[i], strlen (documents[i]), record)) << documents[i];
+        }
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
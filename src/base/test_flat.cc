@@ -0,0 +1,279 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_flat.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for retrieving data from the flat class.
+ *
+ *
+ */
+
+#include <cstdio>
+#include <sstream>
+
+#include "diskio.h"
+#include "flat_stream.h"
+
+#include <gtest/gtest.h>
+
+namespace base
+{
+    class flat_Test : public ::testing::TestWithParam<u_int32> {
+
+    protected:
+        /**
+         * Fill a record with the given number of numbered fields.
+         */
+        void fill (flat & record, const u_int32 & count)
+        {
+            for (u_int32 i = 0; i < count; i++)
+            {
+                record.put_uint32 (name (i), i);
+            }
+        }
+
+        std::string name (const u_int32 & i)
+        {
+            std::ostringstream id;
+            id << "field_" << i;
+            return id.str ();
+        }
+    }; // class{}
+
+    TEST_P(flat_Test, in_order) {
+        flat written;
+        fill (written, GetParam ());
+
+        flat record (written);
+        for (u_int32 i = 0; i < GetParam (); i++)
+        {
+            EXPECT_EQ(i, record.get_uint32 (name (i)));
+        }
+        EXPECT_TRUE(record.success ());
+    }
+
+    TEST_P(flat_Test, out_of_order) {
+        flat written;
+        fill (written, GetParam ());
+
+        flat record (written);
+        for (u_int32 i = GetParam (); i > 0; i--)
+        {
+            EXPECT_EQ(i - 1, record.get_uint32 (name (i - 1)));
+        }
+        for (u_int32 i = 0; i < GetParam (); i += 3)
+        {
+            EXPECT_EQ(i, record.get_uint32 (name (i)));
+        }
+        EXPECT_TRUE(record.success ());
+
+        EXPECT_EQ(0u, record.get_uint32 ("missing", true));
+        EXPECT_TRUE(record.success ());
+        EXPECT_EQ(0u, record.get_uint32 ("missing"));
+        EXPECT_FALSE(record.success ());
+    }
+
+    TEST_P(flat_Test, duplicate_names) {
+        flat record;
+        fill (record, GetParam ());
+        for (u_int32 i = 0; i < 3; i++)
+        {
+            record.put_uint32 ("dup", 100 + i);
+            record.put_string ("other", "x");
+        }
+
+        // duplicates are returned in order, wrapping around at the end
+        EXPECT_EQ(100u, record.get_uint32 ("dup"));
+        EXPECT_EQ(101u, record.get_uint32 ("dup"));
+        EXPECT_EQ(102u, record.get_uint32 ("dup"));
+        EXPECT_EQ(100u, record.get_uint32 ("dup"));
+
+        // lookup continues after the last field retrieved
+        if (GetParam () == 0) return;
+        EXPECT_EQ(0u, record.get_uint32 (name (0)));
+        EXPECT_EQ(100u, record.get_uint32 ("dup"));
+        EXPECT_EQ("x", record.get_string ("other"));
+        EXPECT_EQ(101u, record.get_uint32 ("dup"));
+    }
+
+    TEST_P(flat_Test, next_after_get) {
+        flat record;
+        fill (record, GetParam ());
+        if (GetParam () < 2) return;
+
+        u_int32 size;
+        void *value;
+        char *id;
+
+        // next continues after the field retrieved by get
+        record.get_uint32 (name (GetParam () / 2));
+        for (u_int32 i = GetParam () / 2 + 1; i < GetParam (); i++)
+        {
+            ASSERT_EQ(flat::T_UINT32, record.next (&value, &size, &id));
+            EXPECT_EQ(name (i), id);
+            EXPECT_EQ(i, *((u_int32*) value));
+        }
+        EXPECT_EQ(flat::T_UNKNOWN, record.next (&value, &size, &id));
+
+        record.first ();
+        ASSERT_EQ(flat::T_UINT32, record.next (&value, &size, &id));
+        EXPECT_EQ(name (0), id);
+    }
+
+    TEST_P(flat_Test, stream_to_file) {
+        const std::string filename = "/tmp/test_flat_stream.data";
+
+        flat nested;
+        fill (nested, GetParam ());
+
+        // use a small chunk size to write the record in many pieces
+        flat_stream stream (64);
+        ASSERT_TRUE(stream.open (filename));
+        fill (stream, GetParam ());
+        stream.put_flat ("nested", nested);
+        stream.put_string ("last", "end");
+        ASSERT_TRUE(stream.close ());
+
+        // the same record built in memory
+        flat expected;
+        fill (expected, GetParam ());
+        expected.put_flat ("nested", nested);
+        expected.put_string ("last", "end");
+        EXPECT_EQ(expected.checksum (), stream.checksum ());
+
+        diskio record;
+        ASSERT_TRUE(record.get_record (filename));
+        EXPECT_EQ(expected.size (), record.size ());
+        EXPECT_EQ(expected.checksum (), record.checksum ());
+
+        for (u_int32 i = 0; i < GetParam (); i++)
+        {
+            EXPECT_EQ(i, record.get_uint32 (name (i)));
+        }
+        flat copy = record.get_flat ("nested");
+        EXPECT_EQ(nested.checksum (), copy.checksum ());
+        EXPECT_EQ("end", record.get_string ("last"));
+        EXPECT_TRUE(record.success ());
+
+        remove (filename.c_str ());
+    }
+
+    TEST_P(flat_Test, stream_keeps_file_until_closed) {
+        const std::string filename = "/tmp/test_flat_stream.data";
+
+        flat_stream stream (64);
+        ASSERT_TRUE(stream.open (filename));
+        stream.put_string ("first", "old");
+        ASSERT_TRUE(stream.close ());
+
+        // a record that is never completed ...
+        {
+            flat_stream aborted (64);
+            ASSERT_TRUE(aborted.open (filename));
+            fill (aborted, GetParam ());
+        }
+
+        // ... leaves the previous one alone
+        diskio record;
+        ASSERT_TRUE(record.get_record (filename));
+        EXPECT_EQ("old", record.get_string ("first"));
+
+        // neither can a record be written where no file can be created
+        EXPECT_FALSE(stream.open ("/no/such/dir/test_flat_stream.data"));
+
+        remove (filename.c_str ());
+    }
+
+    TEST_P(flat_Test, begin_end_flat) {
+        flat nested;
+        fill (nested, GetParam ());
+
+        // a nested record written in place ...
+        flat record;
+        record.put_string ("first", "start");
+        u_int32 start = record.begin_flat ("nested");
+        fill (record, GetParam ());
+        record.end_flat (start);
+        record.put_string ("last", "end");
+
+        // ... matches one built separately
+        flat expected;
+        expected.put_string ("first", "start");
+        expected.put_flat ("nested", nested);
+        expected.put_string ("last", "end");
+        EXPECT_EQ(expected.size (), record.size ());
+        EXPECT_EQ(expected.checksum (), record.checksum ());
+
+        flat copy = record.get_flat ("nested");
+        EXPECT_EQ(nested.checksum (), copy.checksum ());
+        EXPECT_EQ("end", record.get_string ("last"));
+        EXPECT_TRUE(record.success ());
+    }
+
+    TEST_P(flat_Test, stream_nested_to_file) {
+        const std::string filename = "/tmp/test_flat_stream.data";
+
+        flat inner;
+        fill (inner, GetParam ());
+        flat outer;
+        outer.put_flat ("inner", inner);
+        fill (outer, GetParam ());
+
+        // nested records spanning many chunks
+        flat_stream stream (64);
+        ASSERT_TRUE(stream.open (filename));
+        u_int32 start = stream.begin_flat ("outer");
+        u_int32 nested = stream.begin_flat ("inner");
+        fill (stream, GetParam ());
+        stream.end_flat (nested);
+        fill (stream, GetParam ());
+        stream.end_flat (start);
+        stream.put_string ("last", "end");
+        ASSERT_TRUE(stream.close ());
+
+        // the same record built in memory
+        flat expected;
+        expected.put_flat ("outer", outer);
+        expected.put_string ("last", "end");
+        EXPECT_EQ(expected.checksum (), stream.checksum ());
+
+        diskio record;
+        ASSERT_TRUE(record.get_record (filename));
+        EXPECT_EQ(expected.size (), record.size ());
+        EXPECT_EQ(expected.checksum (), record.checksum ());
+
+        flat copy = record.get_flat ("outer");
+        EXPECT_EQ(outer.checksum (), copy.checksum ());
+        EXPECT_EQ("end", record.get_string ("last"));
+        EXPECT_TRUE(record.success ());
+
+        remove (filename.c_str ());
+    }
+
+    INSTANTIATE_TEST_CASE_P(sizes, flat_Test, ::testing::Values (0u, 1u, 8u, 9u, 1000u));
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
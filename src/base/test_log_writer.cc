@@ -0,0 +1,267 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_log_writer.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for the log_writer and mpsc_queue classes.
+ *
+ *
+ */
+
+#include "log_writer.h"
+#include "mpsc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logging
+{
+    /// read everything written to the given file
+    static std::string contents (FILE *file)
+    {
+        std::string result;
+        char buf[256];
+        size_t read;
+
+        rewind (file);
+        while ((read = fread (buf, 1, sizeof (buf), file)) > 0)
+        {
+            result.append (buf, read);
+        }
+        return result;
+    }
+
+    TEST(mpsc_queue, push_pop) {
+        base::mpsc_queue<u_int32> queue (3);
+        EXPECT_EQ(4, queue.capacity ());
+
+        u_int32 item = 0;
+        EXPECT_FALSE(queue.pop (item));
+
+        for (u_int32 i = 1; i <= 4; i++)
+        {
+            EXPECT_TRUE(queue.push (i));
+        }
+        EXPECT_FALSE(queue.push (5));
+
+        // items come out in order, and free their slots
+        EXPECT_TRUE(queue.pop (item));
+        EXPECT_EQ(1, item);
+        EXPECT_TRUE(queue.push (5));
+
+        for (u_int32 i = 2; i <= 5; i++)
+        {
+            EXPECT_TRUE(queue.pop (item));
+            EXPECT_EQ(i, item);
+        }
+        EXPECT_FALSE(queue.pop (item));
+    }
+
+    static const u_int32 PRODUCERS = 4, ITEMS = 20000;
+
+    /// push the items of one producer
+    static void produce (base::mpsc_queue<u_int32> *queue, const u_int32 p)
+    {
+        for (u_int32 i = 0; i < ITEMS; i++)
+        {
+            while (!queue->push (p * ITEMS + i)) std::this_thread::yield ();
+        }
+    }
+
+    TEST(mpsc_queue, producers) {
+        base::mpsc_queue<u_int32> queue (64);
+
+        std::vector<std::thread> threads;
+        for (u_int32 p = 0; p < PRODUCERS; p++)
+        {
+            threads.push_back (std::thread (produce, &queue, p));
+        }
+
+        // every item arrives exactly once, in order per producer
+        std::vector<u_int32> next (PRODUCERS, 0);
+        u_int32 item;
+        for (u_int32 count = 0; count < PRODUCERS * ITEMS; )
+        {
+            if (queue.pop (item))
+            {
+                u_int32 p = item / ITEMS;
+                ASSERT_EQ(p * ITEMS + next[p], item);
+                next[p]++;
+                count++;
+            }
+            else std::this_thread::yield ();
+        }
+
+        for (u_int32 p = 0; p < PRODUCERS; p++)
+        {
+            threads[p].join ();
+        }
+        EXPECT_FALSE(queue.pop (item));
+    }
+
+    TEST(log_writer, repeats) {
+        EXPECT_FALSE(log_writer::write ("not running"));
+
+        FILE *out = tmpfile ();
+        ASSERT_TRUE(out != NULL);
+
+        // glog does its own buffering
+        if (!log_writer::start (out, 256)) return;
+        EXPECT_TRUE(log_writer::is_running ());
+
+        EXPECT_TRUE(log_writer::write ("first"));
+        for (u_int32 i = 0; i < 10; i++)
+        {
+            EXPECT_TRUE(log_writer::write ("again"));
+        }
+        EXPECT_TRUE(log_writer::write ("last"));
+        EXPECT_TRUE(log_writer::write (std::string (1000, 'x')));
+
+        log_writer::stop ();
+        EXPECT_FALSE(log_writer::is_running ());
+        EXPECT_EQ(0, log_writer::dropped ());
+
+        std::string expected = "first\nagain\n*** last message repeated 9 times\nlast\n";
+        expected += std::string (log_writer::MAX_LENGTH, 'x') + "\n";
+        EXPECT_EQ(expected, contents (out));
+
+        fclose (out);
+    }
+
+    TEST(log_writer, dropped) {
+        FILE *out = tmpfile ();
+        ASSERT_TRUE(out != NULL);
+
+        if (!log_writer::start (out, 2)) return;
+
+        // far more messages than fit into the queue
+        const u_int32 MESSAGES = 100000;
+        for (u_int32 i = 0; i < MESSAGES; i++)
+        {
+            log_writer::write (std::to_string (i));
+        }
+
+        log_writer::stop ();
+
+        // whatever was not written has been counted
+        std::string written = contents (out);
+        u_int32 lines = 0, dropped = 0;
+        for (std::string::size_type pos = 0; pos < written.length (); pos = written.find ('\n', pos) + 1)
+        {
+            u_int32 count;
+            if (sscanf (written.c_str () + pos, "*** %u log messages dropped", &count) == 1) dropped += count;
+            else lines++;
+        }
+
+        EXPECT_EQ(dropped, log_writer::dropped ());
+        EXPECT_GT(dropped, 0);
+        EXPECT_EQ(MESSAGES, lines + dropped);
+
+        fclose (out);
+    }
+
+    TEST(log_writer, flood_of_repeats) {
+        FILE *out = tmpfile ();
+        ASSERT_TRUE(out != NULL);
+
+        if (!log_writer::start (out, 2)) return;
+
+        // repeats take no room in the queue
+        const u_int32 REPEATS = 100000;
+        for (u_int32 i = 0; i <= REPEATS; i++)
+        {
+            log_writer::write ("flood");
+        }
+        log_writer::write ("after");
+
+        log_writer::stop ();
+        EXPECT_EQ(0, log_writer::dropped ());
+
+        // the repeat count may be reported in several parts
+        std::string written = contents (out);
+        EXPECT_EQ(0u, written.find ("flood\n"));
+        EXPECT_EQ(written.length () - 6, written.find ("after\n"));
+
+        u_int32 repeats = 0, count;
+        for (std::string::size_type pos = 0; pos < written.length (); pos = written.find ('\n', pos) + 1)
+        {
+            if (sscanf (written.c_str () + pos, "*** last message repeated %u times", &count) == 1) repeats += count;
+        }
+        EXPECT_EQ(REPEATS, repeats);
+
+        fclose (out);
+    }
+
+    /// write distinct messages until the writer stops
+    static void log (const u_int32 t, std::atomic<u_int32> *accepted)
+    {
+        for (u_int32 i = 0; log_writer::write (std::to_string (t) + "-" + std::to_string (i)); i++)
+        {
+            (*accepted)++;
+        }
+    }
+
+    TEST(log_writer, stop_while_writing) {
+        FILE *out = tmpfile ();
+        ASSERT_TRUE(out != NULL);
+
+        if (!log_writer::start (out, 64)) return;
+
+        std::atomic<u_int32> accepted (0);
+        std::vector<std::thread> threads;
+        for (u_int32 t = 0; t < PRODUCERS; t++)
+        {
+            threads.push_back (std::thread (log, t, &accepted));
+        }
+
+        std::this_thread::sleep_for (std::chrono::milliseconds (50));
+        log_writer::stop ();
+
+        for (u_int32 t = 0; t < PRODUCERS; t++)
+        {
+            threads[t].join ();
+        }
+
+        // every accepted message has been written or counted as dropped
+        std::string written = contents (out);
+        u_int32 lines = 0;
+        for (std::string::size_type pos = 0; pos < written.length (); pos = written.find ('\n', pos) + 1)
+        {
+            if (written.compare (pos, 4, "*** ") != 0) lines++;
+        }
+
+        EXPECT_EQ(accepted, lines + log_writer::dropped ());
+
+        fclose (out);
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
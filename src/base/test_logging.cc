@@ -31,6 +31,7 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
 #include <string>
 
 namespace logging
@@ -80,6 +81,33 @@ namespace logging
         EXPECT_EQ(std::string(0 * LOG_INDENT_NUM_COLUMNS, ' '), indent());
     }
 
+    static int Evaluated = 0;
+
+    static int evaluate () {
+        return ++Evaluated;
+    }
+
+    TEST_F(logging_Test, field_Format) {
+        std::ostringstream out;
+        out << "move" << field ("vx", 1.5) << field ("dir", "n");
+        EXPECT_EQ("move vx=1.5 dir=n", out.str());
+    }
+
+    TEST_F(logging_Test, vlog_Disabled) {
+        ASSERT_FALSE(VLOG_IS_ON(5));
+
+        // arguments of disabled log statements are not evaluated
+        VLOG(5) << indent() << "value" << field ("x", evaluate ());
+        EXPECT_EQ(0, Evaluated);
+
+        // nor is indentation changed
+        {
+            vlog_indent scope (5);
+            EXPECT_EQ(std::string(0 * LOG_INDENT_NUM_COLUMNS, ' '), indent());
+        }
+        EXPECT_EQ(std::string(0 * LOG_INDENT_NUM_COLUMNS, ' '), indent());
+    }
+
 } // namespace{}
 
 
@@ -0,0 +1,225 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_record_cache.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for caching xml records.
+ *
+ *
+ */
+
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "diskio.h"
+#include "record_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace base
+{
+    class record_cache_Test : public ::testing::Test {
+
+    protected:
+        virtual void SetUp ()
+        {
+            Dir = "/tmp/test_record_cache/";
+            cleanup ();
+            mkdir (Dir.c_str (), 0700);
+            ASSERT_TRUE(record_cache::init (Dir + "cache"));
+        }
+
+        virtual void TearDown ()
+        {
+            record_cache::init ("");
+            cleanup ();
+        }
+
+        /**
+         * Write an xml record with the given number of fields.
+         */
+        void write (const std::string & filename, const u_int32 & count)
+        {
+            diskio record (diskio::XML_FILE);
+            for (u_int32 i = 0; i < count; i++)
+            {
+                record.put_uint32 ("field", i);
+            }
+            record.put_string ("name", filename);
+            ASSERT_TRUE(record.put_record (Dir + filename));
+        }
+
+        /**
+         * Remove the test directory.
+         */
+        void cleanup ()
+        {
+            const char *files[] = { "a.xml", "b.xml", "sub/c.xml", "config.xml", "sub", NULL };
+            for (u_int32 i = 0; files[i] != NULL; i++)
+            {
+                remove ((Dir + files[i]).c_str ());
+            }
+
+            std::string cache = Dir + "cache/";
+            DIR *dir = opendir (cache.c_str ());
+            if (dir != NULL)
+            {
+                struct dirent *dirent;
+                while ((dirent = readdir (dir)) != NULL)
+                {
+                    remove ((cache + dirent->d_name).c_str ());
+                }
+                closedir (dir);
+            }
+            rmdir (cache.c_str ());
+            rmdir (Dir.c_str ());
+        }
+
+        std::string Dir;
+    }; // class{}
+
+    TEST_F(record_cache_Test, get_and_put) {
+        write ("a.xml", 10);
+        const std::string path = Dir + "a.xml";
+
+        diskio xml (diskio::XML_FILE);
+        ASSERT_TRUE(xml.get_record (path));
+
+        flat record;
+        u_int32 misses = record_cache::misses ();
+        u_int32 hits = record_cache::hits ();
+
+        // diskio has cached the record already
+        ASSERT_TRUE(record_cache::get (path, record));
+        EXPECT_EQ(xml.checksum (), record.checksum ());
+        EXPECT_EQ(hits + 1, record_cache::hits ());
+        EXPECT_EQ(misses, record_cache::misses ());
+
+        // ... and loads it from there
+        diskio cached;
+        ASSERT_TRUE(cached.get_record (path));
+        EXPECT_EQ(xml.checksum (), cached.checksum ());
+        EXPECT_EQ("a.xml", cached.get_string ("name"));
+        EXPECT_EQ(hits + 2, record_cache::hits ());
+
+        // not in cache
+        flat other;
+        EXPECT_FALSE(record_cache::get (Dir + "b.xml", other));
+        EXPECT_EQ(misses + 1, record_cache::misses ());
+    }
+
+    TEST_F(record_cache_Test, outdated) {
+        write ("a.xml", 10);
+        const std::string path = Dir + "a.xml";
+
+        diskio xml;
+        ASSERT_TRUE(xml.get_record (path));
+
+        // changing the file invalidates the cached record
+        write ("a.xml", 20);
+        flat record;
+        EXPECT_FALSE(record_cache::get (path, record));
+
+        diskio changed;
+        ASSERT_TRUE(changed.get_record (path));
+        EXPECT_NE(xml.checksum (), changed.checksum ());
+
+        ASSERT_TRUE(record_cache::get (path, record));
+        EXPECT_EQ(changed.checksum (), record.checksum ());
+    }
+
+    TEST_F(record_cache_Test, same_size_and_time) {
+        write ("a.xml", 10);
+        const std::string path = Dir + "a.xml";
+
+        struct stat before;
+        ASSERT_EQ(0, stat (path.c_str (), &before));
+
+        diskio xml;
+        ASSERT_TRUE(xml.get_record (path));
+
+        // edit that keeps size and modification time of the file
+        diskio edited (diskio::XML_FILE);
+        for (u_int32 i = 0; i < 10; i++)
+        {
+            edited.put_uint32 ("field", 9 - i);
+        }
+        edited.put_string ("name", "a.xml");
+        ASSERT_TRUE(edited.put_record (path));
+
+        struct utimbuf times;
+        times.actime = before.st_atime;
+        times.modtime = before.st_mtime;
+        ASSERT_EQ(0, utime (path.c_str (), &times));
+
+        struct stat after;
+        ASSERT_EQ(0, stat (path.c_str (), &after));
+        ASSERT_EQ(before.st_size, after.st_size);
+
+        flat record;
+        EXPECT_FALSE(record_cache::get (path, record));
+
+        diskio changed;
+        ASSERT_TRUE(changed.get_record (path));
+        EXPECT_EQ(9u, changed.get_uint32 ("field"));
+    }
+
+    TEST_F(record_cache_Test, prebuild) {
+        mkdir ((Dir + "sub").c_str (), 0700);
+        write ("a.xml", 1);
+        write ("b.xml", 2);
+        write ("sub/c.xml", 3);
+
+        // not a record
+        FILE *file = fopen ((Dir + "config.xml").c_str (), "w");
+        fputs ("<Adonthell><Section/></Adonthell>\n", file);
+        fclose (file);
+
+        EXPECT_EQ(3u, record_cache::prebuild (Dir));
+
+        flat record;
+        EXPECT_TRUE(record_cache::get (Dir + "sub/c.xml", record));
+        EXPECT_EQ("sub/c.xml", record.get_string ("name"));
+        EXPECT_FALSE(record_cache::get (Dir + "config.xml", record));
+    }
+
+    TEST_F(record_cache_Test, disabled) {
+        write ("a.xml", 10);
+        record_cache::init ("");
+        EXPECT_FALSE(record_cache::enabled ());
+
+        u_int32 misses = record_cache::misses ();
+        diskio xml;
+        ASSERT_TRUE(xml.get_record (Dir + "a.xml"));
+        EXPECT_EQ(misses, record_cache::misses ());
+        EXPECT_EQ(0u, record_cache::prebuild (Dir));
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,65 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_state_name.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for the state_name class.
+ *
+ *
+ */
+
+#include "state_name.h"
+
+#include <gtest/gtest.h>
+
+namespace base
+{
+    TEST(state_name, ids) {
+        // empty name is always known
+        EXPECT_EQ(0, state_name::id (""));
+        EXPECT_EQ("", state_name::name (0));
+
+        u_int16 count = state_name::count ();
+        u_int16 walk = state_name::id ("w_walk");
+        u_int16 stand = state_name::id ("w_stand");
+
+        EXPECT_EQ(count, walk);
+        EXPECT_EQ(count + 1, stand);
+        EXPECT_EQ(count + 2, state_name::count ());
+
+        // same name, same id
+        EXPECT_EQ(walk, state_name::id (std::string ("w_") + "walk"));
+        EXPECT_EQ(count + 2, state_name::count ());
+
+        EXPECT_EQ("w_walk", state_name::name (walk));
+        EXPECT_EQ("w_stand", state_name::name (stand));
+
+        // unknown ids give empty name
+        EXPECT_EQ("", state_name::name (count + 2));
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_thread_pool.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for the thread_pool class.
+ *
+ *
+ */
+
+#include "thread_pool.h"
+
+#include <gtest/gtest.h>
+
+namespace base
+{
+    /// counts how often each item was processed
+    class counter
+    {
+    public:
+        counter (const u_int32 & count) : Count (count), Seen (new std::atomic<u_int32>[count]())
+        {
+        }
+
+        ~counter ()
+        {
+            delete[] Seen;
+        }
+
+        void process (u_int32 item)
+        {
+            Seen[item]++;
+        }
+
+        /// number of items not processed exactly once
+        u_int32 errors () const
+        {
+            u_int32 result = 0;
+            for (u_int32 i = 0; i < Count; i++)
+            {
+                if (Seen[i] != 1) result++;
+            }
+            return result;
+        }
+
+    private:
+        u_int32 Count;
+        std::atomic<u_int32> *Seen;
+    };
+
+    /// process count items on the given pool
+    static u_int32 run (thread_pool & pool, const u_int32 & count)
+    {
+        counter c (count);
+        base::functor_1<u_int32> *task = base::make_functor (c, &counter::process);
+        pool.run (count, *task);
+        delete task;
+
+        return c.errors ();
+    }
+
+    TEST(thread_pool, run) {
+        thread_pool pool;
+        EXPECT_EQ(0, run (pool, 100));
+
+        pool.resize (3);
+        EXPECT_EQ(3, pool.size ());
+        EXPECT_EQ(0, run (pool, 1));
+        EXPECT_EQ(0, run (pool, 2));
+        EXPECT_EQ(0, run (pool, 1000));
+    }
+
+    TEST(thread_pool, resize_after_run) {
+        thread_pool pool;
+        pool.resize (2);
+        for (u_int32 i = 0; i < 10; i++)
+        {
+            EXPECT_EQ(0, run (pool, 500));
+        }
+
+        // new workers must not pick up a task that already finished
+        pool.resize (4);
+        for (u_int32 i = 0; i < 10; i++)
+        {
+            EXPECT_EQ(0, run (pool, 500));
+        }
+
+        pool.resize (1);
+        EXPECT_EQ(0, run (pool, 500));
+        pool.resize (0);
+        EXPECT_EQ(0, run (pool, 500));
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
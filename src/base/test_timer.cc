@@ -0,0 +1,173 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_timer.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for the timer and telemetry classes.
+ *
+ *
+ */
+
+#include "base.h"
+#include "telemetry.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace base
+{
+    TEST(timer, variable_step) {
+        timer t;
+        t.set_slice (20);
+
+        // a quick frame waits for the rest of the slice
+        u_int32 start = timer::monotonic ();
+        t.update ();
+        EXPECT_GE(timer::monotonic () - start, 19000);
+        EXPECT_EQ(0, t.frames_missed ());
+        EXPECT_EQ(1, t.ticks ());
+
+        // a slow frame misses cycles
+        timer::sleep (50);
+        t.update ();
+        EXPECT_EQ(2, t.frames_missed ());
+        EXPECT_EQ(3, t.ticks ());
+        EXPECT_GE(t.frame_time (), 50000);
+    }
+
+    /**
+     * A timer whose frames take exactly as long as we say.
+     */
+    class frame_timer : public timer
+    {
+    public:
+        void frame (const u_int32 & msecs) { advance (msecs * 1000); }
+    };
+
+    TEST(timer, fixed_step) {
+        frame_timer t;
+        t.set_slice (20);
+        t.set_fixed_step (true, 4);
+        EXPECT_TRUE(t.fixed_step ());
+
+        // time not used up carries over to the next frame
+        t.frame (50);
+        EXPECT_EQ(2, t.ticks ());
+        EXPECT_EQ(1, t.frames_missed ());
+        EXPECT_FLOAT_EQ(0.5, t.alpha ());
+
+        t.frame (10);
+        EXPECT_EQ(1, t.ticks ());
+        EXPECT_FLOAT_EQ(0.0, t.alpha ());
+
+        // frames faster than the slice need not compute a cycle
+        t.frame (1);
+        EXPECT_EQ(0, t.ticks ());
+        EXPECT_FLOAT_EQ(0.05, t.alpha ());
+
+        // a very slow frame does not lead to an endless catch up
+        t.frame (200);
+        EXPECT_EQ(4, t.ticks ());
+        EXPECT_FLOAT_EQ(0.05, t.alpha ());
+    }
+
+    TEST(timer, fixed_step_update) {
+        timer t;
+        t.set_slice (20);
+        t.set_fixed_step (true, 4);
+        t.set_frame_rate (1000);
+
+        // update waits for the frame rate
+        t.synch ();
+        t.update ();
+        EXPECT_GE(t.frame_time (), 1000);
+        EXPECT_LT(t.alpha (), 1.0);
+    }
+
+    TEST(telemetry, percentiles) {
+        telemetry::reset ();
+        EXPECT_EQ(0, telemetry::frames ());
+        EXPECT_EQ(0, telemetry::percentile (telemetry::RENDER, 50));
+
+        // render times 100 .. 1, world time added twice per frame
+        for (u_int32 i = 100; i > 0; i--)
+        {
+            telemetry::add (telemetry::RENDER, i);
+            telemetry::add (telemetry::WORLD, 1);
+            telemetry::add (telemetry::WORLD, 2);
+            telemetry::next_frame (i * 10);
+        }
+
+        EXPECT_EQ(100, telemetry::frames ());
+        EXPECT_EQ(50, telemetry::percentile (telemetry::RENDER, 50));
+        EXPECT_EQ(95, telemetry::percentile (telemetry::RENDER, 95));
+        EXPECT_EQ(100, telemetry::percentile (telemetry::RENDER, 100));
+        EXPECT_EQ(1, telemetry::percentile (telemetry::RENDER, 1));
+        EXPECT_EQ(3, telemetry::percentile (telemetry::WORLD, 99));
+        EXPECT_EQ(990, telemetry::percentile (telemetry::FRAME, 99));
+        EXPECT_EQ(0, telemetry::percentile (telemetry::INPUT, 100));
+
+        // only the most recent frames are kept
+        for (u_int32 i = 0; i < telemetry::WINDOW; i++)
+        {
+            telemetry::add (telemetry::RENDER, 7);
+            telemetry::next_frame (0);
+        }
+        EXPECT_EQ(telemetry::WINDOW, telemetry::frames ());
+        EXPECT_EQ(7, telemetry::percentile (telemetry::RENDER, 100));
+
+        std::ostringstream out;
+        telemetry::dump (out);
+        EXPECT_NE(std::string::npos, out.str ().find ("pathfinding"));
+    }
+
+    TEST(telemetry, engine_timer_only) {
+        telemetry::reset ();
+
+        // timers used for measuring do not complete frames
+        timer t;
+        t.set_slice (1);
+        t.update ();
+        EXPECT_EQ(0, telemetry::frames ());
+
+        Timer.set_slice (1);
+        Timer.update ();
+        EXPECT_EQ(1, telemetry::frames ());
+    }
+
+    TEST(telemetry, scope) {
+        telemetry::reset ();
+        {
+            telemetry::scope measure (telemetry::PRESENT);
+            timer::sleep (5);
+        }
+        telemetry::next_frame (0);
+        EXPECT_GE(telemetry::percentile (telemetry::PRESENT, 50), 5000);
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/test_trace.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for the trace class.
+ *
+ *
+ */
+
+#include "trace.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace base
+{
+    /// count occurrences of text in str
+    static u_int32 count (const std::string & str, const std::string & text)
+    {
+        u_int32 result = 0;
+        for (std::string::size_type pos = str.find (text); pos != std::string::npos; pos = str.find (text, pos + 1))
+        {
+            result++;
+        }
+        return result;
+    }
+
+    /// record zones on a thread of its own
+    static void worker ()
+    {
+        trace::zone zone ("worker");
+    }
+
+    TEST(trace, disabled) {
+        EXPECT_FALSE(trace::is_enabled ());
+        {
+            trace::zone zone ("ignored");
+        }
+
+        std::ostringstream out;
+        trace::dump (out);
+        EXPECT_EQ(0, count (out.str (), "ignored"));
+    }
+
+    TEST(trace, zones) {
+        trace::enable ("");
+        EXPECT_TRUE(trace::is_enabled ());
+        {
+            trace::zone outer ("outer");
+            {
+                trace::zone inner (trace::intern (std::string ("in") + "ner \"quoted\""));
+                timer::sleep (2);
+            }
+        }
+
+        std::thread thread (worker);
+        thread.join ();
+        trace::disable ();
+
+        // zones after disabling are ignored
+        {
+            trace::zone zone ("outer");
+        }
+
+        std::ostringstream out;
+        trace::dump (out);
+        std::string json = out.str ();
+
+        EXPECT_EQ(0, json.find ("{\"traceEvents\": ["));
+        EXPECT_EQ(1, count (json, "\"outer\""));
+        EXPECT_EQ(1, count (json, "\"inner \\\"quoted\\\"\""));
+        EXPECT_EQ(1, count (json, "\"worker\""));
+        EXPECT_EQ(2, count (json, "thread_name"));
+        EXPECT_EQ(1, count (json, "\"tid\": 1, \"ts\""));
+
+        // nothing is kept from before tracing was enabled
+        trace::enable ("");
+        trace::disable ();
+        out.str ("");
+        trace::dump (out);
+        EXPECT_EQ(0, count (out.str (), "\"outer\""));
+    }
+
+    TEST(trace, long_sessions) {
+        trace::enable ("");
+        const u_int64 start = timer::timestamp ();
+
+        // zones recorded long after tracing has been enabled
+        trace::add ("later", start + 40 * 60 * 1000000ull, 5);
+        trace::add ("much_later", start + 100 * 60 * 1000000ull, 5);
+        trace::disable ();
+
+        std::ostringstream out;
+        trace::dump (out);
+        EXPECT_EQ(1, count (out.str (), "\"later\""));
+        EXPECT_EQ(1, count (out.str (), "\"much_later\""));
+        EXPECT_EQ(1, count (out.str (), "\"ts\": 60000"));
+    }
+
+    TEST(trace, ring_buffer) {
+        trace::enable ("");
+        for (u_int32 i = 0; i < trace::BUFFER_SIZE; i++)
+        {
+            trace::add ("old", timer::timestamp (), 0);
+        }
+        trace::add ("new", timer::timestamp (), 0);
+        trace::disable ();
+
+        // the oldest zone has been replaced
+        std::ostringstream out;
+        trace::dump (out);
+        EXPECT_EQ(trace::BUFFER_SIZE - 1, count (out.str (), "\"old\""));
+        EXPECT_EQ(1, count (out.str (), "\"new\""));
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
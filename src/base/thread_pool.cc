@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file   base/thread_pool.cc
+ * @author agent <agent@local>
+ *
+ * @brief  A pool of worker threads for data parallel tasks.
+ *
+ *
+ */
+
+#include "thread_pool.h"
+
+using base::thread_pool;
+
+// ctor
+thread_pool::thread_pool () : Ranges (new range[1]()), Task (NULL), Generation (0), Busy (0), Quit (false)
+{
+}
+
+// dtor
+thread_pool::~thread_pool ()
+{
+    resize (0);
+    delete[] Ranges;
+}
+
+// start or stop worker threads
+void thread_pool::resize (const u_int32 & workers)
+{
+    if (workers == Workers.size ()) return;
+
+    // stop existing workers
+    if (!Workers.empty ())
+    {
+        {
+            std::lock_guard<std::mutex> lock (Mutex);
+            Quit = true;
+        }
+        Wake.notify_all ();
+
+        for (std::vector<std::thread>::iterator i = Workers.begin (); i != Workers.end (); i++)
+        {
+            i->join ();
+        }
+
+        Workers.clear ();
+        Quit = false;
+    }
+
+    delete[] Ranges;
+    Ranges = new range[workers + 1]();
+
+    // start new workers, the caller using the first range. They must
+    // only pick up tasks started after this point.
+    for (u_int32 i = 1; i <= workers; i++)
+    {
+        Workers.push_back (std::thread (&thread_pool::work, this, i, Generation));
+    }
+}
+
+// process all work items
+void thread_pool::run (const u_int32 & count, const base::functor_1<u_int32> & task)
+{
+    if (count == 0) return;
+
+    // nothing to distribute
+    if (Workers.empty () || count == 1)
+    {
+        for (u_int32 i = 0; i < count; i++)
+        {
+            task (i);
+        }
+        return;
+    }
+
+    // split items evenly between threads
+    const u_int32 threads = Workers.size () + 1;
+    const u_int32 share = count / threads;
+    const u_int32 extra = count % threads;
+    for (u_int32 i = 0, start = 0; i < threads; i++)
+    {
+        Ranges[i].Next.store (start, std::memory_order_relaxed);
+        start += share + (i < extra ? 1 : 0);
+        Ranges[i].End = start;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (Mutex);
+        Task = &task;
+        Busy = Workers.size ();
+        Generation++;
+    }
+    Wake.notify_all ();
+
+    // take part in the work ...
+    drain (0);
+
+    // ... and wait for the others to finish
+    std::unique_lock<std::mutex> lock (Mutex);
+    while (Busy > 0)
+    {
+        Done.wait (lock);
+    }
+    Task = NULL;
+}
+
+// worker thread
+void thread_pool::work (const u_int32 id, u_int32 seen)
+{
+    std::unique_lock<std::mutex> lock (Mutex);
+    while (true)
+    {
+        while (!Quit && Generation == seen)
+        {
+            Wake.wait (lock);
+        }
+
+        if (Quit) break;
+        seen = Generation;
+
+        lock.unlock ();
+        drain (id);
+        lock.lock ();
+
+        if (--Busy == 0)
+        {
+            Done.notify_one ();
+        }
+    }
+}
+
+// process work items
+void thread_pool::drain (const u_int32 & id)
+{
+    const u_int32 threads = Workers.size () + 1;
+
+    // start with own items, then help out the others
+    for (u_int32 i = 0; i < threads; i++)
+    {
+        range & r = Ranges[(id + i) % threads];
+
+        u_int32 item = r.Next.fetch_add (1, std::memory_order_relaxed);
+        while (item < r.End)
+        {
+            (*Task) (item);
+            item = r.Next.fetch_add (1, std::memory_order_relaxed);
+        }
+    }
+}
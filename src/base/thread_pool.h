@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2026 agent <agent@local>
+ Part of the Adonthell Project http://adonthell.linuxgames.com
+
+ Adonthell is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ Adonthell is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Adonthell; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file   base/thread_pool.h
+ * @author agent <agent@local>
+ *
+ * @brief  A pool of worker threads for data parallel tasks.
+ *
+ *
+ */
+
+#ifndef BASE_THREAD_POOL_H
+#define BASE_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "types.h"
+#include "callback.h"
+
+namespace base
+{
+    /**
+     * A fixed set of worker threads that process a number of independent
+     * work items in parallel. The calling thread takes part in the work,
+     * so a pool without workers simply processes all items in order.
+     *
+     * Items are split evenly between the participating threads. Threads
+     * that finish early steal the remaining items of the others, so an
+     * uneven amount of work per item will still keep all threads busy.
+     *
+     * Tasks must not touch any shared state that is modified by other
+     * items. In particular, they must not call into Python.
+     */
+    class thread_pool
+    {
+    public:
+        /**
+         * Create a pool without worker threads.
+         */
+        thread_pool ();
+
+        /**
+         * Stop and join all worker threads.
+         */
+        ~thread_pool ();
+
+        /**
+         * Set the number of background worker threads. Must not be
+         * called while run() is in progress.
+         * @param workers number of threads in addition to the caller.
+         */
+        void resize (const u_int32 & workers);
+
+        /**
+         * Return number of background worker threads.
+         * @return number of threads in addition to the caller.
+         */
+        u_int32 size () const
+        {
+            return Workers.size ();
+        }
+
+        /**
+         * Call the given task once for every index in [0, count) and
+         * return once all items are processed. The order in which
+         * items are processed is unspecified.
+         * @param count number of work items.
+         * @param task callback receiving the index of the work item.
+         */
+        void run (const u_int32 & count, const base::functor_1<u_int32> & task);
+
+    private:
+        /// forbid copying
+        thread_pool (const thread_pool & p);
+
+        /// work items assigned to one thread
+        struct range
+        {
+            /// next item to process
+            std::atomic<u_int32> Next;
+            /// one past the last item
+            u_int32 End;
+            /// keep ranges of different threads on separate cache lines
+            char Padding[64 - sizeof (std::atomic<u_int32>) - sizeof (u_int32)];
+        };
+
+        /**
+         * Main loop of a worker thread.
+         * @param id index of the worker's range.
+         * @param seen the last task started before the worker.
+         */
+        void work (const u_int32 id, u_int32 seen);
+
+        /**
+         * Process own range first, then steal from the others.
+         * @param id index of the thread's own range.
+         */
+        void drain (const u_int32 & id);
+
+        /// background threads
+        std::vector<std::thread> Workers;
+        /// work items of each thread, caller first
+        range *Ranges;
+        /// the task currently being run
+        const base::functor_1<u_int32> *Task;
+
+        /// guards the members below
+        std::mutex Mutex;
+        /// signals workers that a new task is available
+        std::condition_variable Wake;
+        /// signals the caller that all workers are done
+        std::condition_variable Done;
+        /// incremented for each task
+        u_int32 Generation;
+        /// number of workers still processing the current task
+        u_int32 Busy;
+        /// whether workers should terminate
+        bool Quit;
+    };
+}
+
+#endif
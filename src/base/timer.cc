@@ -30,7 +30,12 @@
 #endif
 #include <errno.h>
 
+#include <sys/time.h>
+
+#include "base.h"
 #include "timer.h"
+#include "telemetry.h"
+#include "trace.h"
 
 // some OS don't have nanosleep
 #ifndef HAVE_NANOSLEEP
@@ -63,9 +68,11 @@ int nanosleep (const struct timespec *req, struct timespec *rem)
 namespace base
 {
     // ctor
-    timer::timer() : Slice(25), Lasttime(0), FramesMissed(0)
+    timer::timer() : Slice(25), Lasttime(0), FramesMissed(0), Ticks(1), Accumulator(0),
+        FrameTime(0), FixedStep(false), MaxTicks(5), FrameRate(0)
     {
-        gettimeofday (&InitialTime, NULL);
+        get_time (InitialSecs, InitialUsecs);
+        LastFrame = timestamp ();
     }
 
     // set duration of one game cycle in ms
@@ -74,21 +81,74 @@ namespace base
         Slice = sl;
     }
 
+    // decouple game cycles from frames
+    void timer::set_fixed_step (const bool & fixed, const u_int32 & max_ticks)
+    {
+        FixedStep = fixed;
+        MaxTicks = max_ticks > 0 ? max_ticks : 1;
+        Accumulator = 0;
+        Ticks = 1;
+    }
+
+    // limit frames per second in fixed step mode
+    void timer::set_frame_rate (const u_int32 & fps)
+    {
+        FrameRate = fps;
+    }
+
     // return time passed since creation of timer 
     u_int32 timer::current_time() const
     {
+        u_int32 secs, usecs;
+        get_time (secs, usecs);
+        return (secs - InitialSecs) * 1000 + usecs / 1000 - InitialUsecs / 1000;
+    }
+
+    // read monotonic clock
+    void timer::get_time (u_int32 & secs, u_int32 & usecs)
+    {
+#ifdef CLOCK_MONOTONIC
+        struct timespec ts;
+        clock_gettime (CLOCK_MONOTONIC, &ts);
+        secs = ts.tv_sec;
+        usecs = ts.tv_nsec / 1000;
+#else
         struct timeval tv;
-        gettimeofday(&tv, NULL);
-        return convert_timeval(tv);
+        gettimeofday (&tv, NULL);
+        secs = tv.tv_sec;
+        usecs = tv.tv_usec;
+#endif
+    }
+
+    // current time in microseconds
+    u_int32 timer::monotonic ()
+    {
+        u_int32 secs, usecs;
+        get_time (secs, usecs);
+        return secs * 1000000 + usecs;
+    }
+
+    // current time in microseconds, without wrapping around
+    u_int64 timer::timestamp ()
+    {
+        u_int32 secs, usecs;
+        get_time (secs, usecs);
+        return (u_int64) secs * 1000000 + usecs;
     }
 
     // suspend application for given time
     void timer::sleep (u_int32 msecs)
+    {
+        sleep_usecs (msecs * 1000);
+    }
+
+    // suspend application for given time
+    void timer::sleep_usecs (u_int32 usecs)
     {
         unsigned char err;
         struct timespec req, rem;
-        rem.tv_sec = msecs / 1000;
-        rem.tv_nsec = (msecs % 1000) * 1000000;
+        rem.tv_sec = usecs / 1000000;
+        rem.tv_nsec = (usecs % 1000000) * 1000;
 
         do
         {
@@ -101,22 +161,70 @@ namespace base
     void timer::synch ()
     {
         Lasttime = current_time ();
+        LastFrame = timestamp ();
+        Accumulator = 0;
     }
 
     // wait until current game cycle is over
     void timer::update ()
     {
-        register u_int16 delay = current_time () - Lasttime;
+        const u_int32 slice = Slice * 1000;
+        u_int32 delay = timestamp () - LastFrame;
+
+        // only the engine's timer measures frames
+        const bool engine = this == &base::Timer;
+        if (engine) telemetry::next_frame (delay);
 
-        // wait if the current frame was calculated too fast
-        if (Slice > delay) {
-            sleep (Slice - delay);
-            delay = current_time () - Lasttime;
-            FramesMissed = 0;
+        if (!FixedStep)
+        {
+            // wait if the current frame was calculated too fast
+            if (slice > delay) {
+                sleep_usecs (slice - delay);
+                FramesMissed = 0;
+            }
+            // see whether calculating the current frame took too long
+            else FramesMissed = delay / slice;
+
+            Ticks = 1 + FramesMissed;
+        }
+        else
+        {
+            // wait if frame rate is limited
+            u_int32 min_frame = FrameRate > 0 ? 1000000 / FrameRate : slice;
+            if (min_frame > delay)
+            {
+                sleep_usecs (min_frame - delay);
+            }
         }
-        // see whether calculating the current frame took too long
-        else FramesMissed = delay / Slice;
-        
-        Lasttime += delay;
+
+        u_int64 now = timestamp ();
+        if (engine) trace::add ("frame", LastFrame, now - LastFrame);
+        FrameTime = now - LastFrame;
+        LastFrame = now;
+        Lasttime = current_time ();
+
+        if (FixedStep) advance (FrameTime);
+    }
+
+    // accumulate real time into game cycles
+    void timer::advance (const u_int32 & elapsed)
+    {
+        const u_int32 slice = Slice * 1000;
+
+        Accumulator += elapsed;
+        Ticks = Accumulator / slice;
+
+        // slow down rather than spending ever more time catching up
+        if (Ticks > MaxTicks)
+        {
+            Ticks = MaxTicks;
+            Accumulator = Accumulator % slice;
+        }
+        else
+        {
+            Accumulator -= Ticks * slice;
+        }
+
+        FramesMissed = Ticks > 1 ? Ticks - 1 : 0;
     }
 }
@@ -27,7 +27,6 @@
 #define BASE_TIMER_INCLUDED
 
 #include <iostream>
-#include <sys/time.h>
 #include <time.h>
 
 #include "types.h"
@@ -44,6 +43,26 @@ namespace base
      * For that second purpose, a global timer instance exists that should
      * be used: base::Timer. For simple time measuring, new objects should
      * be instantiated.
+     *
+     * By default, each call to update() completes one game cycle, waiting
+     * for the remainder of the slice if necessary. In fixed step mode, the
+     * rate of game cycles (ticks) is decoupled from the frame rate instead:
+     * real time is accumulated and update() reports how many ticks are due
+     * for the next frame, which may be none at all if frames are rendered
+     * faster than the game is updated. A main loop then looks like this:
+     *
+     * \code
+     * for (u_int32 i = 0; i < base::Timer.ticks (); i++)
+     *     // update game state
+     * events::date::update (); // advances by all ticks at once
+     * // render, interpolating by base::Timer.alpha ()
+     * base::Timer.update ();
+     * \endcode
+     *
+     * Only updating base::Timer completes a frame of the engine's
+     * base::telemetry and base::trace.
+     *
+     * All time is measured with a monotonic clock in microseconds.
      */
     class timer
     {
@@ -74,6 +93,28 @@ namespace base
          * @return number of cycles skipped.
          */
         u_int32 frames_missed () const { return FramesMissed; }
+
+        /**
+         * Return the number of game cycles to compute before the next
+         * frame is rendered. Outside fixed step mode, this is always
+         * 1 + frames_missed().
+         * @return number of game cycles due.
+         */
+        u_int32 ticks () const { return Ticks; }
+
+        /**
+         * Return how far the game has progressed towards the next game
+         * cycle, for interpolating between the last and the next state
+         * when rendering. Always 0 outside fixed step mode.
+         * @return fraction of a slice between 0 and 1.
+         */
+        float alpha () const { return (float) Accumulator / (Slice * 1000); }
+
+        /**
+         * Return the real time between the last two calls to update().
+         * @return duration of the last frame in microseconds.
+         */
+        u_int32 frame_time () const { return FrameTime; }
         
         /**
          * Return time elapsed since creation of the counter.
@@ -92,6 +133,30 @@ namespace base
          */
         void set_slice (u_int32 sl);
 
+        /**
+         * Switch fixed step mode on or off. See the class description
+         * for details.
+         * @param fixed whether to decouple game cycles from frames.
+         * @param max_ticks maximum number of game cycles per frame. If
+         *      more are due, the game slows down instead, so that a slow
+         *      frame does not lead to even slower frames.
+         */
+        void set_fixed_step (const bool & fixed, const u_int32 & max_ticks = 5);
+
+        /**
+         * Return whether game cycles are decoupled from frames.
+         * @return \b true in fixed step mode.
+         */
+        bool fixed_step () const { return FixedStep; }
+
+        /**
+         * Limit the number of frames per second in fixed step mode. If a
+         * frame is completed early, update() waits for the remainder.
+         * @param fps maximum frames per second, or 0 for one frame per
+         *      game cycle, which is the default.
+         */
+        void set_frame_rate (const u_int32 & fps);
+
         /**
          * Synchronize the timer with the current time. This can be used
          * after lengthy operations such as loading or saving that
@@ -105,7 +170,8 @@ namespace base
          * Call this after a cycle of the game has been completed.
          * It will either delay until the slice is completely done
          * or calculate the number of cycles that have been skipped
-         * since the last call.
+         * since the last call. In fixed step mode, it calculates the
+         * number of cycles due for the next frame instead.
          */
         void update ();
 
@@ -115,24 +181,67 @@ namespace base
          */
         static void sleep (u_int32 msecs);
 
+        /**
+         * Return the time of a monotonic clock in microseconds. The
+         * value wraps around after about 71 minutes, so it is only
+         * useful for measuring the difference between two calls.
+         * @return current time in microseconds.
+         */
+        static u_int32 monotonic ();
+
+        /**
+         * Return the time of a monotonic clock in microseconds, as a
+         * 64 bit value that does not wrap around while the game runs.
+         * @return current time in microseconds.
+         */
+        static u_int64 timestamp ();
+
+    protected:
+        /**
+         * Add real time to the accumulator in fixed step mode and
+         * compute the number of game cycles due.
+         * @param elapsed real time passed in microseconds.
+         */
+        void advance (const u_int32 & elapsed);
+
     private:
         /**
-         * Calculate difference between given time and creation
-         * time of the timer in milliseconds.
-         * @param tv a timestamp
-         * @return difference between timestamp and creation time.
+         * suspend program for a certain number of microseconds.
+         * @param usecs amount of time to wait.
+         */
+        static void sleep_usecs (u_int32 usecs);
+
+        /**
+         * Read the monotonic clock.
+         * @param secs receives the seconds.
+         * @param usecs receives the fraction of a second in microseconds.
          */
-        u_int32 convert_timeval (const struct timeval & tv) const
-        { return ((tv.tv_sec - InitialTime.tv_sec) * 1000 + (tv.tv_usec - InitialTime.tv_usec) / 1000); }
+        static void get_time (u_int32 & secs, u_int32 & usecs);
 
-        /// creation time of the %timer
-        struct timeval InitialTime;
+        /// creation time of the %timer, seconds
+        u_int32 InitialSecs;
+        /// creation time of the %timer, fraction of a second in microseconds
+        u_int32 InitialUsecs;
+        /// time of the last call to update (), in microseconds
+        u_int64 LastFrame;
         /// length of a game cycle in milliseconds
         u_int32 Slice;
         /// amount of time this timer is running (in milliseconds)
         u_int32 Lasttime;
         /// number of cycles that had to be skipped
         u_int32 FramesMissed;
+        /// number of cycles due for the next frame
+        u_int32 Ticks;
+        /// real time not yet used up by game cycles, in microseconds
+        u_int32 Accumulator;
+        /// duration of the last frame in microseconds
+        u_int32 FrameTime;
+        /// whether game cycles are decoupled from frames
+        bool FixedStep;
+        /// maximum number of game cycles per frame in fixed step mode
+        u_int32 MaxTicks;
+        /// maximum frames per second in fixed step mode
+        u_int32 FrameRate;
     };
 }
 
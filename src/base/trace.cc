@@ -0,0 +1,200 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/trace.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Implements the recorder of timed zones within frames.
+ *
+ *
+ */
+
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "trace.h"
+#include "logging.h"
+
+using base::trace;
+
+namespace
+{
+    /// a recorded zone
+    struct event
+    {
+        /// name of the zone
+        const char *Name;
+        /// when the zone was entered
+        u_int64 Start;
+        /// time spent in the zone
+        u_int32 Duration;
+    };
+
+    /// the zones recorded by one thread
+    struct buffer
+    {
+        buffer (const u_int32 & id) : Id (id), Next (0), Count (0) { }
+
+        /// number of the thread in the trace
+        u_int32 Id;
+        /// slot of the next zone
+        u_int32 Next;
+        /// number of zones recorded
+        u_int32 Count;
+        /// the zones, oldest at Next once the buffer is full
+        event Events[trace::BUFFER_SIZE];
+    };
+
+    /// guards the members below
+    std::mutex Mutex;
+    /// the buffers of all threads that recorded zones
+    std::vector<buffer*> Buffers;
+    /// names created with trace::intern
+    std::set<std::string> Names;
+
+    /// the buffer of the current thread
+    thread_local buffer *ThreadBuffer = NULL;
+
+    /// write string as JSON
+    void quote (std::ostream & out, const char *str)
+    {
+        out << '"';
+        for (const char *c = str; *c; c++)
+        {
+            if (*c == '"' || *c == '\\') out << '\\' << *c;
+            else if ((unsigned char) *c < 0x20) out << ' ';
+            else out << *c;
+        }
+        out << '"';
+    }
+}
+
+// trace state
+const u_int32 trace::BUFFER_SIZE;
+std::atomic<bool> trace::Enabled (false);
+std::string trace::File;
+u_int64 trace::Start = 0;
+
+// start recording
+void trace::enable (const std::string & file)
+{
+    std::lock_guard<std::mutex> lock (Mutex);
+    for (std::vector<buffer*>::iterator i = Buffers.begin (); i != Buffers.end (); i++)
+    {
+        (*i)->Next = 0;
+        (*i)->Count = 0;
+    }
+
+    File = file;
+    Start = timer::timestamp ();
+    Enabled = true;
+
+    LOG(INFO) << "Tracing enabled, writing to '" << File << "'";
+}
+
+// stop recording
+void trace::disable ()
+{
+    Enabled = false;
+}
+
+// record zone
+void trace::add (const char *name, const u_int64 & start, const u_int32 & duration)
+{
+    if (!is_enabled ()) return;
+
+    buffer *buf = ThreadBuffer;
+    if (buf == NULL)
+    {
+        std::lock_guard<std::mutex> lock (Mutex);
+        buf = new buffer (Buffers.size ());
+        Buffers.push_back (buf);
+        ThreadBuffer = buf;
+    }
+
+    event & e = buf->Events[buf->Next];
+    e.Name = name;
+    e.Start = start;
+    e.Duration = duration;
+
+    buf->Next = (buf->Next + 1) % BUFFER_SIZE;
+    if (buf->Count < BUFFER_SIZE) buf->Count++;
+}
+
+// keep a copy of name
+const char *trace::intern (const std::string & name)
+{
+    std::lock_guard<std::mutex> lock (Mutex);
+    return Names.insert (name).first->c_str ();
+}
+
+// write zones to default file
+bool trace::dump ()
+{
+    if (File.empty ()) return false;
+
+    std::ofstream out (File.c_str ());
+    if (!out)
+    {
+        LOG(ERROR) << "trace::dump: cannot write '" << File << "'";
+        return false;
+    }
+
+    dump (out);
+    return true;
+}
+
+// write zones in trace event format
+void trace::dump (std::ostream & out)
+{
+    std::lock_guard<std::mutex> lock (Mutex);
+
+    out << "{\"traceEvents\": [";
+    bool first = true;
+
+    for (std::vector<buffer*>::const_iterator i = Buffers.begin (); i != Buffers.end (); i++)
+    {
+        const buffer *buf = *i;
+
+        out << (first ? "\n" : ",\n");
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buf->Id
+            << ", \"args\": {\"name\": \"thread " << buf->Id << "\"}}";
+        first = false;
+
+        u_int32 oldest = buf->Count < BUFFER_SIZE ? 0 : buf->Next;
+        for (u_int32 j = 0; j < buf->Count; j++)
+        {
+            const event & e = buf->Events[(oldest + j) % BUFFER_SIZE];
+
+            // entered before tracing was enabled
+            if (e.Start < Start) continue;
+
+            out << ",\n{\"name\": ";
+            quote (out, e.Name);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buf->Id
+                << ", \"ts\": " << e.Start - Start
+                << ", \"dur\": " << e.Duration << "}";
+        }
+    }
+
+    out << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
@@ -0,0 +1,164 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   base/trace.h
+ * @author agent <agent@local>
+ *
+ * @brief  Declares the recorder of timed zones within frames.
+ *
+ *
+ */
+
+#ifndef BASE_TRACE_H
+#define BASE_TRACE_H
+
+#include <atomic>
+#include <ostream>
+#include <string>
+
+#include "timer.h"
+
+namespace base
+{
+    /**
+     * Records when the engine enters and leaves zones of interest, such
+     * as updating the map or calling a Python method, to show where the
+     * time of a frame goes. Each thread records into a ring buffer of
+     * its own, which keeps the last BUFFER_SIZE zones, so recording can
+     * stay enabled for as long as the game runs.
+     *
+     * The recorded zones can be written in the trace event format read
+     * by Chrome's about:tracing and similar viewers, which show them as
+     * nested bars per thread on a common timeline.
+     *
+     * Tracing is enabled with the -t command line switch of the engine.
+     * When disabled, the cost of a zone is a single check.
+     */
+    class trace
+    {
+    public:
+        /// number of zones kept per thread
+        static const u_int32 BUFFER_SIZE = 32768;
+
+        /**
+         * Drop zones recorded so far and start recording.
+         * @param file the file written by dump() when no other
+         *      destination is given.
+         */
+        static void enable (const std::string & file);
+
+        /**
+         * Stop recording. Zones recorded so far are kept.
+         */
+        static void disable ();
+
+        /**
+         * Return whether zones are recorded.
+         * @return \b true if tracing is enabled.
+         */
+        static bool is_enabled ()
+        {
+            return Enabled.load (std::memory_order_relaxed);
+        }
+
+        /**
+         * Write recorded zones to the file given to enable().
+         * @return \b false if the file could not be written.
+         */
+        static bool dump ();
+
+        /**
+         * Write recorded zones in trace event format, i.e. as a JSON
+         * object holding a "traceEvents" list. Zones still being
+         * recorded by other threads may be missing or incomplete.
+         * @param out stream to write data to.
+         */
+        static void dump (std::ostream & out);
+
+        /**
+         * Return a copy of the given name that lives until the program
+         * exits, for naming zones with strings built at runtime.
+         * @param name a zone name.
+         * @return the same name for as long as the program runs.
+         */
+        static const char *intern (const std::string & name);
+
+#ifndef SWIG
+        /**
+         * Record a zone of the current thread.
+         * @param name name of the zone. Must remain valid until the
+         *      program exits, so use string literals or intern().
+         * @param start time the zone was entered, as returned by
+         *      base::timer::timestamp().
+         * @param duration time spent in the zone in microseconds.
+         */
+        static void add (const char *name, const u_int64 & start, const u_int32 & duration);
+
+        /**
+         * Record a zone for the lifetime of this object.
+         */
+        class zone
+        {
+        public:
+            /**
+             * Enter a zone.
+             * @param name name of the zone. Must remain valid until the
+             *      program exits, so use string literals or intern().
+             */
+            zone (const char *name) : Name (is_enabled () ? name : NULL)
+            {
+                if (Name) Start = timer::timestamp ();
+            }
+
+            /**
+             * Leave the zone.
+             */
+            ~zone ()
+            {
+                if (Name) add (Name, Start, timer::timestamp () - Start);
+            }
+
+        private:
+            /// forbid copying
+            zone (const zone & z);
+
+            /// name of the zone, or NULL if not recording
+            const char *Name;
+            /// when the zone was entered
+            u_int64 Start;
+        };
+#endif // SWIG
+
+    private:
+        /// forbid instantiation
+        trace ();
+
+#ifndef SWIG
+        /// whether zones are recorded
+        static std::atomic<bool> Enabled;
+#endif
+        /// default destination of dump ()
+        static std::string File;
+        /// time tracing was enabled
+        static u_int64 Start;
+    };
+}
+
+#endif // BASE_TRACE_H
@@ -31,6 +31,8 @@
 #include "time_event.h"
 #include <adonthell/base/base.h>
 #include <adonthell/base/diskio.h>
+#include <adonthell/base/telemetry.h>
+#include <adonthell/base/trace.h>
 
 /// filename of time data file
 #define TIME_DATA "time.data"
@@ -57,9 +59,12 @@ double date::Ticks = INITVAL_TICKS;
 // Increase gametime 
 void date::update ()
 {
-    // frames_missed contains the number of cycles that have been
-    // skipped during the last call to date::update
-    Ticks += 1 + base::Timer.frames_missed ();
+    base::telemetry::scope measure (base::telemetry::EVENTS);
+    base::trace::zone zone ("date::update");
+
+    // we are called once per frame, so add all game cycles computed
+    // for this frame, including those that have been skipped
+    Ticks += base::Timer.ticks ();
 
     // check whether to trigger time events
     while (Ticks >= Scale)
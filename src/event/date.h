@@ -55,7 +55,9 @@ public:
 
     /**
      * Update the %game date. Whenever a minute of %gametime has
-     * passed, a time event will be raised.
+     * passed, a time event will be raised. Must be called once
+     * per frame, not once per game cycle, as the date advances
+     * by all cycles due for the frame, i.e. base::timer::ticks().
      */
     static void update ();
 
@@ -136,6 +136,18 @@ namespace events
         {
             if (Repeat > 0) Repeat--;
         }
+
+        /**
+         * Create a copy of this %event, so that it can be queued by an
+         * %event %manager for deferred dispatch. Event types that cannot
+         * be copied return \c NULL and will always be raised immediately.
+         *
+         * @return a new copy of this %event, or \c NULL.
+         */
+        virtual event *clone () const
+        {
+            return NULL;
+        }
 #endif // SWIG
 
         /**
@@ -75,6 +75,19 @@ void listener::resume ()
     }
 }
 
+// execute callback for each event of the given batch
+s_int32 listener::raise_events (const std::vector<const event*> & evnts)
+{
+    s_int32 repeat = Event->repeat ();
+
+    for (std::vector<const event*>::const_iterator i = evnts.begin (); i != evnts.end () && repeat != 0; i++)
+    {
+        repeat = raise_event (*i);
+    }
+
+    return repeat;
+}
+
 // save the state of the script associated with the event
 void listener::put_state (base::flat & file) const
 {
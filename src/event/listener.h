@@ -36,6 +36,7 @@
 #endif
 
 #include <Python.h>
+#include <vector>
 #include "event.h"
 #include <adonthell/base/callback.h>
 
@@ -48,6 +49,14 @@ namespace events
         LISTENER_PYTHON = 1
     };
 
+    /** Ways of dispatching events to listeners */
+    enum
+    {
+        DISPATCH_IMMEDIATE = 0,
+        DISPATCH_DEFERRED  = 1,
+        DISPATCH_BATCHED   = 2
+    };
+
     class factory;
 
     /**
@@ -209,6 +218,18 @@ namespace events
          */ 
         virtual s_int32 raise_event (const event* evnt) = 0;
 
+#ifndef SWIG
+        /**
+         * Execute the associated python script or callback once for a
+         * batch of events queued during the last frame. By default, the
+         * callback is executed for each %event in turn.
+         *
+         * @param evnts The events that triggered the execution.
+         * @return The number of times the %event needs to be repeated.
+         */
+        virtual s_int32 raise_events (const std::vector<const event*> & evnts);
+#endif // SWIG
+
         /** 
          * Check whether the given %event matches the %event attached to
          * the %listener.
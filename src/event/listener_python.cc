@@ -93,7 +93,7 @@ s_int32 listener_python::raise_event (const event* evnt)
     if (Method && Event->repeat ())
     {
         // event that triggered the script is 2nd argument of callback
-        PyTuple_SetItem (Args, 1, python::pass_instance ((event*) evnt));
+        PyTuple_SetItem (Args, 1, Wrapper.wrap ((event*) evnt));
         
         // adjust repeat count
         Event->do_repeat ();
@@ -118,6 +118,42 @@ s_int32 listener_python::raise_event (const event* evnt)
     return Event->repeat ();
 }
 
+// execute callback once for the given batch of events
+s_int32 listener_python::raise_events (const std::vector<const event*> & evnts)
+{
+    if (Method && Event->repeat ())
+    {
+        // events that triggered the script are 2nd argument of callback
+        PyObject *list = PyList_New (evnts.size ());
+        for (u_int32 i = 0; i < evnts.size (); i++)
+        {
+            PyList_SET_ITEM (list, i, python::pass_instance ((event*) evnts[i]));
+        }
+        PyTuple_SetItem (Args, 1, list);
+
+        // adjust repeat count
+        Event->do_repeat ();
+
+        // execute callback
+        Method->execute (Args);
+
+        // clean up
+        Py_INCREF(Py_None);
+        PyTuple_SetItem(Args, 1, Py_None);
+    }
+    else
+    {
+        if (!Method)
+        {
+            LOG(WARNING) << "listener::raise_events: '" << Id << "' no callback connected";
+            destroy();
+        }
+    }
+
+    // return whether event needs be repeated or not
+    return Event->repeat ();
+}
+
 // save the state of the script associated with the event
 void listener_python::put_state (base::flat & file) const
 {
@@ -91,6 +91,18 @@ namespace events
          * @return The number of times the %event needs to be repeated.
          */ 
         s_int32 raise_event (const event* evnt);
+
+#ifndef SWIG
+        /**
+         * Execute the associated python script once for a batch of events.
+         * Instead of a single %event, the script receives the list of all
+         * events that triggered the execution.
+         *
+         * @param evnts The events that triggered the execution.
+         * @return The number of times the %event needs to be repeated.
+         */
+        s_int32 raise_events (const std::vector<const event*> & evnts);
+#endif // SWIG
         //@}
 
         /**
@@ -129,6 +141,11 @@ namespace events
         * Arguments to pass to the method
          */
         PyObject *Args;
+
+        /**
+         * Python object of the last event passed to the method
+         */
+        python::instance_wrapper Wrapper;
     };
 }
 
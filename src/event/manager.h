@@ -29,6 +29,7 @@
 #ifndef EVENT_MANAGER_H
 #define EVENT_MANAGER_H
 
+#include <adonthell/base/trace.h>
 #include "factory.h"
 #include "manager_base.h"
 
@@ -57,6 +58,8 @@ namespace events
     
         /** 
          * Check if an %event corresponding to ev exists, and execute it. 
+         * If the %manager for this type of %event defers dispatch, the
+         * %event is queued until the next call to manager::dispatch().
          * 
          * @param ev %event to raise.
          */
@@ -65,7 +68,42 @@ namespace events
             manager_base *manager = event_type::get_manager (((event *) ev)->type ());
             if (manager != NULL)
             {
-                manager->raise_event (ev);
+                if (manager->dispatch_mode () == DISPATCH_IMMEDIATE)
+                    manager->raise_event (ev);
+                else
+                    manager->queue_event (ev);
+            }
+        }
+
+        /**
+         * Raise all events that have been queued by managers with deferred
+         * or batched dispatch. This should be called once per frame, after
+         * the game world has been updated.
+         */
+        static void dispatch ()
+        {
+            base::trace::zone zone ("events::manager::dispatch");
+            event_type::dispatch ();
+        }
+
+        /**
+         * Set how events of the given type are passed to their listeners.
+         * With DISPATCH_IMMEDIATE, callbacks are executed as soon as an
+         * %event is raised. With DISPATCH_DEFERRED, events are queued and
+         * raised one by one on the next call to manager::dispatch(). With
+         * DISPATCH_BATCHED, each %listener receives the list of all queued
+         * events matching it in a single callback.
+         *
+         * @param type name of the %event type, i.e. "move_event".
+         * @param mode one of DISPATCH_IMMEDIATE, DISPATCH_DEFERRED or
+         *      DISPATCH_BATCHED.
+         */
+        static void set_dispatch_mode (const std::string & type, const u_int8 & mode)
+        {
+            manager_base *manager = event_type::get_manager (event_type::get_id (type));
+            if (manager != NULL)
+            {
+                manager->set_dispatch_mode (mode);
             }
         }
     
@@ -0,0 +1,96 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software 
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   event/manager_base.cc
+ * @author agent <agent@local>
+ * 
+ * @brief  Implements deferred dispatch for event managers.
+ * 
+ */
+
+#include <adonthell/base/logging.h>
+#include "manager_base.h"
+
+using events::event;
+using events::manager_base;
+
+// change how events are passed to listeners
+void manager_base::set_dispatch_mode (const u_int8 & mode)
+{
+    if (mode > DISPATCH_BATCHED)
+    {
+        LOG(WARNING) << "manager_base::set_dispatch_mode: invalid mode " << (int) mode << " for '" << Name << "'";
+        return;
+    }
+
+    // do not lose events that have already been queued
+    if (mode == DISPATCH_IMMEDIATE) dispatch ();
+
+    Mode = mode;
+}
+
+// queue copy of event for later dispatch
+void manager_base::queue_event (const event *ev)
+{
+    event *copy = ev->clone ();
+
+    // events that cannot be copied are raised at once
+    if (copy == NULL) raise_event (ev);
+    else Queue.push_back (copy);
+}
+
+// raise all events queued so far
+void manager_base::dispatch ()
+{
+    if (Queue.empty ()) return;
+
+    // callbacks might queue new events while we dispatch
+    std::vector<event*> queue;
+    queue.swap (Queue);
+
+    if (Mode == DISPATCH_BATCHED)
+    {
+        raise_events (std::vector<const event*> (queue.begin (), queue.end ()));
+    }
+    else
+    {
+        for (std::vector<event*>::iterator i = queue.begin (); i != queue.end (); i++)
+            raise_event (*i);
+    }
+
+    for (std::vector<event*>::iterator i = queue.begin (); i != queue.end (); i++)
+        delete *i;
+}
+
+// raise a batch of events one by one
+void manager_base::raise_events (const std::vector<const event*> & evnts)
+{
+    for (std::vector<const event*>::const_iterator i = evnts.begin (); i != evnts.end (); i++)
+        raise_event (*i);
+}
+
+// discard queued events
+void manager_base::clear_queue ()
+{
+    for (std::vector<event*>::iterator i = Queue.begin (); i != Queue.end (); i++)
+        delete *i;
+
+    Queue.clear ();
+}
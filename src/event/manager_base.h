@@ -39,7 +39,13 @@ namespace events
     /**
      * This is the base class for actual event managers. It
      * keeps track of listeners, recieves triggered events
-     * and executes scripts associated with those events
+     * and executes scripts associated with those events.
+     *
+     * By default, events are passed to listeners the moment they
+     * are raised. Alternatively, a %manager can queue events and
+     * dispatch them once per frame, either one by one or as a batch
+     * of all matching events per %listener. Managers may override
+     * queue_event() to coalesce events that have been queued.
      */ 
     class manager_base
     {
@@ -54,6 +60,8 @@ namespace events
 			event *evt = create_event ();
 			Name = evt->name();
             delete evt;
+
+            Mode = DISPATCH_IMMEDIATE;
             
 			event_type::register_type (Name, this, create_event);
 		}
@@ -63,6 +71,7 @@ namespace events
          */
         virtual ~manager_base () 
 		{
+		    clear_queue ();
 		    event_type::remove_type (Name);
 		}
     
@@ -86,10 +95,71 @@ namespace events
          * @param ev %event to raise.
          */
         virtual void raise_event (const event* ev) = 0;
-		
+
+        /**
+         * @name Deferred dispatch
+         */
+        //@{
+        /**
+         * Set how events are passed to registered listeners. With
+         * DISPATCH_DEFERRED or DISPATCH_BATCHED, raised events are queued
+         * until dispatch() is called. Switching back to DISPATCH_IMMEDIATE
+         * raises all events still in the queue.
+         *
+         * @param mode one of DISPATCH_IMMEDIATE, DISPATCH_DEFERRED or
+         *      DISPATCH_BATCHED.
+         */
+        void set_dispatch_mode (const u_int8 & mode);
+
+        /**
+         * Get how events are passed to registered listeners.
+         * @return the current dispatch mode.
+         */
+        u_int8 dispatch_mode () const
+        {
+            return Mode;
+        }
+
+        /**
+         * Queue a copy of the given %event for deferred dispatch. If the
+         * %event cannot be copied, it is raised immediately instead.
+         *
+         * @param ev %event to queue.
+         */
+        virtual void queue_event (const event* ev);
+
+        /**
+         * Raise all events queued since the last call. Events queued
+         * by the callbacks themselves will be raised on the next call.
+         */
+        virtual void dispatch ();
+        //@}
+
+    protected:
+        /**
+         * Raise a batch of queued events. Managers supporting batched
+         * dispatch should pass each %listener all matching events at
+         * once, using listener::raise_events(). The default just raises
+         * each %event in turn.
+         *
+         * @param evnts the events to raise.
+         */
+        virtual void raise_events (const std::vector<const event*> & evnts);
+
+        /**
+         * Delete all queued events without raising them.
+         */
+        void clear_queue ();
+
+        /// events waiting for dispatch
+        std::vector<event*> Queue;
+
 	private:
 		/** Type name of events handled by this manager */
 		std::string Name;
+
+		/** How events are passed to listeners */
+		u_int8 Mode;
     };
 }
 #endif // EVENT_MANAGER_BASE_H
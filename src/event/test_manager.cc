@@ -0,0 +1,196 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   event/test_manager.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for deferred and batched event dispatch.
+ *
+ *
+ */
+
+#include <algorithm>
+
+#include "factory.h"
+#include "manager.h"
+
+#include <gtest/gtest.h>
+
+namespace events
+{
+    /**
+     * Event carrying a number, raised for listeners waiting
+     * for the same number.
+     */
+    class number_event : public event
+    {
+    public:
+        number_event () : Number (0) { }
+        number_event (const u_int32 & number) : Number (number) { }
+
+        bool equals (const event *e) const
+        {
+            return Number == ((const number_event *) e)->Number;
+        }
+
+        const char* name () const
+        {
+            return "number_event";
+        }
+
+        event *clone () const
+        {
+            return new number_event (*this);
+        }
+
+        u_int32 Number;
+    };
+
+    NEW_EVENT (events, number_event)
+
+    /**
+     * Minimal manager for number events.
+     */
+    class number_event_manager : public manager_base
+    {
+    public:
+        number_event_manager () : manager_base (&new_number_event) { }
+
+        void add (listener *li) { Listeners.push_back (li); }
+
+        void remove (listener *li)
+        {
+            std::vector<listener*>::iterator i = std::find (Listeners.begin (), Listeners.end (), li);
+            if (i != Listeners.end ()) Listeners.erase (i);
+        }
+
+        void raise_event (const event *e)
+        {
+            for (u_int32 i = 0; i < Listeners.size (); i++)
+                if (Listeners[i]->equals (e)) Listeners[i]->raise_event (e);
+        }
+
+    protected:
+        void raise_events (const std::vector<const event*> & evnts)
+        {
+            std::vector<const event*> batch;
+            for (u_int32 i = 0; i < Listeners.size (); i++)
+            {
+                batch.clear ();
+                for (u_int32 j = 0; j < evnts.size (); j++)
+                    if (Listeners[i]->equals (evnts[j])) batch.push_back (evnts[j]);
+                if (!batch.empty ()) Listeners[i]->raise_events (batch);
+            }
+        }
+
+    private:
+        std::vector<listener*> Listeners;
+    };
+
+    class manager_Test : public ::testing::Test {
+
+    protected:
+        virtual void SetUp() {
+            Count = 0;
+            Manager = new number_event_manager ();
+            Factory = new factory ();
+            Factory->register_event (new number_event (1), ::base::make_functor (*this, &manager_Test::count));
+        }
+
+        virtual void TearDown() {
+            delete Factory;
+            delete Manager;
+        }
+
+        void count (const event *evnt)
+        {
+            Count++;
+        }
+
+        void raise (const u_int32 & number, const u_int32 & times)
+        {
+            for (u_int32 i = 0; i < times; i++)
+            {
+                number_event evt (number);
+                manager::raise_event (&evt);
+            }
+        }
+
+        u_int32 Count;
+        number_event_manager *Manager;
+        factory *Factory;
+    }; // class{}
+
+    TEST_F(manager_Test, immediate) {
+        EXPECT_EQ(DISPATCH_IMMEDIATE, Manager->dispatch_mode ());
+
+        raise (1, 3);
+        raise (2, 3);
+        EXPECT_EQ(3u, Count);
+    }
+
+    TEST_F(manager_Test, deferred) {
+        manager::set_dispatch_mode ("number_event", DISPATCH_DEFERRED);
+        EXPECT_EQ(DISPATCH_DEFERRED, Manager->dispatch_mode ());
+
+        raise (1, 3);
+        raise (2, 3);
+        EXPECT_EQ(0u, Count);
+
+        manager::dispatch ();
+        EXPECT_EQ(3u, Count);
+
+        // queue is empty after dispatch
+        manager::dispatch ();
+        EXPECT_EQ(3u, Count);
+    }
+
+    TEST_F(manager_Test, batched) {
+        manager::set_dispatch_mode ("number_event", DISPATCH_BATCHED);
+
+        raise (1, 3);
+        raise (2, 3);
+        EXPECT_EQ(0u, Count);
+
+        // C++ listeners still receive each event of the batch
+        manager::dispatch ();
+        EXPECT_EQ(3u, Count);
+    }
+
+    TEST_F(manager_Test, back_to_immediate) {
+        manager::set_dispatch_mode ("number_event", DISPATCH_DEFERRED);
+        raise (1, 2);
+        EXPECT_EQ(0u, Count);
+
+        // pending events are not lost
+        manager::set_dispatch_mode ("number_event", DISPATCH_IMMEDIATE);
+        EXPECT_EQ(2u, Count);
+
+        raise (1, 1);
+        EXPECT_EQ(3u, Count);
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
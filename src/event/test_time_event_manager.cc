@@ -0,0 +1,214 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   event/test_time_event_manager.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for the time_event_manager class.
+ *
+ *
+ */
+
+#include <sstream>
+
+#include "date.h"
+#include "factory.h"
+#include "time_event.h"
+#include "time_event_manager.h"
+
+#include <gtest/gtest.h>
+
+namespace events
+{
+    /**
+     * Records when a listener has been raised.
+     */
+    class alarm
+    {
+    public:
+        alarm () : Id (0), Interval (0), Count (0), Late (0) { }
+
+        void fired (const event *evnt)
+        {
+            const time_event *now = (const time_event *) evnt;
+            if (Interval && now->time () % Interval != 0) Late++;
+            Order.push_back (Id);
+            Count++;
+        }
+
+        u_int32 Id;
+        u_int32 Interval;
+        u_int32 Count;
+        u_int32 Late;
+        static std::vector<u_int32> Order;
+    };
+
+    std::vector<u_int32> alarm::Order;
+
+    class time_event_manager_Test : public ::testing::Test {
+
+    protected:
+        virtual void SetUp() {
+            date::cleanup ();
+            alarm::Order.clear ();
+            Manager = new time_event_manager ();
+        }
+
+        virtual void TearDown() {
+            Factory.clear ();
+            // process listeners marked for deletion by the factory
+            for (u_int32 i = 0; Manager->size () > 0 && i < 1024; i++)
+            {
+                time_event evt (0xFFFFFFFF);
+                Manager->raise_event (&evt);
+            }
+            delete Manager;
+            date::cleanup ();
+        }
+
+        /**
+         * Register a time event that fires after the given number of
+         * seconds, and every interval seconds after that.
+         */
+        listener *add (alarm & a, const u_int32 & time, const u_int32 & interval)
+        {
+            std::ostringstream when, repeat;
+            when << time << "s";
+            repeat << interval << "s";
+
+            time_event *evt = new time_event (when.str ());
+            if (interval) evt->set_repeat (repeat.str ());
+
+            a.Interval = interval;
+            listener *li = Factory.add (evt, LISTENER_CXX);
+            li->connect_callback (::base::make_functor (a, &alarm::fired));
+            return li;
+        }
+
+        /**
+         * Advance %game time by the given number of seconds.
+         */
+        void advance (const u_int32 & seconds)
+        {
+            u_int32 until = date::time () + seconds;
+            while (date::time () < until) date::update ();
+        }
+
+        time_event_manager *Manager;
+        factory Factory;
+    }; // class{}
+
+    TEST_F(time_event_manager_Test, raise_in_order) {
+        alarm alarms[5];
+        u_int32 times[5] = { 5, 3, 4, 3, 1 };
+
+        for (u_int32 i = 0; i < 5; i++)
+        {
+            alarms[i].Id = i;
+            add (alarms[i], times[i], 0);
+        }
+        EXPECT_EQ(5u, Manager->size ());
+
+        advance (10);
+
+        // listeners with equal time are raised latest registration first
+        ASSERT_EQ(5u, alarm::Order.size ());
+        EXPECT_EQ(4u, alarm::Order[0]);
+        EXPECT_EQ(3u, alarm::Order[1]);
+        EXPECT_EQ(1u, alarm::Order[2]);
+        EXPECT_EQ(2u, alarm::Order[3]);
+        EXPECT_EQ(0u, alarm::Order[4]);
+        EXPECT_EQ(0u, Manager->size ());
+    }
+
+    TEST_F(time_event_manager_Test, remove_and_resume) {
+        alarm alarms[3];
+        listener *li[3];
+
+        for (u_int32 i = 0; i < 3; i++)
+        {
+            alarms[i].Id = i;
+            li[i] = add (alarms[i], 2, 2);
+        }
+
+        // pausing a listener removes it from the manager
+        li[1]->pause ();
+        EXPECT_EQ(2u, Manager->size ());
+
+        advance (4);
+        EXPECT_EQ(2u, alarms[0].Count);
+        EXPECT_EQ(0u, alarms[1].Count);
+        EXPECT_EQ(2u, alarms[2].Count);
+
+        li[1]->resume ();
+        EXPECT_EQ(3u, Manager->size ());
+
+        // a missed alarm is raised once right after resuming
+        advance (2);
+        EXPECT_EQ(3u, alarms[0].Count);
+        EXPECT_EQ(2u, alarms[1].Count);
+        EXPECT_EQ(3u, alarms[2].Count);
+        EXPECT_EQ(1u, alarms[1].Late);
+    }
+
+    TEST_F(time_event_manager_Test, stress_recurring_events) {
+        const u_int32 num_events = 100000;
+        const u_int32 duration = 600;
+        std::vector<alarm> alarms (num_events);
+        std::vector<listener*> li (num_events);
+
+        for (u_int32 i = 0; i < num_events; i++)
+        {
+            u_int32 interval = 1 + (i * 7919) % 120;
+            alarms[i].Id = i;
+            li[i] = add (alarms[i], interval, interval);
+        }
+        EXPECT_EQ(num_events, Manager->size ());
+
+        // cancel every tenth event before it fires
+        for (u_int32 i = 0; i < num_events; i += 10)
+        {
+            li[i]->pause ();
+        }
+        EXPECT_EQ(num_events - num_events / 10, Manager->size ());
+
+        advance (duration);
+
+        u_int32 late = 0, wrong = 0;
+        for (u_int32 i = 0; i < num_events; i++)
+        {
+            u_int32 expected = i % 10 == 0 ? 0 : duration / alarms[i].Interval;
+            if (alarms[i].Count != expected) wrong++;
+            late += alarms[i].Late;
+        }
+
+        EXPECT_EQ(0u, wrong);
+        EXPECT_EQ(0u, late);
+        // repeating events stay registered
+        EXPECT_EQ(num_events - num_events / 10, Manager->size ());
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -29,9 +29,8 @@
 #include "time_event_manager.h"
 #include "time_event.h"
 #include "date.h"
-#include <algorithm>
 
-using std::list;
+using std::map;
 using events::time_event_manager;
 using events::event_type;
 
@@ -41,7 +40,7 @@ NEW_EVENT (events, time_event)
 // register time events with event subsystem 
 time_event_manager::time_event_manager () : manager_base (&new_time_event)
 {
-	// nothing to do here
+    Seq = 0;
 }
 
 // See whether a matching event is registered and execute the
@@ -51,12 +50,12 @@ void time_event_manager::raise_event (const event * e)
     s_int32 repeat;
     listener *li;
     
-    // As long as matching events are in the list
-    while (!Listeners.empty () && (li = Listeners.back ())->equals (e))
+    // As long as matching events are in the queue
+    while (!Queue.empty () && (li = Queue.front ()->Listener)->equals (e))
     {
         // no matter whether the listener will be destroyed or not,
         // it needs to be reregistered, so remove it in any case
-        Listeners.pop_back ();
+        erase (0);
 
         // execute event callback
         repeat = li->raise_event (e);
@@ -72,29 +71,92 @@ void time_event_manager::raise_event (const event * e)
 // Unregister a listener
 void time_event_manager::remove (listener *li)
 {
-    list<listener*>::iterator i;
-
     // Search for the event we want to remove
-    i = find (Listeners.begin (), Listeners.end (), li);
+    map<listener*, entry>::iterator i = Entries.find (li);
 
     // found? -> get rid of it :)
-    if (i != Listeners.end ()) Listeners.erase (i);
+    if (i != Entries.end ()) erase (i->second.Pos);
 }
 
 // register a listener with the manager
 void time_event_manager::add (listener *li)
 {
-    list<listener*>::iterator i = Listeners.begin ();
+    // a listener is only queued once
+    remove (li);
+
+    entry & e = Entries[li];
+    e.Time = ((time_event *) li->get_event ())->time ();
+    e.Seq = Seq++;
+    e.Pos = Queue.size ();
+    e.Listener = li;
+
+    Queue.push_back (&e);
+    sift_up (e.Pos);
+}
+
+// remove entry at given position from the heap
+void time_event_manager::erase (u_int32 pos)
+{
+    listener *li = Queue[pos]->Listener;
+    u_int32 last = Queue.size () - 1;
+
+    // move last entry into the gap and restore heap order
+    if (pos != last)
+    {
+        Queue[pos] = Queue[last];
+        Queue[pos]->Pos = pos;
+        Queue.pop_back ();
+
+        if (pos > 0 && before (Queue[pos], Queue[(pos - 1) / 2])) sift_up (pos);
+        else sift_down (pos);
+    }
+    else
+    {
+        Queue.pop_back ();
+    }
+
+    Entries.erase (li);
+}
+
+// move entry up until its parent is raised earlier
+void time_event_manager::sift_up (u_int32 pos)
+{
+    entry *e = Queue[pos];
 
-    // search for the proper place to insert new listener
-    while (i != Listeners.end ())
+    while (pos > 0)
     {
-        // FIXME: list is sorted, using binary search would speed up insert
-        
-        // skip events that are raised earlier than e
-        if (((time_event *) li->get_event ())->time () > ((time_event *) (*i)->get_event ())->time ()) break;
-        i++;
+        u_int32 parent = (pos - 1) / 2;
+        if (!before (e, Queue[parent])) break;
+
+        Queue[pos] = Queue[parent];
+        Queue[pos]->Pos = pos;
+        pos = parent;
+    }
+
+    Queue[pos] = e;
+    e->Pos = pos;
+}
+
+// move entry down until its children are raised later
+void time_event_manager::sift_down (u_int32 pos)
+{
+    entry *e = Queue[pos];
+    u_int32 size = Queue.size ();
+
+    while (true)
+    {
+        u_int32 child = 2 * pos + 1;
+        if (child >= size) break;
+
+        // pick the child that needs to be raised first
+        if (child + 1 < size && before (Queue[child + 1], Queue[child])) child++;
+        if (!before (Queue[child], e)) break;
+
+        Queue[pos] = Queue[child];
+        Queue[pos]->Pos = pos;
+        pos = child;
     }
 
-    Listeners.insert (i, li);
+    Queue[pos] = e;
+    e->Pos = pos;
 }
@@ -30,15 +30,20 @@
 #define EVENT_TIME_EVENT_MANAGER_H
 
 #include "manager_base.h"
-#include <list>
+#include <vector>
+#include <map>
 
 namespace events
 {
     /**
      * This class keeps track of time events, i.e. events that are raised
      * at a certain point in (%game) time. All registered events are 
-     * sorted by the time they need to be raised, so that only one
-     * comparison decides upon whether an %event is to be raised.
+     * kept in a binary heap ordered by the time they need to be raised,
+     * so that only one comparison decides upon whether an %event is to
+     * be raised. Registering and removing a %listener are both O(log n).
+     *
+     * Listeners sharing the same "alarm" time are raised in reverse order
+     * of registration, i.e. the %listener added last is raised first.
      */
     class time_event_manager : public manager_base
     {
@@ -51,12 +56,11 @@ namespace events
 	
         /**
          * Register a time %listener with the %event manager. It is inserted
-         * into the list of registered listeners depending on its "alarm"
+         * into the queue of registered listeners depending on its "alarm"
          * time. The %listener needs to be removed before it can be safely
          * deleted.
          *
          * @param li Pointer to the %listener to be registered.
-         * @todo use binary search to find position for insert.
          */
         void add (listener *li);
         
@@ -71,16 +75,71 @@ namespace events
         /**
          * Raise one or more events in case the given time matches their
          * "alarm" time. When they need to be repeated, they are
-         * re-inserted into the %event-list.
+         * re-inserted into the %event queue.
          *
          * @param evnt An %event structure with the current %game time in 
          *      minutes.
          */
         void raise_event (const event *evnt);
 
+        /**
+         * Get the number of listeners currently registered.
+         * @return number of listeners waiting to be raised.
+         */
+        u_int32 size () const
+        {
+            return Queue.size ();
+        }
+
     private:
-        /// storage for registered listeners.
-        std::list<listener*> Listeners;
+        /// a registered listener and its position in the queue
+        struct entry
+        {
+            /// the listener's "alarm" time at the time it was added
+            u_int32 Time;
+            /// order of registration, to break ties between equal times
+            u_int32 Seq;
+            /// index of this entry in the heap
+            u_int32 Pos;
+            /// the registered listener
+            listener *Listener;
+        };
+
+        /**
+         * Whether entry a needs to be raised before entry b.
+         */
+        static bool before (const entry *a, const entry *b)
+        {
+            if (a->Time != b->Time) return a->Time < b->Time;
+            return a->Seq > b->Seq;
+        }
+
+        /**
+         * Move the entry at the given heap position towards the root
+         * until the heap property is restored.
+         * @param pos index of the entry in the heap.
+         */
+        void sift_up (u_int32 pos);
+
+        /**
+         * Move the entry at the given heap position towards the leaves
+         * until the heap property is restored.
+         * @param pos index of the entry in the heap.
+         */
+        void sift_down (u_int32 pos);
+
+        /**
+         * Remove the entry at the given heap position.
+         * @param pos index of the entry in the heap.
+         */
+        void erase (u_int32 pos);
+
+        /// binary min-heap of registered listeners, soonest on top.
+        std::vector<entry*> Queue;
+        /// storage for queue entries, by listener.
+        std::map<listener*, entry> Entries;
+        /// registration counter
+        u_int32 Seq;
     };
 }
 
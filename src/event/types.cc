@@ -94,6 +94,15 @@ manager_base *event_type::get_manager (const u_int8 & id)
     return NULL;
 }
 
+// raise queued events of all event types
+void event_type::dispatch ()
+{
+    for (u_int32 i = 0; i < Types().size(); i++)
+    {
+        if (Types()[i] != NULL) Types()[i]->manager ()->dispatch ();
+    }
+}
+
 // Types of events registered with the event subsystem by name
 std::hash_map<std::string, event_type*>& event_type::NamedTypes ()
 {
@@ -93,6 +93,12 @@ public:
      * @return %event %manager or \c NULL on error.
      */
     static manager_base *get_manager (const u_int8 & id);
+
+    /**
+     * Raise all events queued by the managers of all registered
+     * %event types.
+     */
+    static void dispatch ();
     
     /**
      * Return Id of this %event type.
@@ -33,6 +33,7 @@
 
 #include "surface.h"
 #include <adonthell/base/base.h>
+#include <adonthell/base/telemetry.h>
 #include <adonthell/base/configuration.h>
 
 namespace gfx
@@ -121,6 +122,7 @@ namespace gfx
          */ 
         static void update ()
         {
+            base::telemetry::scope measure (base::telemetry::PRESENT);
         	update_p();
         }
 
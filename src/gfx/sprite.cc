@@ -30,6 +30,7 @@
 #include "sprite.h"
 #include <adonthell/base/base.h>
 #include <adonthell/base/diskio.h>
+#include <adonthell/base/state_name.h>
 #include <adonthell/event/date.h>
 #include <adonthell/event/time_event.h>
 
@@ -64,6 +65,7 @@ namespace gfx
             }                
         }
         m_states.clear ();
+        m_by_id.clear ();
         m_valid = false;
         m_playing = false;
         if (!m_listener->is_paused()) 
@@ -74,12 +76,32 @@ namespace gfx
     
     // change animation being played
     bool sprite::change_animation (const std::string & new_animation)
+    {
+        return change_animation (base::state_name::id (new_animation));
+    }
+
+    // change animation being played
+    bool sprite::change_animation (const u_int16 & new_animation)
     {
         //Check if the animation is valid yet
         if(!m_valid) return false;
 
-        // Look for an animation with the name passed in
-        animation_map::iterator anim = m_states.find(new_animation);
+        // index animations by the id of their name
+        if (m_by_id.empty())
+        {
+            for (animation_map::iterator i = m_states.begin(); i != m_states.end(); i++)
+            {
+                u_int16 id = base::state_name::id (i->first);
+                if (id >= m_by_id.size()) m_by_id.resize (id + 1, m_states.end());
+                m_by_id[id] = i;
+            }
+        }
+
+        // Look for an animation with the id passed in
+        if (new_animation >= m_by_id.size())
+            return false;
+
+        animation_map::iterator anim = m_by_id[new_animation];
         if(anim == m_states.end())
             return false;
 
@@ -177,6 +199,8 @@ namespace gfx
             m_states[animation_name] = cur_animation;
         }
 
+        m_by_id.clear ();
+
         return file.success ();
     }
     
@@ -195,6 +219,7 @@ namespace gfx
                 animation_list cur_animation;
                 cur_animation.push_back (new animation_frame (surfaces->get_surface (full_path, false, false), 0));
                 m_states["default"] = cur_animation;
+                m_by_id.clear ();
                 retval = true;
             }
         }
@@ -36,6 +36,7 @@
 #include "surface_cacher.h"
 #include "surface.h"
 #include <queue>
+#include <vector>
 
 namespace gfx
 {
@@ -116,6 +117,14 @@ namespace gfx
         bool change_animation (const std::string & new_animation);
         
 #ifndef SWIG
+        /**
+         * Change the current animation we are using
+         *
+         * @param new_animation id of the animation's name, as returned by base::state_name::id().
+         * @return true if new_animation was found.
+         */
+        bool change_animation (const u_int16 & new_animation);
+
         /**
          * Return iterator to first animation of the %sprite.
          * @return iterator pointing to first animation.
@@ -281,6 +290,8 @@ namespace gfx
         animation_map m_states;
         /// an animation
         animation_map::iterator m_animation;
+        /// animations by id of their name, built on demand
+        std::vector<animation_map::iterator> m_by_id;
         /// a frame
         animation_list::iterator m_surface;
         
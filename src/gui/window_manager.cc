@@ -24,6 +24,7 @@
  * @brief Handles window order and input.
  */
 
+#include <adonthell/base/trace.h>
 #include <adonthell/world/area_manager.h>
 #include <adonthell/world/vector3.h>
 #include "window_manager.h"
@@ -40,6 +41,8 @@ std::list<events::listener*> window_manager::PendingEvents;
 // render to screen
 void window_manager::update()
 {
+    base::trace::zone zone ("window_manager::update");
+
     // trigger the event listeners
     fire_events();
 
@@ -35,6 +35,7 @@
 
 #include <list> 
 
+#include <adonthell/base/telemetry.h>
 #include "listener.h"
 
 namespace input
@@ -59,7 +60,11 @@ namespace input
          * accordingly.
          * 
          */
-        static void update() { update_p(); }
+        static void update()
+        {
+            base::telemetry::scope measure (base::telemetry::INPUT);
+            update_p();
+        }
 
         /**
          * Turn on or off unicode text input mode.
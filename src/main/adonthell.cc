@@ -34,11 +34,15 @@
 #include <adonthell/gfx/gfx.h>
 #include <adonthell/base/nls.h>
 #include <adonthell/base/base.h>
+#include <adonthell/base/log_writer.h>
+#include <adonthell/base/record_cache.h>
 #include <adonthell/base/savegame.h>
+#include <adonthell/base/trace.h>
 #include <adonthell/input/input.h>
 #include <adonthell/audio/audio.h>
 #include <adonthell/audio/audio_manager.h>
 #include <adonthell/python/python.h>
+#include <adonthell/python/profiler.h>
 #include <adonthell/world/world.h>
 #include <adonthell/gui/gui.h>
 #include <adonthell/rpg/rpg.h>
@@ -109,6 +113,9 @@ bool app::init_modules (const u_int16 & modules)
         // update the python search path
         python::add_search_path (base::Paths().game_data_dir());
         python::add_search_path (base::Paths().user_data_dir());
+
+        // measure time spent in scripts, if requested
+        python::profiler::setup (Cfg);
     }
 
     if (m & EVENT)
@@ -176,6 +183,9 @@ void app::parse_args (int & argc, char *argv[])
 {
     google::InitGoogleLogging(argv[0]);
 
+    // keep slow terminals from stalling the game
+    logging::log_writer::start ();
+
     LOG(INFO) << logging::indent() << "app::parse_args() called";
     logging::increment_log_indent_level();
 
@@ -195,9 +205,10 @@ void app::parse_args (int & argc, char *argv[])
     Backend = "";
     Userdatadir = "";
     Config = "adonthell";
+    Prebuild = false;
 
     // Check for options
-    while ((c = getopt (argc, argv, "b:c:g:hv")) != -1)
+    while ((c = getopt (argc, argv, "b:c:g:hpt:v")) != -1)
     {
         switch (c)
         {
@@ -225,6 +236,16 @@ void app::parse_args (int & argc, char *argv[])
                 print_help ();
                 exit (0);
                 break;
+            // compile XML records:
+            case 'p':
+                LOG(INFO) << "found option '" << c << "': prebuilding record cache";
+                Prebuild = true;
+                break;
+            // record trace of frames:
+            case 't':
+                LOG(INFO) << "found option '" << c << "': tracing to '" << optarg << "'";
+                base::trace::enable (optarg);
+                break;
             // version number:
             case 'v':
                 LOG(INFO) << "found option '" << c << "': printing version";
@@ -274,6 +295,18 @@ bool app::init ()
         return false;
     }
 
+    // store binary copies of all XML records and quit
+    if (Prebuild)
+    {
+        u_int32 count = base::record_cache::prebuild (base::Paths().game_data_dir ());
+        if (base::Paths().user_data_dir () != "")
+        {
+            count += base::record_cache::prebuild (base::Paths().user_data_dir ());
+        }
+        std::cout << "Cached " << count << " records of '" << Game << "'" << std::endl;
+        exit (0);
+    }
+
     // read available saved games
     if (Game != "")
     {
@@ -353,7 +386,15 @@ void app::cleanup () const
     if (Modules & EVENT) events::cleanup();
     if (Modules & PYTHON) python::cleanup ();
 
+    // write trace of recent frames
+    if (base::trace::is_enabled ())
+    {
+        base::trace::disable ();
+        base::trace::dump ();
+    }
+
     // stop logging
+    logging::log_writer::stop ();
     google::ShutdownGoogleLogging();
 }
 
@@ -368,6 +409,8 @@ void app::print_help () const
         << "-c <config>      use given config file (default 'adonthell')" << std::endl
         << "-g <directory>   specify user game directory"                 << std::endl
         << "-h               print this message and exit"                 << std::endl
+        << "-p               cache all XML records of GAME and exit"      << std::endl
+        << "-t <file>        write trace of recent frames to file on exit" << std::endl
         << "-v               print engine version number and exit"        << std::endl
         ;
 }
@@ -162,6 +162,9 @@ namespace adonthell {
             
             /// game to launch
             string Game;
+
+            /// whether to fill the record cache instead of launching the game
+            bool Prebuild;
             
             /// modules currently loaded
             u_int16 Modules;
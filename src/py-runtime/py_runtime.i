@@ -52,6 +52,21 @@ PyObject *cxx_to_py (void *instance, const char *name, const bool & ownership)
     exit(1);
 }
 
+// look up SWIG type information for given type name
+void *cxx_type_query (const char *name)
+{
+	// get global typelist
+	swig_type_info ** typelist = SWIG_Python_GetTypeListHandle();
+
+    return SWIG_TypeQueryTL (*typelist, name);
+}
+
+// pass a C++ object of known type to Python
+PyObject *cxx_to_py_type (void *instance, void *type, const bool & ownership)
+{
+    return SWIG_NewPointerObj (instance, (swig_type_info *) type, ownership);
+}
+
 // pass a Python object to C++
 void py_to_cxx (PyObject *instance, const char *name, void **retval)
 {
@@ -162,6 +177,23 @@ SWIGEXPORT PyObject *cxx_to_py (void *instance, const char *name, const bool & o
     exit(1);
 }
 
+// look up SWIG type information for given type name
+SWIGEXPORT void *cxx_type_query (const char *name)
+{
+    if (SWIG_Python_GetModule(CLIENTDATA))
+    {
+        return SWIG_Python_TypeQuery (name);
+    }
+
+    return NULL;
+}
+
+// pass a C++ object of known type to Python
+SWIGEXPORT PyObject *cxx_to_py_type (void *instance, void *type, const bool & ownership)
+{
+    return SWIG_NewPointerObj (instance, (swig_type_info *) type, ownership);
+}
+
 // pass a Python object to C++
 SWIGEXPORT void py_to_cxx (PyObject *instance, const char *name, void **retval)
 {
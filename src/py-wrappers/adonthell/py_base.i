@@ -10,6 +10,7 @@
 #include <adonthell/base/diskio.h>
 #include <adonthell/base/configuration.h>
 #include <adonthell/base/savegame.h>
+#include <adonthell/base/telemetry.h>
 
 #include <adonthell/python/callback.h>
 
@@ -162,6 +163,7 @@ namespace base {
 %include <adonthell/base/base.h>
 %include <adonthell/base/types.h>
 %include <adonthell/base/timer.h>
+%include <adonthell/base/telemetry.h>
 %include <adonthell/base/file.h>
 %include <adonthell/base/flat.h>
 %include <adonthell/base/diskio.h>
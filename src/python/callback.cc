@@ -30,10 +30,11 @@
  */
 
 #include "python.h"
+#include "profiler.h"
 
 namespace python
 {
-    functor_base::functor_base (PyObject * c) : callable(c)
+    functor_base::functor_base (PyObject * c) : callable(c), spare_args(NULL)
     {
         Py_INCREF(callable);
     }
@@ -41,6 +42,7 @@ namespace python
     functor_base::~functor_base()
     {
         Py_DECREF(callable);
+        Py_XDECREF(spare_args);
     }
 
     functor_0::functor_0 (PyObject * c) : base::functor_0(),
@@ -54,7 +56,9 @@ namespace python
         PyObject * pyres;
         
         // We can directly call our function
+        double started = profiler::start();
         pyres = PyObject_CallObject(callable, NULL);
+        if (started) profiler::stop(started, callable);
         
         show_traceback();
         
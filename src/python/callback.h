@@ -34,6 +34,7 @@
 #include <adonthell/base/callback.h>
 #include <adonthell/base/logging.h>
 #include "python.h"
+#include "profiler.h"
 
 #include <iostream>
 
@@ -51,6 +52,9 @@ namespace python
 
     protected:
         PyObject * callable;
+
+        /// argument tuple kept for the next call
+        PyObject * spare_args;
     };
 
     /**
@@ -87,7 +91,9 @@ namespace python
             PyObject * pyres;
             
             // We can directly call our function
-            pyres = PyObject_CallObject(callable, NULL);            
+            double started = profiler::start();
+            pyres = PyObject_CallObject(callable, NULL);
+            if (started) profiler::stop(started, callable);
             show_traceback();
             
             if (pyres)
@@ -120,19 +126,21 @@ namespace python
             PyObject * pyarg1;
             PyObject * pyres;
             
-            PyObject * pyargs = PyTuple_New(1);
+            PyObject * pyargs = take_args(spare_args, 1);
             pyarg1 = pass_instance<P1>(arg1);
             if (!pyarg1) LOG(ERROR) << logging::indent() << "Warning! Argument not valid!\n";
             
-            // The SetItem steals our reference to pyarg1
-            PyTuple_SetItem(pyargs, 0, pyarg1);
+            // The SET_ITEM steals our reference to pyarg1
+            PyTuple_SET_ITEM(pyargs, 0, pyarg1);
             
             // We can finally call our function
-            pyres = PyObject_CallObject(callable, pyargs);
+            double started = profiler::start();
+            pyres = PyObject_Call(callable, pyargs, NULL);
+            if (started) profiler::stop(started, callable);
             
             show_traceback();
             
-            Py_DECREF(pyargs);
+            recycle_args(spare_args, pyargs);
             Py_XDECREF(pyres);
         }
     };
@@ -160,22 +168,24 @@ namespace python
             PyObject * pyarg2;
             PyObject * pyres;
             
-            PyObject * pyargs = PyTuple_New(2);
+            PyObject * pyargs = take_args(spare_args, 2);
             pyarg1 = pass_instance<P1>(arg1);
             pyarg2 = pass_instance<P2>(arg2);
             if (!pyarg1) LOG(ERROR) << logging::indent() << "Warning! Argument not valid!\n";
             if (!pyarg2) LOG(ERROR) << logging::indent() << "Warning! Argument not valid!\n";
             
-            // The SetItem steals our reference to pyarg1
-            PyTuple_SetItem(pyargs, 0, pyarg1);
-            PyTuple_SetItem(pyargs, 1, pyarg2);
+            // The SET_ITEM steals our reference to pyarg1 and pyarg2
+            PyTuple_SET_ITEM(pyargs, 0, pyarg1);
+            PyTuple_SET_ITEM(pyargs, 1, pyarg2);
             
             // We can finally call our function
-            pyres = PyObject_CallObject(callable, pyargs);
+            double started = profiler::start();
+            pyres = PyObject_Call(callable, pyargs, NULL);
+            if (started) profiler::stop(started, callable);
             
             show_traceback();
             
-            Py_DECREF(pyargs);
+            recycle_args(spare_args, pyargs);
             Py_XDECREF(pyres);
         }
     };
@@ -203,19 +213,21 @@ namespace python
             PyObject * pyarg1;
             PyObject * pyres;
             
-            PyObject * pyargs = PyTuple_New(1);
+            PyObject * pyargs = take_args(spare_args, 1);
             pyarg1 = pass_instance<P1>(arg1);
             if (!pyarg1) LOG(ERROR) << logging::indent() << "Warning! Argument not valid!\n";
             
-            // The SetItem steals our reference to pyarg1
-            PyTuple_SetItem(pyargs, 0, pyarg1);
+            // The SET_ITEM steals our reference to pyarg1
+            PyTuple_SET_ITEM(pyargs, 0, pyarg1);
 
             // We can finally call our function
-            pyres = PyObject_CallObject(callable, pyargs);
+            double started = profiler::start();
+            pyres = PyObject_Call(callable, pyargs, NULL);
+            if (started) profiler::stop(started, callable);
 
             show_traceback();
             
-            Py_DECREF(pyargs);
+            recycle_args(spare_args, pyargs);
 
             if (pyres)
             {
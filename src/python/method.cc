@@ -29,11 +29,13 @@
 
 #include "method.h"
 #include "pool.h"
+#include "profiler.h"
 
 using python::method;
 
 method::method (python::script *scrpt, const std::string & mtd)
 {
+    Args = NULL;
     Script = scrpt;
     init (mtd);
 }
@@ -52,6 +54,7 @@ void method::init (const std::string & mtd)
 method::~method ()
 {
     Py_XDECREF (Method);
+    Py_XDECREF (Args);
 }
 
 // figure out name of python method
@@ -81,7 +84,35 @@ bool method::execute (PyObject *args)
 {
     if (Method) 
     {
-        PyObject *result = PyObject_CallObject (Method, args);
+        PyObject *result;
+        double started = profiler::start ();
+        PyObject *self = PyMethod_Check (Method) ? PyMethod_GET_SELF (Method) : NULL;
+        if (self != NULL)
+        {
+            // pass instance as first argument, saving python from
+            // creating the argument tuple on each call
+            u_int16 size = args ? PyTuple_GET_SIZE (args) : 0;
+            PyObject *call_args = take_args (Args, size + 1);
+
+            Py_INCREF (self);
+            PyTuple_SET_ITEM (call_args, 0, self);
+            for (u_int16 i = 0; i < size; i++)
+            {
+                PyObject *arg = PyTuple_GET_ITEM (args, i);
+                Py_INCREF (arg);
+                PyTuple_SET_ITEM (call_args, i + 1, arg);
+            }
+
+            result = PyObject_Call (PyMethod_GET_FUNCTION (Method), call_args, NULL);
+            recycle_args (Args, call_args);
+        }
+        else
+        {
+            result = PyObject_CallObject (Method, args);
+        }
+
+        if (started) profiler::stop (started, Method);
+
         if (result) 
         {
             Py_DECREF (result);
@@ -46,7 +46,7 @@ namespace python
         /**
          * Standard constructor.
          */
-        method () : Script (NULL), Method (NULL) { }
+        method () : Script (NULL), Method (NULL), Args (NULL) { }
 #endif // SWIG
 
         /**
@@ -75,6 +75,8 @@ namespace python
         
         /**
          * Execute the connected %method with the given arguments.
+         * Bound methods are called through their function directly,
+         * passing the instance along with the arguments.
          * @param args a python tuple to be passed to the %method.
          */
         bool execute (PyObject *args);
@@ -118,6 +120,11 @@ namespace python
          * The %python %method wrapped by this class
          */
         PyObject *Method;
+
+        /**
+         * Argument tuple kept for the next call of the %method
+         */
+        PyObject *Args;
     };
 }
 #endif // PYTHON_METHOD_H
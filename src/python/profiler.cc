@@ -0,0 +1,343 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   python/profiler.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Implements the profiler for calls into Python.
+ *
+ *
+ */
+
+#include <csignal>
+#include <fstream>
+#include <sys/time.h>
+
+#include <adonthell/base/base.h>
+#include <adonthell/base/configuration.h>
+#include <adonthell/base/logging.h>
+#include "profiler.h"
+
+using python::profiler;
+
+/// number of frames kept for the dump
+#define RECENT_FRAMES 300
+
+/// set by the signal handler to request a dump
+static volatile sig_atomic_t DumpRequested = 0;
+
+#ifdef SIGUSR1
+/// request a dump at the next opportunity
+static void request_dump (int sig)
+{
+    DumpRequested = 1;
+}
+#endif
+
+/// write string with JSON escapes
+static void put_json_string (std::ostream & out, const std::string & str)
+{
+    out << '"';
+    for (std::string::const_iterator i = str.begin (); i != str.end (); i++)
+    {
+        switch (*i)
+        {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+            {
+                if ((unsigned char) *i < 0x20) out << ' ';
+                else out << *i;
+            }
+        }
+    }
+    out << '"';
+}
+
+// profiler state
+bool profiler::Enabled = false;
+std::string profiler::File;
+u_int32 profiler::Depth = 0;
+std::map<std::string, std::map<std::string, std::map<std::string, profiler::method_stats> > > profiler::Methods;
+profiler::frame_stats profiler::Frame;
+std::deque<profiler::frame_stats> profiler::Recent;
+u_int32 profiler::Frames = 0;
+double profiler::FrameTotal = 0;
+double profiler::FrameMax = 0;
+std::map<std::pair<PyObject*, PyObject*>, const char*> profiler::TraceNames;
+
+// enable profiler if configured
+void profiler::setup (base::configuration & cfg)
+{
+    bool enabled = cfg.get_int ("Python", "Profile", 0) == 1;
+    cfg.option ("Python", "Profile", base::cfg_option::BOOL);
+
+    std::string file = cfg.get_string ("Python", "ProfileFile", base::Paths().cfg_data_dir () + "python-profile.json");
+    cfg.option ("Python", "ProfileFile", base::cfg_option::FREE);
+
+    if (enabled) enable (file);
+}
+
+// write results and stop profiling
+void profiler::cleanup ()
+{
+    if (Enabled)
+    {
+        next_frame (0);
+        dump ();
+    }
+
+    disable ();
+    reset ();
+
+    // release objects kept for tracing
+    std::map<std::pair<PyObject*, PyObject*>, const char*>::iterator i;
+    for (i = TraceNames.begin (); i != TraceNames.end (); i++)
+    {
+        Py_DECREF (i->first.first);
+        Py_XDECREF (i->first.second);
+    }
+    TraceNames.clear ();
+}
+
+// start profiling
+void profiler::enable (const std::string & file)
+{
+    File = file;
+    Enabled = true;
+
+#ifdef SIGUSR1
+    signal (SIGUSR1, request_dump);
+#endif
+
+    LOG(INFO) << "profiling python calls, writing results to '" << File << "'";
+}
+
+// stop profiling
+void profiler::disable ()
+{
+    Enabled = false;
+}
+
+// forget results
+void profiler::reset ()
+{
+    Methods.clear ();
+    Recent.clear ();
+    Frame = frame_stats ();
+    Frames = 0;
+    FrameTotal = 0;
+    FrameMax = 0;
+}
+
+// write results to file
+bool profiler::dump ()
+{
+    std::ofstream out (File.c_str ());
+    if (!out.good ())
+    {
+        LOG(ERROR) << "profiler::dump: cannot write '" << File << "'";
+        return false;
+    }
+
+    dump (out);
+    return out.good ();
+}
+
+// write results as JSON
+void profiler::dump (std::ostream & out)
+{
+    out << "{\n  \"methods\": [";
+
+    const char *separator = "\n";
+    std::map<std::string, std::map<std::string, std::map<std::string, method_stats> > >::const_iterator file;
+    for (file = Methods.begin (); file != Methods.end (); file++)
+    {
+        std::map<std::string, std::map<std::string, method_stats> >::const_iterator cls;
+        for (cls = file->second.begin (); cls != file->second.end (); cls++)
+        {
+            std::map<std::string, method_stats>::const_iterator method;
+            for (method = cls->second.begin (); method != cls->second.end (); method++)
+            {
+                out << separator << "    {\"file\": ";
+                put_json_string (out, file->first);
+                out << ", \"class\": ";
+                put_json_string (out, cls->first);
+                out << ", \"method\": ";
+                put_json_string (out, method->first);
+                out << ", \"calls\": " << method->second.Calls
+                    << ", \"total_us\": " << (u_int32) method->second.Total
+                    << ", \"max_us\": " << (u_int32) method->second.Max << "}";
+                separator = ",\n";
+            }
+        }
+    }
+
+    out << "\n  ],\n  \"frames\": {\"count\": " << Frames
+        << ", \"total_us\": " << (u_int32) FrameTotal
+        << ", \"max_us\": " << (u_int32) FrameMax
+        << ", \"recent\": [";
+
+    for (std::deque<frame_stats>::const_iterator i = Recent.begin (); i != Recent.end (); i++)
+    {
+        if (i != Recent.begin ()) out << ", ";
+        out << "[" << i->Uptime << ", " << i->Calls << ", " << (u_int32) i->Total << "]";
+    }
+
+    out << "]}\n}\n";
+}
+
+// start timing a call
+double profiler::begin ()
+{
+    if (Enabled)
+    {
+        // outermost call of a new frame?
+        if (Depth == 0 && base::Timer.uptime () != Frame.Uptime)
+        {
+            next_frame (base::Timer.uptime ());
+        }
+
+        Depth++;
+    }
+
+    return now ();
+}
+
+// finish timing a call
+void profiler::stop (const double & started, PyObject *callable)
+{
+    double time = now () - started;
+
+    if (base::trace::is_enabled ())
+    {
+        base::trace::add (trace_name (callable), base::timer::timestamp () - (u_int64) time, (u_int32) time);
+    }
+
+    if (!Enabled) return;
+    if (Depth > 0) Depth--;
+
+    std::string file, cls, method;
+    describe (callable, file, cls, method);
+
+    method_stats & stats = Methods[file][cls][method];
+    stats.Calls++;
+    stats.Total += time;
+    if (time > stats.Max) stats.Max = time;
+
+    if (Depth == 0)
+    {
+        Frame.Calls++;
+        Frame.Total += time;
+    }
+}
+
+// current time in microseconds
+double profiler::now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+// account current frame and start a new one
+void profiler::next_frame (const u_int32 & uptime)
+{
+    if (Frame.Calls > 0)
+    {
+        Frames++;
+        FrameTotal += Frame.Total;
+        if (Frame.Total > FrameMax) FrameMax = Frame.Total;
+
+        Recent.push_back (Frame);
+        if (Recent.size () > RECENT_FRAMES) Recent.pop_front ();
+    }
+
+    Frame = frame_stats (uptime);
+
+    if (DumpRequested)
+    {
+        DumpRequested = 0;
+        dump ();
+    }
+}
+
+// get name of a python callable for base::trace
+const char *profiler::trace_name (PyObject *callable)
+{
+    // bound methods are created anew for each call,
+    // but refer to the same function and class
+    PyObject *function = callable;
+    PyObject *owner = NULL;
+    if (PyMethod_Check (callable))
+    {
+        function = PyMethod_GET_FUNCTION (callable);
+        owner = PyMethod_GET_CLASS (callable);
+    }
+
+    std::pair<PyObject*, PyObject*> key (function, owner);
+    std::map<std::pair<PyObject*, PyObject*>, const char*>::const_iterator i = TraceNames.find (key);
+    if (i != TraceNames.end ()) return i->second;
+
+    std::string file, cls, method;
+    describe (callable, file, cls, method);
+    const char *name = base::trace::intern (cls.empty () ? method : cls + "." + method);
+
+    // keep function and class alive, so that no other 
+    // object can take their place in the cache
+    Py_INCREF (function);
+    Py_XINCREF (owner);
+    TraceNames[key] = name;
+
+    return name;
+}
+
+// get file, class and method name of a python callable
+void profiler::describe (PyObject *callable, std::string & file, std::string & cls, std::string & method)
+{
+    PyObject *function = callable;
+    if (PyMethod_Check (callable))
+    {
+        function = PyMethod_GET_FUNCTION (callable);
+
+        PyObject *owner = PyMethod_GET_CLASS (callable);
+        if (owner != NULL && PyClass_Check (owner))
+        {
+            cls = PyString_AsString (((PyClassObject *) owner)->cl_name);
+        }
+        else if (owner != NULL && PyType_Check (owner))
+        {
+            cls = ((PyTypeObject *) owner)->tp_name;
+        }
+    }
+
+    if (PyFunction_Check (function))
+    {
+        PyCodeObject *code = (PyCodeObject *) PyFunction_GET_CODE (function);
+        file = PyString_AsString (code->co_filename);
+        method = PyString_AsString (code->co_name);
+    }
+    else
+    {
+        method = Py_TYPE (function)->tp_name;
+    }
+}
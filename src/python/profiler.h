@@ -0,0 +1,218 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   python/profiler.h
+ * @author agent <agent@local>
+ *
+ * @brief  Declares the profiler for calls into Python.
+ *
+ *
+ */
+
+#ifndef PYTHON_PROFILER_H
+#define PYTHON_PROFILER_H
+
+#include <deque>
+#include <map>
+#include <ostream>
+
+#ifdef _POSIX_C_SOURCE
+#undef _POSIX_C_SOURCE
+#endif
+#ifdef _XOPEN_SOURCE
+#undef _XOPEN_SOURCE
+#endif
+
+#include <Python.h>
+#include <adonthell/base/trace.h>
+#include <adonthell/base/types.h>
+
+namespace base
+{
+    class configuration;
+}
+
+namespace python
+{
+    /**
+     * Measures the time spent in Python code called from the engine. When
+     * enabled, each call made through python::script, python::method or
+     * the Python callbacks is accounted to the (file, class, method) it
+     * ends up in, and the time spent in Python is summed up per frame.
+     *
+     * Times include nested calls, i.e. a method calling back into the
+     * engine, which in turn calls another script, is charged for both.
+     * Frame totals only count the outermost calls.
+     *
+     * The results can be written at any time with dump(). In addition,
+     * a dump is written whenever the process receives SIGUSR1, and when
+     * Python is shut down.
+     *
+     * Profiling is switched on with the "Profile" option of the "Python"
+     * section of the engine %configuration. When disabled, the cost is
+     * a single check per call.
+     */
+    class profiler
+    {
+    public:
+        /**
+         * Enable profiling according to the engine %configuration.
+         * @param cfg the engine %configuration.
+         */
+        static void setup (base::configuration & cfg);
+
+        /**
+         * Write results and disable the profiler.
+         */
+        static void cleanup ();
+
+        /**
+         * Start collecting data.
+         * @param file the file written by dump() when no other
+         *      destination is given.
+         */
+        static void enable (const std::string & file);
+
+        /**
+         * Stop collecting data. Data collected so far is kept.
+         */
+        static void disable ();
+
+        /**
+         * Drop all data collected so far.
+         */
+        static void reset ();
+
+        /**
+         * Return whether data is collected.
+         * @return \b true if the profiler is enabled.
+         */
+        static bool is_enabled () { return Enabled; }
+
+        /**
+         * Write collected data as JSON to the file given to enable().
+         * @return \b false if the file could not be written.
+         */
+        static bool dump ();
+
+        /**
+         * Write collected data as JSON. The result is an object with a
+         * "methods" list, holding file, class, method, number of calls,
+         * total and maximum time in microseconds for each method, and
+         * a "frames" object, holding the number of frames and the total
+         * and maximum time per frame, as well as the totals of the most
+         * recent frames as a list of [uptime, calls, time].
+         * @param out stream to write data to.
+         */
+        static void dump (std::ostream & out);
+
+#ifndef SWIG
+        /**
+         * @name Instrumentation
+         */
+        //@{
+        /**
+         * Call right before calling into Python. Calls are also
+         * recorded by base::trace, if enabled.
+         * @return start time of the call, or 0 if disabled.
+         */
+        static double start ()
+        {
+            return Enabled || base::trace::is_enabled () ? begin () : 0;
+        }
+
+        /**
+         * Call after calling into Python, if start() did not return 0.
+         * @param started the value returned by start().
+         * @param callable the Python object that has been called.
+         */
+        static void stop (const double & started, PyObject *callable);
+        //@}
+#endif // SWIG
+
+    private:
+        /// forbid instantiation
+        profiler ();
+
+        /// start timing a call
+        static double begin ();
+
+        /// current time in microseconds
+        static double now ();
+
+        /// account current frame and start a new one
+        static void next_frame (const u_int32 & uptime);
+
+        /// get file, class and method name of a python callable
+        static void describe (PyObject *callable, std::string & file, std::string & cls, std::string & method);
+
+        /// get name of a python callable for base::trace
+        static const char *trace_name (PyObject *callable);
+
+        /// statistics of a single method
+        struct method_stats
+        {
+            method_stats () : Calls (0), Total (0), Max (0) { }
+
+            /// number of calls
+            u_int32 Calls;
+            /// time spent in all calls
+            double Total;
+            /// time spent in the slowest call
+            double Max;
+        };
+
+        /// statistics of a single frame
+        struct frame_stats
+        {
+            frame_stats (const u_int32 & uptime = 0) : Uptime (uptime), Calls (0), Total (0) { }
+
+            /// uptime of the game timer during that frame
+            u_int32 Uptime;
+            /// number of top level calls
+            u_int32 Calls;
+            /// time spent in Python
+            double Total;
+        };
+
+        /// whether the profiler is collecting data
+        static bool Enabled;
+        /// default destination of dump ()
+        static std::string File;
+        /// number of calls currently in progress
+        static u_int32 Depth;
+        /// statistics per method, by file, class and method name
+        static std::map<std::string, std::map<std::string, std::map<std::string, method_stats> > > Methods;
+        /// the frame currently in progress
+        static frame_stats Frame;
+        /// the most recent frames
+        static std::deque<frame_stats> Recent;
+        /// number of frames with Python calls
+        static u_int32 Frames;
+        /// time spent in Python in all frames
+        static double FrameTotal;
+        /// time spent in Python in the slowest frame
+        static double FrameMax;
+        /// names of traced callables, by function and class
+        static std::map<std::pair<PyObject*, PyObject*>, const char*> TraceNames;
+    };
+}
+
+#endif // PYTHON_PROFILER_H
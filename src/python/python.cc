@@ -26,11 +26,17 @@
  * 
  */
 
+#include <map>
+
 #include "python.h"
 #include "pool.h"
+#include "profiler.h"
 
 namespace python
 {
+    /// SWIG type information, by address of the type name
+    static std::map<const char*, void*> TypeCache;
+
     // print stacktrace if a python error occurred
     void show_traceback ()
     {
@@ -62,7 +68,9 @@ namespace python
     // shutdown python interpreter
     void cleanup ()
     {
+        profiler::cleanup ();
         pool::cleanup ();
+        TypeCache.clear ();
         Py_Finalize ();
     }
 
@@ -110,7 +118,73 @@ namespace python
 
         return ret;
     }
-    
+
+    // create python object from C++ instance
+    PyObject *wrap_instance (void *instance, const char *name, const ownership own)
+    {
+        std::map<const char*, void*>::const_iterator type = TypeCache.find (name);
+        if (type == TypeCache.end ())
+        {
+            void *info = cxx_type_query (name);
+
+            // let cxx_to_py report the unknown type
+            if (info == NULL) return cxx_to_py (instance, name, own);
+
+            type = TypeCache.insert (std::make_pair (name, info)).first;
+        }
+
+        return cxx_to_py_type (instance, type->second, own);
+    }
+
+    // create python object for instance unless we already have one
+    PyObject *instance_wrapper::wrap (void *instance, const char *name)
+    {
+        if (Object == NULL || instance != Instance || name != Name || Py_REFCNT (Object) != 1)
+        {
+            Py_XDECREF (Object);
+            Object = wrap_instance (instance, name, c_owns);
+            Instance = instance;
+            Name = name;
+        }
+
+        Py_XINCREF (Object);
+        return Object;
+    }
+
+    // get tuple for passing arguments
+    PyObject *take_args (PyObject *& spare, const u_int16 & size)
+    {
+        PyObject *args = spare;
+        spare = NULL;
+
+        if (args == NULL || PyTuple_GET_SIZE (args) != size)
+        {
+            Py_XDECREF (args);
+            args = PyTuple_New (size);
+        }
+
+        return args;
+    }
+
+    // keep tuple for the next call, if possible
+    void recycle_args (PyObject *& spare, PyObject *args)
+    {
+        // still in use by python or a spare tuple already set by a nested call
+        if (Py_REFCNT (args) != 1 || spare != NULL)
+        {
+            Py_DECREF (args);
+            return;
+        }
+
+        for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE (args); i++)
+        {
+            PyObject *item = PyTuple_GET_ITEM (args, i);
+            PyTuple_SET_ITEM (args, i, NULL);
+            Py_XDECREF (item);
+        }
+        spare = args;
+    }
+
     // pad tuple
     PyObject *pad_tuple (PyObject *tuple, const u_int16 & len)
     {
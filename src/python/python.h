@@ -42,6 +42,8 @@
 
 extern "C" {
 	PyObject *cxx_to_py (void *instance, const char *name, const bool & ownership);
+	PyObject *cxx_to_py_type (void *instance, void *type, const bool & ownership);
+	void *cxx_type_query (const char *name);
 	void py_to_cxx (PyObject *instance, const char *name, void **retval);
 }
 
@@ -140,6 +142,21 @@ namespace python
      */
     typedef enum { c_owns = 0, python_owns = 1 } ownership;
 
+    /**
+     * Create a Python object from a pointer to a C++ object of the
+     * given type. The SWIG type information is looked up once for each
+     * type name and kept for later calls. Names are told apart by their
+     * address, so they must be string constants such as those returned
+     * by get_type_name.
+     *
+     * @param instance a pointer to the object to pass to Python.
+     * @param name name of the object's type.
+     * @param own ownership of the C++ object.
+     *
+     * @return a Python object representing \e instance.
+     */
+    PyObject * wrap_instance (void *instance, const char *name, const ownership own);
+
     /** 
      * Default version of pass_instance - it will fetch the name of the class
      * that is passed using a specialized version of get_type_name to create
@@ -153,7 +170,7 @@ namespace python
     template <class A> inline
     PyObject * pass_instance(A arg, const ownership own = c_owns)
     { 
-        return cxx_to_py ((void *) arg, arg->get_type_name(), own);
+        return wrap_instance ((void *) arg, arg->get_type_name(), own);
     }
     
     /** 
@@ -233,7 +250,56 @@ namespace python
         Py_DECREF(n);
         show_traceback();
     }
-    
+
+#ifndef SWIG
+    /**
+     * Keeps the Python object created for a C++ instance, so that
+     * passing the same instance again does not create a new object.
+     * Useful for events raised over and over from the same place.
+     * The object is only reused while nothing else refers to it.
+     */
+    class instance_wrapper
+    {
+    public:
+        /**
+         * Create an empty wrapper.
+         */
+        instance_wrapper () : Instance (NULL), Name (NULL), Object (NULL) { }
+
+        /**
+         * Destructor.
+         */
+        ~instance_wrapper () { Py_XDECREF (Object); }
+
+        /**
+         * Return a Python object representing the given instance,
+         * with ownership remaining with C++.
+         * @param arg a pointer to the object to pass to Python.
+         * @return a new reference to the Python object.
+         */
+        template <class A>
+        PyObject * wrap (A arg)
+        {
+            return wrap ((void *) arg, arg->get_type_name ());
+        }
+
+    private:
+        /// forbid copying
+        instance_wrapper (const instance_wrapper & w);
+        instance_wrapper & operator= (const instance_wrapper & w);
+
+        /// return object for instance of given type
+        PyObject * wrap (void *instance, const char *name);
+
+        /// instance represented by Object
+        void *Instance;
+        /// type of Instance
+        const char *Name;
+        /// the Python object last created
+        PyObject *Object;
+    };
+#endif // SWIG
+
     //@}
 
     /**
@@ -335,6 +401,28 @@ namespace python
      * @return a new tuple or NULL on error.
      */
     PyObject *pad_tuple (PyObject *tuple, const u_int16 & len);
+
+    /**
+     * Get a tuple of the given size for passing arguments to Python.
+     * The spare tuple is handed out if it has the right size, otherwise
+     * a new one is created. Either way, the caller owns the result
+     * and must fill all of its items with PyTuple_SET_ITEM.
+     *
+     * @param spare tuple kept by the caller between calls, or NULL.
+     * @param size number of arguments.
+     * @return a tuple of the given size.
+     */
+    PyObject *take_args (PyObject *& spare, const u_int16 & size);
+
+    /**
+     * Return a tuple obtained from take_args once the call is done.
+     * If Python did not keep a reference to it, its items are released
+     * and it becomes the spare tuple for the next call.
+     *
+     * @param spare tuple kept by the caller between calls.
+     * @param args the tuple to give back.
+     */
+    void recycle_args (PyObject *& spare, PyObject *args);
     
     /**
      * Read the contents of a tuple from given stream.
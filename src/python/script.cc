@@ -32,16 +32,24 @@
  */
 
 #include "script.h"
+#include "profiler.h"
 
 using python::script;
 using std::string;
 
+// method cache identifiers, 0 being reserved for unused handles
+u_int32 script::NextGeneration = 1;
+
+// attribute lookups since last queried
+u_int32 script::Lookups = 0;
+
 script::script ()
 {
     Instance = NULL;
     Filename = "";
     Classname = "";
     Args = NULL;
+    Generation = NextGeneration++;
 }
 
 script::~script ()
@@ -52,6 +60,9 @@ script::~script ()
 // Cleanup (and re-initialisation)
 void script::clear ()
 {
+    // cached methods refer to the instance
+    flush_methods ();
+
     // Delete our Instance
     Py_XDECREF (Instance);
     Py_XDECREF (Args);
@@ -127,28 +138,101 @@ PyObject* script::call_method_ret (const string &name, PyObject *args) const
 
     if (Instance)
     {
-        PyObject *tocall = PyObject_GetAttrString (Instance, (char *) name.c_str ());
-
-        if (PyCallable_Check (tocall) == 1)
+        PyObject *tocall = get_method (name.c_str ());
+        if (tocall != NULL)
         {
+            // the method might flush the cache while it runs
+            Py_INCREF (tocall);
+            double started = profiler::start ();
             result = PyObject_CallObject (tocall, args);
+            if (started) profiler::stop (started, tocall);
             if (!result) python::show_traceback ();
+            Py_DECREF (tocall);
         }
-        else
+    }
+
+    return result;
+}
+
+// Execute a method of the script by handle
+PyObject* script::call_method_ret (method_handle & method, PyObject *args) const
+{
+    PyObject *result = NULL;
+
+    if (Instance)
+    {
+        // method cache changed since the handle was used last
+        if (method.Generation != Generation)
+        {
+            method.Method = get_method (method.Name);
+            method.Generation = method.Method ? Generation : 0;
+        }
+
+        if (method.Method != NULL)
         {
-            LOG(ERROR) << "script::call_method_ret: '" << name << "' is not callable!";
+            // the method might flush the cache while it runs
+            PyObject *tocall = method.Method;
+            Py_INCREF (tocall);
+            double started = profiler::start ();
+            result = PyObject_CallObject (tocall, args);
+            if (started) profiler::stop (started, tocall);
+            if (!result) python::show_traceback ();
+            Py_DECREF (tocall);
         }
-        Py_DECREF (tocall);
     }
 
     return result;
 }
 
+// get method from cache or instance
+PyObject *script::get_method (const char *name) const
+{
+    std::map<std::string, PyObject*>::const_iterator i = Methods.find (name);
+    if (i != Methods.end ()) return i->second;
+
+    Lookups++;
+    PyObject *tocall = PyObject_GetAttrString (Instance, (char *) name);
+    if (PyCallable_Check (tocall) != 1)
+    {
+        LOG(ERROR) << "script::call_method_ret: '" << name << "' is not callable!";
+        Py_XDECREF (tocall);
+        PyErr_Clear ();
+        return NULL;
+    }
+
+    Methods[name] = tocall;
+    return tocall;
+}
+
+// forget cached methods
+void script::flush_methods ()
+{
+    for (std::map<std::string, PyObject*>::iterator i = Methods.begin (); i != Methods.end (); i++)
+    {
+        Py_DECREF (i->second);
+    }
+    Methods.clear ();
+
+    // invalidate all handles to the cached methods
+    Generation = NextGeneration++;
+}
+
+// number of attribute lookups since last call
+u_int32 script::lookups ()
+{
+    u_int32 result = Lookups;
+    Lookups = 0;
+    return result;
+}
+
 // check for a certain attribute
 bool script::has_attribute (const string & name) const
 {
     if (Instance)
+    {
+        Lookups++;
         return PyObject_HasAttrString (Instance, (char *) name.c_str ());
+    }
     else
         return false;
 }
@@ -157,7 +241,10 @@ bool script::has_attribute (const string & name) const
 PyObject *script::get_attribute (const string &name) const
 {
     if (Instance)
+    {
+        Lookups++;
         return PyObject_GetAttrString (Instance, (char *) name.c_str ());
+    }
     else
         return NULL;
 }
@@ -167,6 +254,7 @@ s_int32 script::get_attribute_int (const string &name) const
 {
     if (Instance)
     {
+        Lookups++;
         PyObject *attribute = PyObject_GetAttrString (Instance, (char *) name.c_str ());
         if (!attribute) return 0;
 
@@ -184,6 +272,7 @@ string script::get_attribute_string (const string &name) const
 {
     if (Instance)
     {
+        Lookups++;
         PyObject *attribute = PyObject_GetAttrString (Instance, (char *) name.c_str ());
         if (!attribute) return 0;
 
@@ -201,6 +290,8 @@ void script::set_attribute (const string &name, PyObject *value)
 {
     if (Instance)
     {
+        // the attribute might replace a method
+        flush_methods ();
         if (PyObject_SetAttrString (Instance, (char *) name.c_str (), value) == -1)
             python::show_traceback ();
     }
@@ -213,6 +304,7 @@ void script::set_attribute_int (const string &name, s_int32 value)
     if (Instance)
     {
         PyObject *val = PyInt_FromLong (value);
+        flush_methods ();
 
         if (PyObject_SetAttrString (Instance, (char *) name.c_str (), val) == -1)
             python::show_traceback ();
@@ -227,6 +319,7 @@ void script::set_attribute_string (const string &name, const string & value)
     if (Instance)
     {
         PyObject *val = PyString_FromString (value.c_str ());
+        flush_methods ();
 
         if (PyObject_SetAttrString (Instance, (char *) name.c_str (), val) == -1)
             python::show_traceback ();
@@ -33,6 +33,7 @@
 #ifndef PYTHON_SCRIPT_H
 #define PYTHON_SCRIPT_H
                    
+#include <map>
 #include "python.h"
 
 namespace python 
@@ -49,6 +50,35 @@ namespace python
     class script
     {
     public:
+#ifndef SWIG
+        /**
+         * A method of a %script that is called very often, such as from the
+         * update loop of the game. It is looked up once and then called
+         * directly. Handles stay valid when the %script instance changes, as
+         * the method is looked up again when necessary.
+         */
+        class method_handle
+        {
+        public:
+            /**
+             * Create a handle for the method of given name.
+             * @param name name of the method. Must remain valid as long
+             *      as the handle exists, e.g. a string constant.
+             */
+            method_handle (const char *name) : Name (name), Method (NULL), Generation (0) { }
+
+        private:
+            friend class script;
+
+            /// name of the method
+            const char *Name;
+            /// the method, borrowed from the script's method cache
+            PyObject *Method;
+            /// the method cache the method has been taken from
+            u_int32 Generation;
+        };
+#endif // SWIG
+
         /** 
          * Default constructor.
          * 
@@ -99,7 +129,10 @@ namespace python
          */
         //@{
         /** 
-         * Call a method of this object.
+         * Call a method of this object. Methods are looked up once and
+         * cached until the instance changes or an attribute is assigned
+         * through this class. Methods replaced from within Python are
+         * not noticed.
          * 
          * @param name name of the method to call.
          * @param args Python tuple containing the arguments to pass to the method.
@@ -119,6 +152,30 @@ namespace python
             PyObject *result = call_method_ret (name, args);
             Py_XDECREF (result);
         }
+
+#ifndef SWIG
+        /** 
+         * Call a method of this object without looking it up by name.
+         * 
+         * @param method handle of the method to call.
+         * @param args Python tuple containing the arguments to pass to the method.
+         * @return the return value of the method as PyObject. Needs to be 
+         *     Py_DECREF'd when no longer needed.
+         */
+        PyObject *call_method_ret (method_handle & method, PyObject *args = NULL) const;
+
+        /** 
+         * Call a method of this object without looking it up by name.
+         * 
+         * @param method handle of the method to call.
+         * @param args Python tuple containing the arguments to pass to the method.
+         */
+        void call_method (method_handle & method, PyObject * args = NULL) const
+        {
+            PyObject *result = call_method_ret (method, args);
+            Py_XDECREF (result);
+        }
+#endif // SWIG
         //@}
     
         /**
@@ -255,6 +312,19 @@ namespace python
          */
         bool get_state (base::flat& record);
         //@}
+
+        /**
+         * @name Profiling
+         */
+        //@{
+        /**
+         * Return the number of attributes looked up on Python instances
+         * since the last call to this method. Calling it once per frame
+         * gives the number of lookups each frame requires.
+         * @return number of attribute lookups.
+         */
+        static u_int32 lookups ();
+        //@}
                 
 #ifndef SWIG
         /// allow script to be passed through SWIG
@@ -268,6 +338,31 @@ namespace python
     private:
         /// Helper for create_instance and reload_instance
         bool instantiate (PyObject*, const std::string &, const std::string &, PyObject*);
+
+        /**
+         * Return the method of given name, looking it up only if
+         * it is not cached yet.
+         * @param name name of the method.
+         * @return borrowed reference to the method, or NULL on error.
+         */
+        PyObject *get_method (const char *name) const;
+
+        /**
+         * Forget all methods looked up so far.
+         */
+        void flush_methods ();
+
+        /// Methods called so far
+        mutable std::map<std::string, PyObject*> Methods;
+
+        /// Identifies the current contents of the method cache
+        u_int32 Generation;
+
+        /// Source of unique method cache identifiers
+        static u_int32 NextGeneration;
+
+        /// Number of attribute lookups since last queried
+        static u_int32 Lookups;
     
         /// The class name of the current script
         std::string Classname;
@@ -17,10 +17,13 @@
    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <sstream>
 #include <adonthell/base/logging.h>
 #include <gtest/gtest.h>
 
 #include "python.h"
+#include "method.h"
+#include "profiler.h"
 
 namespace python
 {
@@ -80,6 +83,189 @@ namespace python
         EXPECT_EQ(arg1, PyTuple_GET_ITEM(res, 2));
         EXPECT_EQ(arg2, PyTuple_GET_ITEM(res, 3));
     }
+
+    TEST_F(python_Test, cached_methods)
+    {
+        python::run_simple_string (
+            "import sys, imp\n"
+            "m = imp.new_module ('test_script')\n"
+            "exec '''\n"
+            "class counter:\n"
+            "    def __init__ (self): self.calls = 0\n"
+            "    def count (self): self.calls += 1\n"
+            "class doubler (counter):\n"
+            "    def count (self): self.calls += 2\n"
+            "''' in m.__dict__\n"
+            "sys.modules['test_script'] = m\n");
+
+        script s;
+        ASSERT_TRUE(s.create_instance ("test_script", "counter"));
+        script::lookups ();
+
+        // methods are looked up once, whether called by name or handle
+        script::method_handle count ("count");
+        for (int i = 0; i < 10; i++)
+        {
+            s.call_method ("count");
+            s.call_method (count);
+        }
+        EXPECT_EQ(20, s.get_attribute_int ("calls"));
+        EXPECT_EQ(2u, script::lookups ());
+
+        // assigning attributes forgets the methods
+        s.set_attribute_int ("calls", 0);
+        s.call_method (count);
+        s.call_method ("count");
+        EXPECT_EQ(1u, script::lookups ());
+        EXPECT_EQ(2, s.get_attribute_int ("calls"));
+
+        // handles follow a change of instance
+        ASSERT_TRUE(s.create_instance ("test_script", "doubler"));
+        s.call_method (count);
+        EXPECT_EQ(2, s.get_attribute_int ("calls"));
+
+        // missing methods are reported every time
+        script::method_handle missing ("missing");
+        EXPECT_EQ(NULL, s.call_method_ret (missing));
+        EXPECT_EQ(NULL, s.call_method_ret ("missing"));
+        EXPECT_EQ(NULL, PyErr_Occurred ());
+    }
+
+    TEST_F(python_Test, reused_args)
+    {
+        PyObject *spare = NULL;
+
+        PyObject *args = python::take_args (spare, 2);
+        ASSERT_EQ(2, PyTuple_GET_SIZE(args));
+        EXPECT_EQ(NULL, spare);
+
+        PyObject *item = PyList_New (0);
+        Py_INCREF (item);
+        PyTuple_SET_ITEM (args, 0, item);
+        PyTuple_SET_ITEM (args, 1, PyInt_FromLong (1));
+
+        // tuple is emptied and kept ...
+        python::recycle_args (spare, args);
+        EXPECT_EQ(args, spare);
+        EXPECT_EQ(NULL, PyTuple_GET_ITEM(args, 0));
+        EXPECT_EQ(1, Py_REFCNT(item));
+        Py_DECREF (item);
+
+        // ... and handed out again for the same size
+        EXPECT_EQ(args, python::take_args (spare, 2));
+        PyTuple_SET_ITEM (args, 0, PyInt_FromLong (2));
+        PyTuple_SET_ITEM (args, 1, PyInt_FromLong (3));
+
+        // unless python still refers to it
+        Py_INCREF (args);
+        python::recycle_args (spare, args);
+        EXPECT_EQ(NULL, spare);
+        EXPECT_EQ(2, PyInt_AsLong (PyTuple_GET_ITEM(args, 0)));
+        Py_DECREF (args);
+
+        // other sizes get a new tuple
+        args = python::take_args (spare, 1);
+        PyTuple_SET_ITEM (args, 0, PyInt_FromLong (4));
+        python::recycle_args (spare, args);
+        PyObject *other = python::take_args (spare, 3);
+        EXPECT_EQ(3, PyTuple_GET_SIZE(other));
+        EXPECT_EQ(NULL, spare);
+        Py_DECREF (other);
+    }
+
+    TEST_F(python_Test, method_execute)
+    {
+        python::run_simple_string (
+            "import sys, imp\n"
+            "m = imp.new_module ('test_method')\n"
+            "exec '''\n"
+            "class adder:\n"
+            "    def __init__ (self): self.total = 0\n"
+            "    def add (self, a, b): self.total += a * b\n"
+            "''' in m.__dict__\n"
+            "sys.modules['test_method'] = m\n");
+
+        script s;
+        ASSERT_TRUE(s.create_instance ("test_method", "adder"));
+
+        python::method add (&s, "add");
+        EXPECT_EQ("add", add.name ());
+
+        PyObject *args = PyTuple_New (2);
+        PyTuple_SET_ITEM (args, 0, PyInt_FromLong (2));
+        PyTuple_SET_ITEM (args, 1, PyInt_FromLong (3));
+        for (int i = 0; i < 10; i++)
+        {
+            EXPECT_TRUE(add.execute (args));
+        }
+        EXPECT_EQ(60, s.get_attribute_int ("total"));
+
+        // wrong arguments are reported
+        PyObject *few = PyTuple_New (0);
+        EXPECT_FALSE(add.execute (few));
+        EXPECT_TRUE(add.execute (args));
+        EXPECT_EQ(66, s.get_attribute_int ("total"));
+        EXPECT_EQ(1, Py_REFCNT(args));
+
+        Py_DECREF (few);
+        Py_DECREF (args);
+    }
+
+    TEST_F(python_Test, profiler)
+    {
+        python::run_simple_string (
+            "import sys, imp\n"
+            "m = imp.new_module ('test_profile')\n"
+            "exec '''\n"
+            "class counter:\n"
+            "    def __init__ (self): self.calls = 0\n"
+            "    def count (self): self.calls += 1\n"
+            "''' in m.__dict__\n"
+            "sys.modules['test_profile'] = m\n");
+
+        script s;
+        ASSERT_TRUE(s.create_instance ("test_profile", "counter"));
+        python::method count (&s, "count");
+
+        // nothing recorded while disabled
+        s.call_method ("count");
+        std::ostringstream out;
+        python::profiler::dump (out);
+        EXPECT_EQ(std::string::npos, out.str ().find ("\"method\": \"count\""));
+
+        python::profiler::enable ("");
+        s.call_method ("count");
+        s.call_method ("count");
+        EXPECT_TRUE(count.execute (NULL));
+        python::profiler::disable ();
+        s.call_method ("count");
+
+        out.str ("");
+        python::profiler::dump (out);
+        EXPECT_NE(std::string::npos, out.str ().find ("\"class\": \"counter\", \"method\": \"count\", \"calls\": 3,")) << out.str ();
+        EXPECT_EQ(5, s.get_attribute_int ("calls"));
+
+        python::profiler::reset ();
+        out.str ("");
+        python::profiler::dump (out);
+        EXPECT_EQ(std::string::npos, out.str ().find ("\"method\": \"count\""));
+
+        // calls are traced even if the profiler is disabled
+        base::trace::enable ("");
+        s.call_method ("count");
+        s.call_method ("count");
+        base::trace::disable ();
+
+        out.str ("");
+        base::trace::dump (out);
+        std::string::size_type first = out.str ().find ("\"name\": \"counter.count\"");
+        EXPECT_NE(std::string::npos, first) << out.str ();
+        EXPECT_NE(first, out.str ().rfind ("\"name\": \"counter.count\"")) << out.str ();
+
+        out.str ("");
+        python::profiler::dump (out);
+        EXPECT_EQ(std::string::npos, out.str ().find ("\"method\": \"count\""));
+    }
     
 } // namespace{}
 
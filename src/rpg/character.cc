@@ -191,7 +191,7 @@ bool character::load ()
     while (file.next ((void**) &data, &size, &id) == base::flat::T_FLAT)
     {
         c = new character ();
-        base::flat record (data, size); 
+        base::flat_view record (data, size);
         if (c->get_state(record))
         {
             // loading successful
@@ -295,7 +295,7 @@ bool character::get_state (base::flat & file)
     Base_Speed = file.get_float ("cspd");
 
     void *data;
-    base::flat factions = file.get_flat("cfct");
+    base::flat_view factions (file, "cfct");
     // iterate over all saved factions
     while (factions.next ((void**) &data, NULL, NULL) == base::flat::T_STRING)
     {
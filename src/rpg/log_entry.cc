@@ -58,7 +58,7 @@ void log_entry::put_state (base::flat & file) const
 // load log entry
 bool log_entry::get_state (base::flat & file)
 {
-    base::flat record = file.get_flat ("le");
+    base::flat_view record (file, "le");
     if (!file.success ()) return false;
     
     Timestamp = record.get_uint32 ("let");
@@ -240,7 +240,7 @@ void quest_part::put_state (base::flat & file) const
 // load quest part
 bool quest_part::get_state (base::flat & file)
 {
-    base::flat record = file.get_flat ("q");
+    base::flat_view record (file, "q");
     if (!file.success ()) return false;
 
 	// id needs to be loaded only for quest root 
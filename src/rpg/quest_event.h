@@ -118,6 +118,15 @@ namespace rpg
             return "quest_event";
         }
 
+        /**
+         * Create a copy of this %event for deferred dispatch.
+         * @return a new copy of this %event.
+         */
+        events::event *clone () const
+        {
+            return new quest_event (*this);
+        }
+
 		/**
 		 * Get an iterator pointing to the first level of the pattern. 
 		 * Used by quest event manager to store and compare quest events 
@@ -26,6 +26,10 @@
  *
  */
 
+#include <adonthell/base/flat_stream.h>
+#include <adonthell/base/thread_pool.h>
+#include <adonthell/base/trace.h>
+
 #include "area.h"
 #include "character.h"
 #include "object.h"
@@ -38,6 +42,7 @@ using world::area;
 area::~area()
 {
     clear();
+    delete Pool;
 }
 
 // delete all entities
@@ -51,6 +56,8 @@ void area::clear()
 
     Entities.clear();
     NamedEntities.clear();
+    UniqueIndex.clear();
+    Active.clear();
 
     // delete all the zones
     std::list<world::zone *>::const_iterator a;
@@ -80,14 +87,107 @@ world::chunk_info *area::place_entity (const s_int32 & index, coordinates & pos)
 // update state of map
 void area::update()
 {
-    std::vector<world::entity*>::const_iterator i;
-    for (i = Entities.begin(); i != Entities.end(); i++)
+    base::trace::zone zone ("area::update");
+    std::set<u_int32>::iterator i;
+    NumActive = 0;
+
+    if (Pool == NULL)
+    {
+        i = Active.begin();
+        while (i != Active.end())
+        {
+            placeable *object = Entities[*i]->get_object();
+            object->update();
+            NumActive++;
+
+            // skip object until it is woken up again
+            if (object->is_idle()) Active.erase (i++);
+            else i++;
+        }
+        return;
+    }
+
+    // prepare objects for moving
+    for (i = Active.begin(); i != Active.end(); i++)
+    {
+        placeable *object = Entities[*i]->get_object();
+        world::moving *mover = dynamic_cast<world::moving*> (object);
+        if (mover != NULL)
+        {
+            mover->begin_update ();
+            Moving.push_back (mover);
+        }
+        else
+        {
+            object->update();
+        }
+        NumActive++;
+    }
+
+    // calculate new positions in parallel
+    base::functor_1<u_int32> *task = base::make_functor (*this, &area::plan_move);
+    Pool->run (Moving.size (), *task);
+    delete task;
+
+    // apply the moves in order
+    for (std::vector<world::moving*>::const_iterator m = Moving.begin(); m != Moving.end(); m++)
+    {
+        (*m)->move ();
+        (*m)->end_update ();
+    }
+
+    Moving.clear ();
+
+    // skip idle objects until they are woken up again
+    i = Active.begin();
+    while (i != Active.end())
+    {
+        if (Entities[*i]->get_object()->is_idle()) Active.erase (i++);
+        else i++;
+    }
+}
+
+// update object during next frame
+void area::wake (const placeable *object)
+{
+    std::map<const placeable*, u_int32>::const_iterator i = UniqueIndex.find (object);
+    if (i != UniqueIndex.end())
     {
-        if ((*i)->is_unique())
-            (*i)->get_object()->update();
+        Active.insert (i->second);
     }
 }
 
+// calculate new position of a moving object
+void area::plan_move (u_int32 index)
+{
+    base::trace::zone zone ("area::plan_move");
+    Moving[index]->plan_move ();
+}
+
+// set number of threads for updating the map
+void area::set_update_threads (const u_int32 & threads)
+{
+    if (threads == 0)
+    {
+        delete Pool;
+        Pool = NULL;
+        return;
+    }
+
+    if (Pool == NULL)
+    {
+        Pool = new base::thread_pool ();
+    }
+
+    Pool->resize (threads - 1);
+}
+
+// get number of threads for updating the map
+u_int32 area::update_threads () const
+{
+    return Pool == NULL ? 0 : Pool->size () + 1;
+}
+
 // get entity at given index
 placeable * area::get_entity (const s_int32 & index) const
 {
@@ -137,6 +237,13 @@ s_int32 area::add_entity (entity * ety)
     
     // this list contains a copy of all entities, named or not.
     Entities.push_back (ety);
+
+    // unique entities are updated until they become idle
+    if (ety->is_unique())
+    {
+        UniqueIndex[ety->get_object()] = Entities.size() - 1;
+        Active.insert (Entities.size() - 1);
+    }
     
     // return index of newly added entity
     return Entities.size() - 1;
@@ -215,35 +322,49 @@ std::vector<world::zone*> area::find_zones (const world::vector3<s_int32> & poin
 // save to stream
 bool area::put_state (base::flat & file) const
 {
-    base::flat record;
-    
-    // list of map(interactions)
-    base::flat action_list;
+    // nested lists are written as they are filled, so that streamed 
+    // records need only keep one entry in memory at a time
+    u_int32 list;
+    std::vector<chunk_info*>::const_iterator j;
     
     // gather all different placeables and their locations on the map
     collector objects;
     chunk::put_state (objects);
 
     // first pass: save placeable models
+    list = file.begin_flat ("objects");
     for (collector::const_iterator i = objects.begin(); i != objects.end(); i++)
     {
         base::flat entity;
         const world::placeable *data = i->first;
         data->save_model (entity);
         
-        record.put_flat (data->hash(), entity);
+        file.put_flat (data->hash(), entity);
     }
-    file.put_flat ("objects", record);
+    file.end_flat (list);
 
-    // reset
-    record.clear();
+    // second pass: save map(interactions)
+    list = file.begin_flat ("actions");
+    for (collector::const_iterator i = objects.begin(); i != objects.end(); i++)
+    {
+        const collector_data & data = i->second;
+        for (j = data.Anonymous.begin(); j != data.Anonymous.end(); j++)
+        {
+            put_action (file, *j);
+        }
+        for (j = data.Named.begin(); j != data.Named.end(); j++)
+        {
+            put_action (file, *j);
+        }
+    }
+    file.end_flat (list);
 
-    // second pass: save entities and their positions and actions
+    // third pass: save entities and their positions
+    list = file.begin_flat ("entities");
     for (collector::const_iterator i = objects.begin(); i != objects.end(); i++)
     {
         base::flat entity;
         const collector_data & data = i->second;
-        std::vector<chunk_info*>::const_iterator j;
 
         // save anonymous objects
         if (!data.Anonymous.empty())
@@ -251,12 +372,9 @@ bool area::put_state (base::flat & file) const
             base::flat anonym;
             for (j = data.Anonymous.begin(); j != data.Anonymous.end(); j++)
             {
-                // save location action
+                // refer to location action
                 if ((*j)->has_action ())
                 {
-                    base::flat actn_data;
-                    (*j)->get_action()->put_state (actn_data);
-                    action_list.put_flat ((*j)->get_action()->hash(), actn_data);
                     anonym.put_string ("action", (*j)->get_action()->hash());
                 }
                 ((*j)->Min - (*j)->get_object()->entire_min()).put_state (anonym);
@@ -271,12 +389,9 @@ bool area::put_state (base::flat & file) const
             base::flat named;
             for (j = data.Named.begin(); j != data.Named.end(); j++)
             {
-                // save location action
+                // refer to location action
                 if ((*j)->has_action ())
                 {
-                    base::flat actn_data;
-                    (*j)->get_action()->put_state (actn_data);
-                    action_list.put_flat ((*j)->get_action()->hash(), actn_data);
                     named.put_string ("action", (*j)->get_action()->hash());
                 }
                 named.put_string ("id", *((*j)->get_entity()->id()));
@@ -286,41 +401,44 @@ bool area::put_state (base::flat & file) const
             entity.put_flat ("named", named);
         }
 
-        record.put_flat (i->first->hash(), entity);
+        file.put_flat (i->first->hash(), entity);
     }
-    file.put_flat ("actions", action_list);
-    file.put_flat ("entities", record);
-
-    // reset
-    record.clear();
+    file.end_flat (list);
     
-    // third pass: save placeable states
+    // fourth pass: save placeable states
+    list = file.begin_flat ("states");
     for (collector::const_iterator i = objects.begin(); i != objects.end(); i++)
     {
         base::flat entity;
         const world::placeable * data = i->first;
         data->put_state (entity);
         
-        record.put_flat (data->hash(), entity);
+        file.put_flat (data->hash(), entity);
     }
-    
-    file.put_flat ("states", record);
+    file.end_flat (list);
 
     // save the zones
-    std::list <world::zone *>::const_iterator zone_i = Zones.begin();
-    base::flat zone_list;
-
-    while (zone_i != Zones.end())
+    list = file.begin_flat ("zones");
+    for (std::list <world::zone *>::const_iterator zone_i = Zones.begin(); zone_i != Zones.end(); ++zone_i)
     {
-        (*zone_i)->put_state (zone_list);
-        ++zone_i;
+        (*zone_i)->put_state (file);
     }
-
-    file.put_flat ("zones", zone_list);
+    file.end_flat (list);
 
     return true;
 }
 
+// save location action
+void area::put_action (base::flat & file, const chunk_info *ci) const
+{
+    if (ci->has_action ())
+    {
+        base::flat actn_data;
+        ci->get_action()->put_state (actn_data);
+        file.put_flat (ci->get_action()->hash(), actn_data);
+    }
+}
+
 // load from stream
 bool area::get_state (base::flat & file)
 {
@@ -335,12 +453,12 @@ bool area::get_state (base::flat & file)
     
     // load placeable models
     std::hash_map<std::string, placeable*> tmp_objects;
-    base::flat record = file.get_flat ("objects");
+    base::flat_view objects (file, "objects");
     
     // iterate over map objects
-    while (record.next (&value, &size, &id) == base::flat::T_FLAT)
+    while (objects.next (&value, &size, &id) == base::flat::T_FLAT)
     {
-        base::flat entity ((const char*) value, size);
+        base::flat_view entity (value, size);
         s_int8 type = entity.get_sint8("type");
 
         // TODO: maybe generalize the event factory code (events::types) and use here as well
@@ -378,23 +496,26 @@ bool area::get_state (base::flat & file)
     }
 
     // load actions, if any
-    base::flat action_list = file.get_flat ("actions");
+    base::flat_view action_list (file, "actions");
+
+    // objects are placed on the map all at once, when everything is loaded
+    std::vector<chunk_info*> placed;
 
     // load entities
-    record = file.get_flat ("entities");
-    while (record.next (&value, &size, &id) == base::flat::T_FLAT)
+    base::flat_view entities (file, "entities");
+    while (entities.next (&value, &size, &id) == base::flat::T_FLAT)
     {
         object = tmp_objects[id];
         if (object == NULL) continue;
         
         s_int32 ety_idx = -1;
-        base::flat entity ((const char*) value, size);
+        base::flat_view entity (value, size);
         
         // try loading anonymous entities
-        base::flat entity_data = entity.get_flat ("anonym", true);
+        base::flat_view anonym (entity, "anonym", true);
 
         // iterate over entity positions
-        while (entity_data.next (&value, &size, &id) != base::flat::T_UNKNOWN)
+        while (anonym.next (&value, &size, &id) != base::flat::T_UNKNOWN)
         {
             // load action associated to location, if any
             if (strcmp ("action", id) == 0)
@@ -403,7 +524,7 @@ bool area::get_state (base::flat & file)
                 actn_id = ((const char*) value);
                 
                 // read next value
-                entity_data.next (&value, &size, &id);
+                anonym.next (&value, &size, &id);
             }
             
             // get coordinate
@@ -418,12 +539,13 @@ bool area::get_state (base::flat & file)
             }
 
             // place entity at current index at given coordinate
-            chunk_info *ci = place_entity (ety_idx, pos);
+            chunk_info *ci = chunk::create_info (Entities[ety_idx], pos);
+            placed.push_back (ci);
             
             // location has an action assigned
             if (actn_id != "")
             {
-                base::flat actn_data = action_list.get_flat (actn_id);
+                base::flat_view actn_data (action_list, actn_id);
                 world::action *actn = ci->set_action (actn_id);
                 actn->get_state (actn_data);
                 actn_id = "";
@@ -431,9 +553,9 @@ bool area::get_state (base::flat & file)
         }
 
         // try loading named entities
-        entity_data = entity.get_flat ("named", true);
+        base::flat_view named (entity, "named", true);
         // iterate over object positions
-        while (entity_data.next (&value, &size, &id) != base::flat::T_UNKNOWN)
+        while (named.next (&value, &size, &id) != base::flat::T_UNKNOWN)
         {
             // load action associated to location, if any
             if (strcmp ("action", id) == 0)
@@ -442,25 +564,27 @@ bool area::get_state (base::flat & file)
                 actn_id = ((const char*) value);
                 
                 // read next value
-                entity_data.next (&value, &size, &id);
+                named.next (&value, &size, &id);
             }
             
             // first get id of entity
             std::string entity_name ((const char*) value);
 
             // then get coordinate
-            entity_data.next (&value, &size, &id);
+            named.next (&value, &size, &id);
             pos.set_str (std::string ((const char*) value, size));
             
             // create a named instance (that will be unique if it is the first, shared otherwise) ...
             world::entity *ety = new world::named_entity (object, entity_name, ety_idx == -1);
             // ... and place it on the map
-            chunk_info *ci = place_entity ((ety_idx = add_entity (ety)), pos);
+            ety_idx = add_entity (ety);
+            chunk_info *ci = chunk::create_info (ety, pos);
+            placed.push_back (ci);
             
             // location has an action assigned
             if (actn_id != "")
             {
-                base::flat actn_data = action_list.get_flat (actn_id);
+                base::flat_view actn_data (action_list, actn_id);
                 world::action *actn = ci->set_action (actn_id);
                 actn->get_state (actn_data);
                 actn_id = "";
@@ -489,22 +613,25 @@ bool area::get_state (base::flat & file)
         }
     }
     
+    // build the tree of chunks in one go
+    chunk::add (placed);
+
     // load placeable states
-    record = file.get_flat ("states");
-    while (record.next (&value, &size, &id) == base::flat::T_FLAT)
+    base::flat_view states (file, "states");
+    while (states.next (&value, &size, &id) == base::flat::T_FLAT)
     {
         object = tmp_objects[id];
         if (object == NULL) continue;
         
-        base::flat entity ((const char*) value, size);
+        base::flat_view entity (value, size);
         object->get_state (entity);
     }
     
     // load zones
-    record = file.get_flat ("zones");
-    while (record.next (&value, &size, &id) == base::flat::T_FLAT)
+    base::flat_view zones (file, "zones");
+    while (zones.next (&value, &size, &id) == base::flat::T_FLAT)
     {
-        base::flat zone = base::flat ((const char*) value, size);
+        base::flat_view zone (value, size);
         world::zone * temp_zone = new world::zone(id);
         temp_zone->get_state (zone);
         add_zone (temp_zone);
@@ -516,6 +643,22 @@ bool area::get_state (base::flat & file)
 // save to file
 bool area::save (const std::string & fname, const base::diskio::file_format & format)
 {
+    // write binary maps while they are being serialized, unless
+    // writing is deferred to the background
+    if (!base::diskio::is_deferred () && (format == base::diskio::GZ_FILE ||
+        (format == base::diskio::BY_EXTENSION &&
+         base::diskio::format_for_extension (fname) == base::diskio::GZ_FILE)))
+    {
+        base::flat_stream stream;
+        if (stream.open (fname) && put_state (stream) && stream.close ())
+        {
+            return true;
+        }
+
+        LOG(ERROR) << "area::save: saving '" << fname << "' failed!";
+        return false;
+    }
+
     base::diskio record (format);
 
     // try to save map to disk
@@ -541,3 +684,11 @@ bool area::load (const std::string & fname)
 
     return record.get_record (fname) && get_state (record);
 }
+
+// load from record read earlier
+bool area::load (const std::string & fname, base::flat & record)
+{
+    Filename = fname;
+
+    return get_state (record);
+}
@@ -31,17 +31,27 @@
 #ifndef WORLD_AREA_H
 #define WORLD_AREA_H
 
+#include <map>
+#include <set>
+
 #include <adonthell/base/hash_map.h>
 #include <adonthell/base/diskio.h>
 
 #include "chunk.h"
 #include "zone.h"
 
+namespace base
+{
+    class thread_pool;
+}
+
 /**
  * The graphical representation of the game %world is implemented by this module.
  */
 namespace world
 {
+    class moving;
+
     /**
      * The plane of existance. It keeps track of all the scenery elements, characters
      * and items that are part of a map. Their actual locations are kept in the
@@ -53,7 +63,7 @@ namespace world
         /**
          * Create an empty map.
          */
-        area () : chunk () { }
+        area () : chunk (), NumActive (0), Pool (NULL) { }
 
         /**
          * Delete the map and everything on it.
@@ -72,6 +82,60 @@ namespace world
          */
         void update();
 
+        /**
+         * Set the number of threads used for updating the map. With
+         * 0 threads, objects are updated one after the other. Otherwise,
+         * the new positions of all moving objects are calculated in parallel
+         * from the state of the map at the beginning of the update. Then
+         * the objects are moved in the order they have been added to the map.
+         * The result only depends on the map, not on the number of threads.
+         *
+         * @param threads number of threads, including the calling one.
+         */
+        void set_update_threads (const u_int32 & threads);
+
+        /**
+         * Get the number of threads used for updating the map.
+         * @return number of threads, or 0 if objects are updated one by one.
+         */
+        u_int32 update_threads () const;
+
+        /**
+         * @name Idle Objects
+         *
+         * Most objects on a map never change, and characters are often
+         * standing around. Objects that are idle are therefore no longer
+         * updated, until something happens to them that wakes them up.
+         */
+        //@{
+        /**
+         * Make sure the given object is updated during the next call
+         * to update(). Does nothing if the object is not a unique
+         * entity on this map.
+         * @param object an object on this map.
+         */
+        void wake (const placeable *object);
+
+        /**
+         * Get the number of objects updated during the last call
+         * to update().
+         * @return number of active objects.
+         */
+        u_int32 active_entities () const
+        {
+            return NumActive;
+        }
+
+        /**
+         * Get the number of objects that might require updating.
+         * @return number of unique entities on the map.
+         */
+        u_int32 unique_entities () const
+        {
+            return UniqueIndex.size ();
+        }
+        //@}
+
         /**
          * @name Map Object Handling.
          */
@@ -183,6 +247,15 @@ namespace world
          */
         bool load (const std::string & fname);
 
+        /**
+         * Load %area state from a record that has already been read
+         * from file, for example by area_manager::preload().
+         * @param fname file name the record was read from.
+         * @param record contents of that file.
+         * @return true on success, false otherwise.
+         */
+        bool load (const std::string & fname, base::flat & record);
+
         /**
          * Get the filename of this map.
          * @return the file this map was loaded from.
@@ -213,8 +286,33 @@ namespace world
         std::list <world::zone *> Zones;
 
     private:
+        /**
+         * Calculate the new position of a moving object.
+         * @param index index of the object in Moving.
+         */
+        void plan_move (u_int32 index);
+
+        /**
+         * Save the action of an object on the map, if it has one.
+         * @param file stream to save action to.
+         * @param ci the object on the map.
+         */
+        void put_action (base::flat & file, const chunk_info *ci) const;
+
         /// name of map
         std::string Filename;
+
+        /// index of each unique entity in Entities
+        std::map<const placeable *, u_int32> UniqueIndex;
+        /// indices of the unique entities that require updating
+        std::set<u_int32> Active;
+        /// number of entities updated during the last frame
+        u_int32 NumActive;
+
+        /// threads for updating the map, or NULL to update serially
+        base::thread_pool *Pool;
+        /// moving objects of the current parallel update
+        std::vector<world::moving *> Moving;
 #endif // SWIG
     };
 }
@@ -24,8 +24,12 @@
  * @brief  Defines the area manager class.
  */
 
+#include <atomic>
 #include <fstream>
+#include <set>
+#include <thread>
 
+#include <adonthell/base/base.h>
 #include <adonthell/base/savegame.h>
 #include "area_manager.h"
 
@@ -35,6 +39,100 @@ using world::area_manager;
 #define BUF_SIZE 8192
 /// file name of data file
 #define DATA_FILE "world.data"
+/// default memory available to preloaded maps
+#define PRELOAD_LIMIT (64 * 1024 * 1024)
+
+namespace world
+{
+    /**
+     * A map that is read in the background, waiting to become active.
+     */
+    class standby_area
+    {
+    public:
+        /**
+         * Start reading the given map.
+         * @param name name of the map.
+         * @param path full path of the map file.
+         */
+        standby_area (const std::string & name, const std::string & path)
+        : Name (name), Done (false), Path (path), Search (base::Paths()), Success (false)
+        {
+            Loader = new std::thread (&standby_area::load, this);
+        }
+
+        /**
+         * Wait for the map to be read and free it.
+         */
+        ~standby_area ()
+        {
+            wait ();
+        }
+
+        /**
+         * Block until the map has been read.
+         * @return true if reading the map succeeded, false otherwise.
+         */
+        bool wait ()
+        {
+            if (Loader != NULL)
+            {
+                Loader->join ();
+                delete Loader;
+                Loader = NULL;
+            }
+            return Success;
+        }
+
+        /// name of the map
+        std::string Name;
+        /// contents of the map file
+        base::diskio Record;
+        /// whether reading the map has finished
+        std::atomic<bool> Done;
+
+    private:
+        /**
+         * Read map and its models. Runs in a separate thread, so it
+         * must not use base::Paths(), which may change meanwhile.
+         */
+        void load ()
+        {
+            Success = Record.read_record (Path);
+            if (Success)
+            {
+                // read the models as well, so that they come from the file
+                // system or record cache when the map objects are created
+                std::set<std::string> models;
+                base::flat_view objects (Record, "objects");
+
+                void *value;
+                u_int32 size;
+                while (objects.next (&value, &size) == base::flat::T_FLAT)
+                {
+                    base::flat_view object (value, size);
+                    std::string model = object.get_string ("model", true);
+                    if (models.insert (model).second && Search.find_in_path (model, false))
+                    {
+                        base::diskio record;
+                        record.read_record (model);
+                    }
+                }
+            }
+
+            Done = true;
+        }
+
+        /// full path of the map file
+        std::string Path;
+        /// copy of the search path, as base::Paths() may change while loading
+        base::paths Search;
+        /// thread reading the map
+        std::thread *Loader;
+        /// whether the map has been read successfully
+        bool Success;
+    };
+}
 
 // no map loaded initially
 world::area* area_manager::ActiveMap = NULL;
@@ -48,9 +146,16 @@ world::pathfinding_manager area_manager::PathFinder;
 // list of maps that have been modified
 std::hash_set<std::string> area_manager::TaintedMaps;
 
+// maps read in the background
+std::list<world::standby_area*> area_manager::Standby;
+
+// memory available to preloaded maps
+u_int32 area_manager::PreloadLimit = PRELOAD_LIMIT;
+
 // reset area manager
 void area_manager::cleanup ()
 {
+    clear_preloaded ();
     delete ActiveMap;
     ActiveMap = NULL;
     PathFinder.clear ();
@@ -89,12 +194,115 @@ bool area_manager::set_active_map (const std::string & name, const bool & auto_s
         ActiveMap = new area();
     }
     
+    // use preloaded map, if available
+    standby_area *standby = take_preloaded (name);
+    if (standby != NULL)
+    {
+        bool success = standby->wait () && ActiveMap->load (name, standby->Record);
+        delete standby;
+        
+        if (success) return true;
+        ActiveMap->clear ();
+    }
+    
     // load the map
     ActiveMap->load (name);
 
     return true;
 }
 
+// start reading map in the background
+bool area_manager::preload (const std::string & name)
+{
+    if (PreloadLimit == 0) return false;
+    
+    // the active map is already loaded
+    if (ActiveMap != NULL && ActiveMap->filename() == name) return true;
+    
+    // the map might already be preloaded
+    standby_area *standby = take_preloaded (name);
+    if (standby == NULL)
+    {
+        std::string path = name;
+        if (!base::Paths().find_in_path (path)) return false;
+        
+        standby = new standby_area (name, path);
+    }
+    
+    // keep most recently requested map longest
+    Standby.push_back (standby);
+    check_preloaded ();
+    
+    return true;
+}
+
+// check whether map has been preloaded
+bool area_manager::is_preloaded (const std::string & name)
+{
+    for (std::list<standby_area*>::const_iterator i = Standby.begin(); i != Standby.end(); i++)
+    {
+        if ((*i)->Name == name) return (*i)->Done && (*i)->wait ();
+    }
+    return false;
+}
+
+// memory used by preloaded maps
+u_int32 area_manager::preloaded_size ()
+{
+    u_int32 size = 0;
+    for (std::list<standby_area*>::const_iterator i = Standby.begin(); i != Standby.end(); i++)
+    {
+        if ((*i)->Done) size += (*i)->Record.size ();
+    }
+    return size;
+}
+
+// drop oldest preloaded maps until below limit
+void area_manager::check_preloaded ()
+{
+    if (Standby.empty()) return;
+    
+    u_int32 size = preloaded_size ();
+    std::list<standby_area*>::iterator i = Standby.begin();
+    while (size > PreloadLimit && i != Standby.end())
+    {
+        if ((*i)->Done)
+        {
+            VLOG(1) << "area_manager: discarding preloaded map " << (*i)->Name;
+            size -= (*i)->Record.size ();
+            delete *i;
+            i = Standby.erase (i);
+            continue;
+        }
+        i++;
+    }
+}
+
+// discard all preloaded maps
+void area_manager::clear_preloaded ()
+{
+    for (std::list<standby_area*>::iterator i = Standby.begin(); i != Standby.end(); i++)
+    {
+        delete *i;
+    }
+    Standby.clear ();
+}
+
+// remove map from list of preloaded maps
+world::standby_area *area_manager::take_preloaded (const std::string & name)
+{
+    for (std::list<standby_area*>::iterator i = Standby.begin(); i != Standby.end(); i++)
+    {
+        if ((*i)->Name == name)
+        {
+            standby_area *standby = *i;
+            Standby.erase (i);
+            return standby;
+        }
+    }
+    return NULL;
+}
+
 // save to disk
 bool area_manager::save (const std::string & path)
 {
@@ -143,6 +351,9 @@ bool area_manager::load ()
     // cleanup
     TaintedMaps.clear();
     
+    // maps preloaded for the previous game may be outdated
+    clear_preloaded ();
+    
     // try to load world data
     if (!file.get_record (DATA_FILE)) return false;
     
@@ -28,6 +28,8 @@
 #define WORLD_AREA_MANAGER_H
 
 #include <adonthell/base/hash_map.h>
+#include <adonthell/base/telemetry.h>
+#include <adonthell/event/manager.h>
 
 #include "pathfinding_manager.h"
 #include "mapview.h"
@@ -36,6 +38,9 @@
 namespace world
 {
 class area;
+#ifndef SWIG
+class standby_area;
+#endif
 
 /**
  * This class takes care of the currently active map
@@ -70,15 +75,77 @@ public:
         return set_active_map (name, true);
     }
     //@}
+
+    /**
+     * @name Map Preloading
+     */
+    //@{
+    /**
+     * Hint that the given map is likely to become active soon, for
+     * example when the player approaches its entrance. The map file
+     * and the models it uses are read and decoded by a background
+     * thread and kept in memory, so that set_active_map() only has
+     * to create the map objects.
+     *
+     * Preloaded maps are discarded, oldest first, once they take up
+     * more memory than allowed by set_preload_limit().
+     *
+     * @param name name of the map to preload.
+     * @return false if the map cannot be found or preloading is
+     *      disabled, true otherwise.
+     */
+    static bool preload (const std::string & name);
+
+    /**
+     * Check whether the given map has been read completely and is
+     * waiting to become active.
+     * @param name name of the map.
+     * @return true if the map is preloaded, false otherwise.
+     */
+    static bool is_preloaded (const std::string & name);
+
+    /**
+     * Set the amount of memory preloaded maps may use.
+     * @param bytes maximum size of all preloaded maps. 0 disables preloading.
+     */
+    static void set_preload_limit (const u_int32 & bytes)
+    {
+        PreloadLimit = bytes;
+        check_preloaded ();
+    }
+
+    /**
+     * Return the amount of memory preloaded maps may use.
+     * @return maximum size of all preloaded maps in bytes.
+     */
+    static u_int32 preload_limit ()
+    {
+        return PreloadLimit;
+    }
+
+    /**
+     * Return the amount of memory used by preloaded maps.
+     * @return size of maps read completely, in bytes.
+     */
+    static u_int32 preloaded_size ();
+    //@}
     
     /**
      * Update state of world module. Call once for each frame.
+     * Events queued by managers with deferred dispatch are raised
+     * after the active map has been updated.
      */
     static void update ()
     {
-        PathFinder.update();
+        base::telemetry::scope measure (base::telemetry::WORLD);
+        {
+            base::telemetry::scope measure_paths (base::telemetry::PATHFINDING);
+            PathFinder.update();
+        }
         ActiveMap->update();
+        events::manager::dispatch();
         MapView.update();
+        check_preloaded();
     }
     
     /**
@@ -161,12 +228,37 @@ private:
      * @return true on success, false otherwise.
      */
     static bool copy_tainted_maps (const std::string & source, const std::string & target);
+
+    /**
+     * Discard preloaded maps that exceed the preload limit.
+     */
+    static void check_preloaded ();
+
+    /**
+     * Discard all preloaded maps.
+     */
+    static void clear_preloaded ();
+
+#ifndef SWIG
+    /**
+     * Remove the given map from the list of preloaded maps.
+     * @param name name of the map.
+     * @return the preloaded map, or NULL if it hasn't been preloaded.
+     */
+    static standby_area *take_preloaded (const std::string & name);
+#endif
         
     /// forbid instantiation
     area_manager() {};
     
     /// list of maps that already have been in use
     static std::hash_set<std::string> TaintedMaps;
+#ifndef SWIG
+    /// maps read in the background, oldest first
+    static std::list<standby_area*> Standby;
+#endif
+    /// memory available to preloaded maps
+    static u_int32 PreloadLimit;
 };
 
 }
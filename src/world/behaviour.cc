@@ -0,0 +1,404 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file world/behaviour.cc
+ * @author agent <agent@local>
+ *
+ * @brief Implements the behaviour registry and the stock behaviours.
+ */
+
+#include <cstdlib>
+#include <vector>
+
+#include "behaviour.h"
+#include "area_manager.h"
+#include "schedule.h"
+
+using world::behaviour;
+
+namespace world
+{
+    /**
+     * Base for behaviours that walk the %character from place to place,
+     * one path finding task after the other.
+     */
+    class walk_behaviour : public behaviour
+    {
+    public:
+        walk_behaviour () : Schedule (NULL), Task (-1), Pending (false) { }
+
+        void start (schedule *s)
+        {
+            Schedule = s;
+            Pending = false;
+            walk ();
+        }
+
+        void pause (schedule *s)
+        {
+            if (Task >= 0) area_manager::get_pathfinder ()->pause_task (Task);
+        }
+
+        void resume (schedule *s)
+        {
+            if (Task >= 0) area_manager::get_pathfinder ()->resume_task (Task);
+            else if (Pending) s->wake ();
+        }
+
+        void stop (schedule *s)
+        {
+            if (Task >= 0) area_manager::get_pathfinder ()->delete_task (Task);
+            Task = -1;
+            Pending = false;
+        }
+
+        bool needs_update () const
+        {
+            return Pending;
+        }
+
+        void update (schedule *s)
+        {
+            Pending = false;
+            walk ();
+        }
+
+    protected:
+        /**
+         * Return the string arguments of a behaviour, in order.
+         * @param args arguments passed to init ().
+         * @return the string arguments.
+         */
+        static std::vector<std::string> strings (base::flat & args)
+        {
+            std::vector<std::string> result;
+            void *value;
+
+            args.first ();
+            base::flat::data_type type;
+            while ((type = args.next (&value)) != base::flat::T_UNKNOWN)
+            {
+                if (type == base::flat::T_STRING) result.push_back ((const char *) value);
+            }
+            return result;
+        }
+
+        /**
+         * Start walking towards the next destination.
+         */
+        virtual void walk () = 0;
+
+        /**
+         * Called when the destination has been reached or
+         * no path could be found.
+         * @param success whether the destination has been reached.
+         */
+        virtual void arrived (const bool & success) = 0;
+
+        /**
+         * Call walk () again during the next update. Path finding
+         * does not allow a new task from within the callback.
+         */
+        void walk_on ()
+        {
+            Pending = true;
+            Schedule->wake ();
+        }
+
+        /**
+         * Walk to the given zone.
+         * @param zone name of the zone.
+         * @return \b false if walking is not possible.
+         */
+        bool walk_to (const std::string & zone)
+        {
+            character *chr = Schedule->get_owner ();
+            if (chr == NULL) return false;
+
+            return follow (area_manager::get_pathfinder ()->add_task (chr, zone));
+        }
+
+        /**
+         * Walk to the given position.
+         * @param target the position to walk to.
+         * @return \b false if walking is not possible.
+         */
+        bool walk_to (const vector3<s_int32> & target)
+        {
+            character *chr = Schedule->get_owner ();
+            if (chr == NULL) return false;
+
+            return follow (area_manager::get_pathfinder ()->add_task (chr, target));
+        }
+
+        /// the schedule using this behaviour
+        schedule *Schedule;
+
+    private:
+        /// get notified once given task completes
+        bool follow (const s_int16 & task)
+        {
+            Task = task;
+            if (Task < 0) return false;
+
+            area_manager::get_pathfinder ()->set_callback (Task, base::make_functor ((base::functor_1<const s_int32> *) NULL, *this, &walk_behaviour::on_arrived));
+            return true;
+        }
+
+        /// callback for path finding task
+        void on_arrived (const s_int32 result)
+        {
+            Task = -1;
+            arrived (result == pathfinding_manager::SUCCESS);
+        }
+
+        /// the active path finding task
+        s_int16 Task;
+        /// whether to walk on during the next update
+        bool Pending;
+    };
+
+    /**
+     * Walk from one zone to the next, starting over after the last.
+     */
+    class patrol_behaviour : public walk_behaviour
+    {
+    public:
+        patrol_behaviour () : Next (0) { }
+
+        bool init (schedule *s, base::flat & args)
+        {
+            Zones = strings (args);
+            return !Zones.empty ();
+        }
+
+        void put_state (base::flat & file) const
+        {
+            file.put_uint32 ("pnx", Next);
+            file.put_uint32 ("pnm", Zones.size ());
+            for (std::vector<std::string>::const_iterator i = Zones.begin (); i != Zones.end (); i++)
+            {
+                file.put_string ("pzn", *i);
+            }
+        }
+
+        bool get_state (schedule *s, base::flat & file)
+        {
+            Next = file.get_uint32 ("pnx");
+            Zones.resize (file.get_uint32 ("pnm"));
+            for (std::vector<std::string>::iterator i = Zones.begin (); i != Zones.end (); i++)
+            {
+                *i = file.get_string ("pzn");
+            }
+            return file.success () && Next < Zones.size ();
+        }
+
+    protected:
+        void walk ()
+        {
+            if (!walk_to (Zones[Next])) Schedule->set_running (false);
+        }
+
+        void arrived (const bool & success)
+        {
+            if (!success)
+            {
+                Schedule->set_running (false);
+                return;
+            }
+
+            Next = (Next + 1) % Zones.size ();
+            walk_on ();
+        }
+
+    private:
+        /// the zones to visit
+        std::vector<std::string> Zones;
+        /// index of the zone to visit next
+        u_int32 Next;
+    };
+
+    /**
+     * Walk to random places within a zone.
+     */
+    class wander_behaviour : public walk_behaviour
+    {
+    public:
+        bool init (schedule *s, base::flat & args)
+        {
+            std::vector<std::string> zone = strings (args);
+            if (zone.size () != 1) return false;
+
+            Zone = zone[0];
+            return true;
+        }
+
+        void put_state (base::flat & file) const
+        {
+            file.put_string ("wzn", Zone);
+        }
+
+        bool get_state (schedule *s, base::flat & file)
+        {
+            Zone = file.get_string ("wzn");
+            return file.success ();
+        }
+
+    protected:
+        void walk ()
+        {
+            character *chr = Schedule->get_owner ();
+            zone *area = chr ? chr->map ().get_zone (Zone) : NULL;
+            if (area == NULL)
+            {
+                Schedule->set_running (false);
+                return;
+            }
+
+            const vector3<s_int32> & min = area->min ();
+            const vector3<s_int32> & max = area->max ();
+            vector3<s_int32> target (
+                min.x () + rand () % (max.x () - min.x () + 1),
+                min.y () + rand () % (max.y () - min.y () + 1),
+                min.z ());
+
+            if (!walk_to (target)) Schedule->set_running (false);
+        }
+
+        void arrived (const bool & success)
+        {
+            if (success) walk_on ();
+            else Schedule->set_running (false);
+        }
+
+    private:
+        /// the zone to walk around in
+        std::string Zone;
+    };
+
+    /**
+     * Walk to a zone and stay there for a while.
+     */
+    class go_and_wait_behaviour : public walk_behaviour
+    {
+    public:
+        go_and_wait_behaviour () : Arrived (false) { }
+
+        bool init (schedule *s, base::flat & args)
+        {
+            std::vector<std::string> params = strings (args);
+            if (params.size () != 2) return false;
+
+            Zone = params[0];
+            Time = params[1];
+            return true;
+        }
+
+        void put_state (base::flat & file) const
+        {
+            file.put_string ("gzn", Zone);
+            file.put_string ("gtm", Time);
+            file.put_bool ("gar", Arrived);
+        }
+
+        bool get_state (schedule *s, base::flat & file)
+        {
+            Zone = file.get_string ("gzn");
+            Time = file.get_string ("gtm");
+            Arrived = file.get_bool ("gar");
+            return file.success ();
+        }
+
+    protected:
+        void walk ()
+        {
+            // the alarm has been restored with the schedule
+            if (Arrived) return;
+
+            if (!walk_to (Zone)) Schedule->set_running (false);
+        }
+
+        void arrived (const bool & success)
+        {
+            if (!success)
+            {
+                Schedule->set_running (false);
+                return;
+            }
+
+            Arrived = true;
+            Schedule->set_alarm (Time);
+        }
+
+    private:
+        /// the zone to walk to
+        std::string Zone;
+        /// how long to wait there
+        std::string Time;
+        /// whether the zone has been reached
+        bool Arrived;
+    };
+
+    /// create a stock behaviour
+    template <class B>
+    behaviour *create_stock ()
+    {
+        return new B ();
+    }
+}
+
+// register behaviour
+void behaviour::add (const std::string & name, factory create)
+{
+    registry ()[name] = create;
+}
+
+// unregister behaviour
+void behaviour::remove (const std::string & name)
+{
+    registry ().erase (name);
+}
+
+// instanciate behaviour
+behaviour *behaviour::create (const std::string & name)
+{
+    std::map<std::string, factory> & behaviours = registry ();
+    std::map<std::string, factory>::const_iterator i = behaviours.find (name);
+    if (i == behaviours.end ()) return NULL;
+
+    behaviour *result = (i->second) ();
+    result->Name = name;
+    return result;
+}
+
+// get registered behaviours
+std::map<std::string, behaviour::factory> & behaviour::registry ()
+{
+    static std::map<std::string, factory> Behaviours;
+    static bool Initialized = false;
+    if (!Initialized)
+    {
+        Initialized = true;
+        Behaviours["patrol"] = &create_stock<patrol_behaviour>;
+        Behaviours["wander"] = &create_stock<wander_behaviour>;
+        Behaviours["go_and_wait"] = &create_stock<go_and_wait_behaviour>;
+    }
+    return Behaviours;
+}
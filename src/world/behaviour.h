@@ -0,0 +1,192 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file world/behaviour.h
+ * @author agent <agent@local>
+ *
+ * @brief Declares the behaviour class for native character schedules.
+ */
+
+#ifndef WORLD_BEHAVIOUR_H
+#define WORLD_BEHAVIOUR_H
+
+#include <map>
+#include <adonthell/base/flat.h>
+
+namespace world
+{
+    class schedule;
+
+    /**
+     * A %character %schedule implemented in C++. A behaviour can take the
+     * place of the manager script or of the activity script of a %schedule
+     * and receives the same calls the script would: "run" for a manager,
+     * "start", "pause", "resume" and "stop" for an activity.
+     *
+     * Behaviours are registered by name. Whenever a %schedule is told to
+     * use a manager or activity of a registered name, it creates the
+     * behaviour instead of loading a script of that name. The "patrol",
+     * "wander" and "go_and_wait" behaviours are always available:
+     *
+     * - patrol (zone, zone, ...) walks from one zone to the next, forever.
+     * - wander (zone) walks to random places within the zone, forever.
+     * - go_and_wait (zone, time) walks to the zone and stops the %schedule
+     *   once the given time has passed after arriving there.
+     */
+    class behaviour
+    {
+    public:
+        /// function creating a new behaviour instance
+        typedef behaviour* (*factory) ();
+
+        /**
+         * Create a behaviour.
+         */
+        behaviour () { }
+
+        /**
+         * Destructor.
+         */
+        virtual ~behaviour () { }
+
+        /**
+         * @name Schedule callbacks
+         */
+        //@{
+        /**
+         * Set up a new behaviour from the arguments passed to the %schedule.
+         * Strings and integers are stored in order under the names "s" and
+         * "i", as done by python::put_tuple.
+         * @param s the %schedule using this behaviour.
+         * @param args arguments of the behaviour.
+         * @return \b false if the arguments are not valid.
+         */
+        virtual bool init (schedule *s, base::flat & args) { return true; }
+
+        /**
+         * Called when used as manager, to pick the next activity.
+         * @param s the %schedule using this behaviour.
+         */
+        virtual void run (schedule *s) { }
+
+        /**
+         * Called when the activity is started or restored from a saved game.
+         * @param s the %schedule using this behaviour.
+         */
+        virtual void start (schedule *s) { }
+
+        /**
+         * Called when the %character is set inactive.
+         * @param s the %schedule using this behaviour.
+         */
+        virtual void pause (schedule *s) { }
+
+        /**
+         * Called when the %character becomes active again.
+         * @param s the %schedule using this behaviour.
+         */
+        virtual void resume (schedule *s) { }
+
+        /**
+         * Called before the activity is replaced.
+         * @param s the %schedule using this behaviour.
+         */
+        virtual void stop (schedule *s) { }
+
+        /**
+         * Whether the running activity wants update() to be called. Unlike
+         * scripts, which rely on events only, behaviours may use this to
+         * continue from within the game loop, for example to walk on after
+         * path finding has completed.
+         * @return \b true if update() has work to do.
+         */
+        virtual bool needs_update () const { return false; }
+
+        /**
+         * Called during the %character update while needs_update() is true.
+         * @param s the %schedule using this behaviour.
+         */
+        virtual void update (schedule *s) { }
+        //@}
+
+        /**
+         * @name Loading / Saving
+         */
+        //@{
+        /**
+         * Save the state of the behaviour.
+         * @param file stream where to save the behaviour.
+         */
+        virtual void put_state (base::flat & file) const { }
+
+        /**
+         * Restore the state of the behaviour.
+         * @param s the %schedule using this behaviour.
+         * @param file stream to load the behaviour from.
+         * @return \b true on success, \b false otherwise.
+         */
+        virtual bool get_state (schedule *s, base::flat & file) { return true; }
+        //@}
+
+        /**
+         * Return name the behaviour was created with.
+         * @return name of the behaviour.
+         */
+        const std::string & name () const { return Name; }
+
+        /**
+         * @name Registry
+         */
+        //@{
+        /**
+         * Make a behaviour available under the given name, replacing
+         * any behaviour registered with that name before.
+         * @param name the name schedules will refer to.
+         * @param create function returning a new instance of the behaviour.
+         */
+        static void add (const std::string & name, factory create);
+
+        /**
+         * Remove the behaviour registered with the given name.
+         * @param name the name of the behaviour.
+         */
+        static void remove (const std::string & name);
+
+        /**
+         * Create the behaviour registered with the given name.
+         * @param name the name of the behaviour.
+         * @return a new behaviour, or NULL if there is none of that name.
+         */
+        static behaviour *create (const std::string & name);
+        //@}
+
+    private:
+        /// forbid copy construction
+        behaviour (const behaviour & b);
+
+        /// return registered behaviours
+        static std::map<std::string, factory> & registry ();
+
+        /// name of the behaviour
+        std::string Name;
+    };
+}
+
+#endif // WORLD_BEHAVIOUR_H
@@ -27,8 +27,10 @@
  */
 
 #include <cmath>
+#include <cstring>
 
 #include <adonthell/base/logging.h>
+#include <adonthell/base/state_name.h>
 #include <adonthell/rpg/character.h>
 #include "area.h"
 #include "character.h"
@@ -43,6 +45,7 @@ character::character (area & mymap, const std::string & hash, rpg::character * m
 {
     Type = CHARACTER;
     VSpeed = 0;
+    PrevZ = 0;
     IsRunning = false;
     ToggleRunning = false;
     CurrentDir = NONE;
@@ -90,27 +93,30 @@ void character::jump()
     if (GroundPos >= z() && VSpeed == 0)
     {
         VSpeed = 10;
+        Mymap.wake (this);
     }
 }
 
 // process character movement
-bool character::update ()
+void character::begin_update ()
 {
-    // the lowest negative VSpeed that can be reached during extended falling
-    static float min_vspeed = -9.6;
-
     // saving the vertical position before movement
-    s_int32 prev_z = z ();
-    static u_int32 frames_stuck = 0;
+    PrevZ = z ();
 
     // character movement
     Schedule.update ();
 
     // reset vertical velocity
     set_vertical_velocity (VSpeed);
+}
+
+// process character physics after moving
+void character::end_update ()
+{
+    // the lowest negative VSpeed that can be reached during extended falling
+    static float min_vspeed = -9.6;
 
-    // update character
-    moving::update ();
+    static u_int32 frames_stuck = 0;
 
     // only consider landing on something when the character is falling
     if (GroundPos >= z() && VSpeed <= 0)
@@ -136,7 +142,7 @@ bool character::update ()
     {
         // if vertical velocity is non-zero and we're not moving, we may have hit something
         // but if we did eventually move, reset counter
-        frames_stuck = vz() >= 0 && z () == prev_z ? frames_stuck + 1 : 0;
+        frames_stuck = vz() >= 0 && z () == PrevZ ? frames_stuck + 1 : 0;
 
         // if we're stuck for more then X frames in a row, assume we've hit the ceiling
         if (frames_stuck > 2)
@@ -144,8 +150,6 @@ bool character::update ()
         else if (VSpeed > min_vspeed)
             VSpeed -= 0.4;
     }
-
-    return true;
 }
 
 // add direction to character movement
@@ -176,25 +180,18 @@ void character::add_direction(direction ndir)
 // set character movement
 void character::set_direction (const s_int32 & ndir)
 {
-    VLOG(1) << logging::indent() << "set_direction(" << ndir << ") called";
-    logging::increment_log_indent_level();
+    VLOG(1) << logging::indent() << "set_direction" << logging::field ("dir", ndir) << logging::field ("was", CurrentDir);
+    logging::vlog_indent indent (1);
 
     update_velocity(ndir);
     update_state();
 
-    VLOG(1) << logging::indent() << "CurrentDir was: " << CurrentDir;
     CurrentDir = ndir;
-    VLOG(1) << logging::indent() << "CurrentDir is: "  << CurrentDir;
-
-    logging::decrement_log_indent_level();
 }
 
 // recalculate the character's speed
 void character::update_velocity (const s_int32 & ndir)
 {
-    VLOG(1) << logging::indent() << "update_velocity(" << ndir << ") called";
-    logging::increment_log_indent_level();
-
     float vx = 0.0;
     float vy = 0.0;
 
@@ -203,83 +200,93 @@ void character::update_velocity (const s_int32 & ndir)
     if (ndir & NORTH) vy = -speed() * (1 + is_running());
     if (ndir & SOUTH) vy =  speed() * (1 + is_running());
 
-    VLOG(1) << logging::indent() << "vx: " << vx;
-    VLOG(1) << logging::indent() << "vy: " << vy;
-
     if (vx && vy && ! std::isnan(vx) && ! std::isnan(vy))
     {
         float s = 1/sqrt (vx*vx + vy*vy);
 
         vx = (vx * std::fabs (vx)) * s;
         vy = (vy * std::fabs (vy)) * s;
-
-        VLOG(1) << logging::indent() << "vx (adjusted): " << vx;
-        VLOG(1) << logging::indent() << "vy (adjusted): " << vy;
     }
 
+    VLOG(1) << logging::indent() << "update_velocity" << logging::field ("vx", vx) << logging::field ("vy", vy);
     set_velocity(vx, vy);
+}
+
+/// ways of moving, in the order of movement_state's motion parameter
+static const char *Motions[] = { "_stand", "_walk", "_run" };
 
-    logging::decrement_log_indent_level();
+// id of the character state for the given direction and way of moving
+static u_int16 movement_state (const char & dir, const u_int32 & motion)
+{
+    static const char Directions[] = "ewsn";
+    static u_int16 Ids[4][3];
+    static bool Initialized = false;
+
+    if (!Initialized)
+    {
+        for (u_int32 d = 0; d < 4; d++)
+            for (u_int32 m = 0; m < 3; m++)
+                Ids[d][m] = base::state_name::id (std::string (1, Directions[d]) + Motions[m]);
+        Initialized = true;
+    }
+
+    const char *d = dir == 0 ? NULL : strchr (Directions, dir);
+    if (d == NULL) return base::state_name::id (std::string (1, dir) + Motions[motion]);
+
+    return Ids[d - Directions][motion];
 }
 
 // figure out name of character shape (and animation) to use
 void character::update_state()
 {
-    VLOG(1) << logging::indent() << "update_state() called";
-    logging::increment_log_indent_level();
-
-    std::string state;
+    char dir = 0;
+    u_int32 motion = 0;
 
     float xvel = vx () > 0 ? vx () : -vx ();
     float yvel = vy () > 0 ? vy () : -vy ();
 
-    VLOG(1) << logging::indent() << "xvel: " << xvel;
-    VLOG(1) << logging::indent() << "yvel: " << yvel;
-
     if (xvel || yvel)
     {
         if (xvel > yvel)
         {
-            if (vx () > 0) state = "e";
-            else if (vx () < 0) state = "w";
+            if (vx () > 0) dir = 'e';
+            else if (vx () < 0) dir = 'w';
         }
         else if (yvel > xvel)
         {
-            if (vy () > 0) state = "s";
-            else if (vy () < 0) state = "n";
+            if (vy () > 0) dir = 's';
+            else if (vy () < 0) dir = 'n';
         }
         else
         {
             if ((vx() > 0) && (CurrentDir & WEST))
-                state = "e";
+                dir = 'e';
             else if ((vx() < 0) && (CurrentDir & EAST))
-                state = "w";
+                dir = 'w';
             else if ((vy() > 0) && (CurrentDir & NORTH))
-                state = "s";
+                dir = 's';
             else if ((vy() < 0) && (CurrentDir & SOUTH))
-                state = "n";
-            else state = placeable::state()[0];
+                dir = 'n';
+            else dir = placeable::state()[0];
         }
-        state += is_running() ? "_run" : "_walk";
+        motion = is_running() ? 2 : 1;
     }
     else
     {
-        state = placeable::state()[0];
-        state += "_stand";
+        dir = placeable::state()[0];
     }
 
-    VLOG(1) << logging::indent() << "state: " << state;
+    VLOG(1) << logging::indent() << "update_state" << logging::field ("xvel", xvel) << logging::field ("yvel", yvel)
+            << logging::field ("dir", dir) << logging::field ("motion", Motions[motion]);
 
     // set direction the character is actually facing now
-    if      (state[0] == 'e') Heading = EAST;
-    else if (state[0] == 'w') Heading = WEST;
-    else if (state[0] == 's') Heading = SOUTH;
-    else                      Heading = NORTH;
+    if      (dir == 'e') Heading = EAST;
+    else if (dir == 'w') Heading = WEST;
+    else if (dir == 's') Heading = SOUTH;
+    else                 Heading = NORTH;
 
     // update sprite
-    set_state (state);
-
-    logging::decrement_log_indent_level();
+    set_state (movement_state (dir, motion));
 }
 
 // save to stream
@@ -317,7 +324,7 @@ bool character::get_state (base::flat & file)
     set_vertical_velocity(VSpeed);
     
     // load schedule
-    base::flat record = file.get_flat ("schedule");
+    base::flat_view record (file, "schedule");
     return Schedule.get_state (record);
 }
 
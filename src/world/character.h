@@ -63,12 +63,31 @@ namespace world
          */
         virtual ~character ();
 
+#ifndef SWIG
         /**
-         * Call every cycle to "process" the %character. This
-         * takes care of the %character's physics, like falling
+         * Called every cycle before the %character moves. This
+         * runs the %character's schedule and prepares falling
          * or jumping.
          */
-        virtual bool update ();
+        virtual void begin_update ();
+
+        /**
+         * Called every cycle after the %character moved. This
+         * takes care of the %character's physics, like landing
+         * after falling or jumping.
+         */
+        virtual void end_update ();
+#endif
+
+        /**
+         * A %character is idle while it is neither moving nor
+         * jumping or falling, and its schedule is running.
+         * @return true if the %character is idle, false otherwise.
+         */
+        virtual bool is_idle () const
+        {
+            return moving::is_idle () && VSpeed == 0 && !Schedule.needs_update ();
+        }
 
         /**
          * Update %character state. This takes care of the
@@ -260,6 +279,8 @@ namespace world
 
         /// vertical speed for jumping
         float VSpeed;
+        /// vertical position before the last move
+        s_int32 PrevZ;
 
         /// whether character is running or not
         bool IsRunning;
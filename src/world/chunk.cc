@@ -47,6 +47,8 @@ typedef enum
 #define MAX_OBJECTS 16
 /// minimum node size (in all 3 dimensions)
 #define MIN_SIZE 240
+/// number of objects considered when placing split planes in bulk
+#define MEDIAN_SAMPLES 512
 
 bool chunk_info::operator == (const chunk_info & ci) const
 {
@@ -88,15 +90,21 @@ chunk::~chunk()
 
 // add an object to chunk
 chunk_info * chunk::add (entity * object, const coordinates & pos)
+{
+    chunk_info *ci = create_info (object, pos);
+    add (ci);
+    return ci;
+}
+
+// create bbox of object at given position
+chunk_info * chunk::create_info (entity * object, const coordinates & pos)
 {
     // calculate axis-aligned bbox for object
     const placeable *p = object->get_object();
     vector3<s_int32> min = pos + p->entire_min();
     vector3<s_int32> max = min + p->entire_max();
 
-    chunk_info *ci = new chunk_info (object, min, max);
-    add (ci);
-    return ci;
+    return new chunk_info (object, min, max);
 }
 
 // check if object exists at given position
@@ -235,6 +243,157 @@ void chunk::add (chunk_info * ci)
     }
 }
 
+// add many objects to chunk
+void chunk::add (std::vector<chunk_info*> & objects)
+{
+    if (objects.empty ()) return;
+
+    // an empty chunk can be built in one go ...
+    if (is_leaf() && Objects.empty())
+    {
+        std::vector<s_int32> scratch (objects.size());
+        std::vector<chunk_info*> buffer (objects.size());
+        build (&objects[0], objects.size(), &scratch[0], &buffer[0]);
+        return;
+    }
+
+    // ... otherwise objects have to fit into the existing tree
+    std::vector<chunk_info*>::const_iterator i;
+    for (i = objects.begin(); i != objects.end(); i++)
+    {
+        add (*i);
+    }
+}
+
+// grow bbox to include given object
+static void extend (world::vector3<s_int32> & min, world::vector3<s_int32> & max, const chunk_info *ci)
+{
+    min.set_x (std::min (min.x(), ci->Min.x()));
+    min.set_y (std::min (min.y(), ci->Min.y()));
+    min.set_z (std::min (min.z(), ci->Min.z()));
+
+    max.set_x (std::max (max.x(), ci->Max.x()));
+    max.set_y (std::max (max.y(), ci->Max.y()));
+    max.set_z (std::max (max.z(), ci->Max.z()));
+}
+
+// get center of bbox along the given axis
+static s_int32 center (const chunk_info *ci, const u_int8 & axis)
+{
+    switch (axis)
+    {
+        case 0: return (ci->Min.x() + ci->Max.x()) / 2;
+        case 1: return (ci->Min.y() + ci->Max.y()) / 2;
+        default: return (ci->Min.z() + ci->Max.z()) / 2;
+    }
+}
+
+// place split plane at the median of the given centers
+static s_int32 median_split (s_int32 *centers, const u_int32 & count, const s_int32 & min)
+{
+    std::nth_element (centers, centers + count / 2, centers + count);
+
+    // align to a multiple of regular tile size, so we get less overlap,
+    // but never put everything into the upper half
+    s_int32 split = centers[count / 2];
+    split -= split % MIN_SIZE;
+    return split > min ? split : split + MIN_SIZE;
+}
+
+// build subtree from given objects
+void chunk::build (chunk_info **objects, const u_int32 & count, s_int32 *scratch, chunk_info **buffer)
+{
+    // update bounding box of chunk
+    for (u_int32 i = 0; i < count; i++)
+    {
+        extend (Min, Max, objects[i]);
+    }
+
+    // few enough objects to keep them all in a leaf
+    if (count <= MAX_OBJECTS || !can_split())
+    {
+        Objects.insert (Objects.end(), objects, objects + count);
+        return;
+    }
+
+    // calculate split planes. For large numbers of objects, a sample
+    // is good enough to estimate the median
+    const u_int32 step = count / MEDIAN_SAMPLES + 1;
+    const u_int32 samples = (count + step - 1) / step;
+    s_int32 split[3];
+    for (u_int8 axis = 0; axis < 3; axis++)
+    {
+        for (u_int32 i = 0; i < samples; i++)
+        {
+            scratch[i] = center (objects[i * step], axis);
+        }
+        split[axis] = median_split (scratch, samples, axis == 0 ? Min.x() : axis == 1 ? Min.y() : Min.z());
+    }
+    Split.set (split[0], split[1], split[2]);
+
+    // sort objects by the child they belong to. Objects that would be split
+    // between children have to stay in the current node
+    s_int32 *slot = scratch;
+    u_int32 start[10] = { 0 };
+    s_int8 chunks[8];
+
+    for (u_int32 i = 0; i < count; i++)
+    {
+        const u_int8 num = find_chunks (chunks, objects[i]->Min, objects[i]->Max);
+        slot[i] = num == 1 ? chunks[0] : 8;
+        start[slot[i] + 1]++;
+    }
+    for (u_int8 i = 1; i < 10; i++)
+    {
+        start[i] += start[i - 1];
+    }
+
+    // if all objects end up in a child just as large as this chunk,
+    // splitting would never end, so keep everything here instead
+    for (u_int8 i = 0; i < 8; i++)
+    {
+        if (start[i + 1] - start[i] == count)
+        {
+            vector3<s_int32> min = objects[0]->Min;
+            vector3<s_int32> max = objects[0]->Max;
+            for (u_int32 j = 1; j < count; j++)
+            {
+                extend (min, max, objects[j]);
+            }
+
+            if (min == Min && max == Max)
+            {
+                Split = vector3<s_int32>();
+                Objects.insert (Objects.end(), objects, objects + count);
+                return;
+            }
+        }
+    }
+
+    u_int32 pos[9];
+    std::copy (start, start + 9, pos);
+    for (u_int32 i = 0; i < count; i++)
+    {
+        buffer[pos[slot[i]]++] = objects[i];
+    }
+    std::copy (buffer, buffer + count, objects);
+
+    // recurse
+    for (u_int8 i = 0; i < 8; i++)
+    {
+        const u_int32 num = start[i + 1] - start[i];
+        if (num == 0) continue;
+
+        chunk *c = new chunk;
+        c->Min = objects[start[i]]->Min;
+        c->Max = objects[start[i]]->Max;
+        c->build (objects + start[i], num, scratch, buffer);
+        Children[i] = c;
+    }
+
+    Objects.insert (Objects.end(), objects + start[8], objects + count);
+}
+
 // check if object exists at given position
 bool chunk::exists (const chunk_info & ci)
 {
@@ -384,8 +543,10 @@ void chunk::objects_in_bbox (const vector3<s_int32> & min, const vector3<s_int32
 {
     s_int8 chunks[8];
     
-    // process children
-    u_int8 num = find_chunks (chunks, min, max);
+    // process children. Objects merely touching the bbox are part of the
+    // result too, so include children only bordering on it as well
+    const vector3<s_int32> border (1, 1, 1);
+    u_int8 num = find_chunks (chunks, min - border, max + border);
     for (u_int32 i = 0; i < num; i++)
     {
         chunk *c = Children[chunks[i]];
@@ -76,6 +76,27 @@ namespace world
          */
         void add (chunk_info * ci);
 
+#ifndef SWIG
+        /**
+         * Add many objects at once, as when loading a map. If the %chunk
+         * is still empty, a balanced tree is built top-down from all the
+         * objects, instead of growing and splitting it one object at a
+         * time. Otherwise objects are added one by one.
+         * @param objects entities to add to the world. The vector will
+         *      be reordered in the process.
+         */
+        void add (std::vector<chunk_info*> & objects);
+#endif
+
+        /**
+         * Create the bounding box of an object at given coordinates,
+         * without adding it to the %chunk yet.
+         * @param object entity to place in the world.
+         * @param coordinates location of the entity.
+         * @returns a new chunk_info, to be passed to add().
+         */
+        static chunk_info * create_info (entity * object, const coordinates & pos);
+
         /**
          * Check if given object is present at given position.
          * @param object entity which presence to check.
@@ -306,6 +327,17 @@ namespace world
          */
         void split ();
 
+        /**
+         * Build the subtree below this %chunk from the given objects. Split
+         * planes are placed at the median of the objects, so that children
+         * end up with about the same number of objects each.
+         * @param objects array of objects to distribute.
+         * @param count number of objects in the array.
+         * @param scratch temporary storage for at least count values.
+         * @param buffer temporary storage for at least count objects.
+         */
+        void build (chunk_info **objects, const u_int32 & count, s_int32 *scratch, chunk_info **buffer);
+
         /**
          * Generate a picture of the chunk (and its children) in .dot format, as
          * parsed by AT&Ts graphviz package.
@@ -26,69 +26,19 @@
  * 
  */
 
-#include <adonthell/base/hash_map.h>
 #include "placeable_model.h"
-
-#ifndef __clang__
-#if __GNUC__ < 4 || (__GNUG__ == 4 && __GNUC_MINOR__ < 4)
-
-// allow to use placeable_model pointer as key in a hashmap when we do not have
-// access tr1::unordered_map
-namespace std
-{
-    template<> struct equal_to<world::placeable_model*>
-    {
-        bool operator()(const world::placeable_model *a, const world::placeable_model *b) const 
-        {
-            return a == b;
-        }
-    };
-}
-
-namespace __gnu_cxx 
-{
-    template<> struct hash<world::placeable_model*>
-    {
-        size_t operator() (const world::placeable_model *m) const 
-        { 
-            return (size_t) m; 
-        }
-    };
-}
-
-#endif
-#endif
-
 #include "chunk_info.h"
 
 using world::chunk_info;
 
-
-void chunk_info::add_shadow (world::placeable_model* model, const world::shadow_info & s)
-{
-    Shadow[model].push_back (s);
-}
-
-void chunk_info::remove_shadow (const s_int32 & x, const s_int32 & y) 
+// remove all parts of the given shadow
+void chunk_info::remove_shadow (const world::shadow *caster) 
 { 
-    std::hash_map<world::placeable_model*, std::vector<world::shadow_info> >::iterator i;
-    std::vector<world::shadow_info>::iterator shdw;
-    
-    for (i = Shadow.begin(); i != Shadow.end(); i++)
+    std::vector<world::shadow_info>::iterator shdw = Shadow.begin();
+
+    while (shdw != Shadow.end())
     {
-        for (shdw = i->second.begin(); shdw != i->second.end(); shdw++)
-        {
-            if (shdw->X == x && shdw->Y == y)
-            {
-                i->second.erase (shdw);
-                return;
-            }
-        }
+        if (shdw->Caster == caster) shdw = Shadow.erase (shdw);
+        else shdw++;
     }
 }
-
-// get shadows cast on given part of this object
-const std::vector<world::shadow_info> *chunk_info::get_shadow (world::placeable_model* model)
-{
-    return &Shadow[model];
-}
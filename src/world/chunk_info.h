@@ -30,7 +30,6 @@
 #ifndef WORLD_CHUNK_INFO_H
 #define WORLD_CHUNK_INFO_H
 
-#include <adonthell/base/hash_map.h>
 #include "entity.h"
 #include "shadow_info.h"
 
@@ -176,25 +175,31 @@ namespace world
          */
         //@{
         /**
-         * Add a shadow to a part of this placeable.
-         * @param model part of the model on which the shadow is cast.
-         * @param shadow the shadow to add.
+         * Add a shadow to a part of this placeable. The part is
+         * given by shadow_info::Model.
+         * @param s the shadow to add.
          */
-        void add_shadow (placeable_model* model, const shadow_info & s);
+        void add_shadow (const shadow_info & s)
+        {
+            Shadow.push_back (s);
+        }
         
         /**
-         * Remove shadow from the placeable.
-         * @param x x-coordinate of shadow to remove.
-         * @param y y-coordinate of shadow to remove.
+         * Remove all parts of the given shadow from the placeable.
+         * @param caster the shadow to remove.
          */
-        void remove_shadow (const s_int32 & x, const s_int32 & y);
+        void remove_shadow (const shadow *caster);
         
         /**
-         * Get pointer to all shadows cast on this placeable.
-         * @param model part of the placeable for which to return the shadows.
+         * Get pointer to all shadows cast on this placeable. Each
+         * shadow_info is tagged with the part of the placeable it
+         * has been cast on.
          * @return the vector of shadows.
          */
-        const std::vector<shadow_info> *get_shadow (placeable_model* model);
+        const std::vector<shadow_info> *get_shadow () const
+        {
+            return &Shadow;
+        }
         //@}
         
         /// position of the object
@@ -229,7 +234,7 @@ namespace world
         /// location specific action
         action * Action;
         /// shadow cast on this object 
-        std::hash_map<placeable_model*, std::vector<shadow_info> > Shadow;
+        std::vector<shadow_info> Shadow;
         /// extend of the solid portion of the object
         vector3<s_int32> SolidMax;
     };
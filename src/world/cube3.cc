@@ -184,7 +184,7 @@ bool cube3::put_state (base::flat & file) const
 bool cube3::get_state (base::flat & file)
 {
 	bool result = true;
-	base::flat record = file.get_flat ("cube");
+	base::flat_view record (file, "cube");
 	for (u_int32 i = 0; result && i < NUM_CORNERS; i++)
 	{
 		result = result & Corners[i].get_state (record);
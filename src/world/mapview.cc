@@ -29,6 +29,8 @@
 
 #include <limits.h>
 
+#include <adonthell/base/telemetry.h>
+#include <adonthell/base/trace.h>
 #include <adonthell/gfx/screen.h>
 #include <adonthell/python/pool.h>
 #include "mapview.h"
@@ -170,6 +172,8 @@ void mapview::center_on (const s_int32 & x, const s_int32 & y)
 // render map
 void mapview::draw (const s_int16 & x, const s_int16 & y, const gfx::drawing_area * da_opt, gfx::surface * target) const
 {
+    base::telemetry::scope measure (base::telemetry::RENDER);
+    base::trace::zone zone ("mapview::draw");
     area *map = world::area_manager::get_map();
     
     // is there something to draw at all?
@@ -85,7 +85,7 @@ namespace world
          * @param the actor performing the move, while still at its starting
          * position.
          */
-        move_event (const world::moving *actor)
+        move_event (const world::moving *actor) : CheckEnter (NULL), CheckLeave (NULL)
         {
             Actor = actor;
             Start = world::vector3<s_int32>(*actor);
@@ -132,6 +132,15 @@ namespace world
             return "move_event";
         }
 
+        /**
+         * Create a copy of this %event for deferred dispatch.
+         * @return a new copy of this %event.
+         */
+        events::event *clone () const
+        {
+            return new move_event (*this);
+        }
+
         /**
          * Get start position of movement.
          * @return start position of movement.
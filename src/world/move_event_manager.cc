@@ -35,16 +35,20 @@ using world::move_event;
 // function returning a new move event
 NEW_EVENT (world, move_event)
 
+// the manager instance
+move_event_manager *move_event_manager::Instance = NULL;
+
 // register move events with event subsystem
 move_event_manager::move_event_manager () : manager_base (&new_move_event)
 {
-	// nothing to do here
+    Instance = this;
 }
 
 // dtor
 move_event_manager::~move_event_manager ()
 {
     Events.clear();
+    if (Instance == this) Instance = NULL;
 }
 
 // See whether a matching event is registered and execute the
@@ -62,6 +66,9 @@ void move_event_manager::raise_event (const event *e)
             continue;
         }
 
+        // a previous callback might have destroyed the actor
+        if (!is_valid (e)) break;
+
         if ((*i)->equals (e))
         {
             (*i)->raise_event (e);
@@ -71,6 +78,105 @@ void move_event_manager::raise_event (const event *e)
     }
 }
 
+// queue a move, merging it with a previous move of the same actor
+void move_event_manager::queue_event (const event *e)
+{
+    const world::moving *actor = ((const move_event *) e)->actor ();
+    std::map<const world::moving*, event*>::iterator i = Pending.find (actor);
+
+    // the start position of the earlier move is kept, the end
+    // position is always the actor's current position.
+    if (i == Pending.end ())
+    {
+        event *copy = e->clone ();
+        Pending[actor] = copy;
+        Queue.push_back (copy);
+    }
+}
+
+// raise queued events
+void move_event_manager::dispatch ()
+{
+    if (Queue.empty ()) return;
+
+    // callbacks might queue new moves while we dispatch, or destroy
+    // actors whose moves are still to be raised
+    std::vector<event*> queue;
+    queue.swap (Queue);
+    Dispatching.swap (Pending);
+    Pending.clear ();
+
+    if (dispatch_mode () == events::DISPATCH_BATCHED)
+    {
+        raise_events (std::vector<const event*> (queue.begin (), queue.end ()));
+    }
+    else
+    {
+        for (std::vector<event*>::iterator i = queue.begin (); i != queue.end (); i++)
+        {
+            if (is_valid (*i)) raise_event (*i);
+        }
+    }
+
+    Dispatching.clear ();
+    Dropped.clear ();
+    for (std::vector<event*>::iterator i = queue.begin (); i != queue.end (); i++)
+        delete *i;
+}
+
+
+// drop queued move of an actor that is destroyed
+void move_event_manager::remove_actor (const world::moving *actor)
+{
+    if (Instance == NULL) return;
+
+    // a move being dispatched is skipped, and deleted once done
+    std::map<const world::moving*, event*>::iterator d = Instance->Dispatching.find (actor);
+    if (d != Instance->Dispatching.end ())
+    {
+        Instance->Dropped.insert (d->second);
+        Instance->Dispatching.erase (d);
+    }
+
+    std::map<const world::moving*, event*>::iterator i = Instance->Pending.find (actor);
+    if (i == Instance->Pending.end ()) return;
+
+    std::vector<event*> & queue = Instance->Queue;
+    std::vector<event*>::iterator e = std::find (queue.begin (), queue.end (), i->second);
+    if (e != queue.end ()) queue.erase (e);
+
+    delete i->second;
+    Instance->Pending.erase (i);
+}
+
+// hand every listener the batch of events matching it
+void move_event_manager::raise_events (const std::vector<const event*> & evnts)
+{
+    std::vector<const event*> batch;
+
+    for (std::list<listener*>::iterator i = Events.begin(); i != Events.end(); /* nothing */)
+    {
+        if ((*i)->is_destroyed())
+        {
+            events::listener *temp = *i;
+            i = Events.erase(i);
+            delete temp;
+
+            continue;
+        }
+
+        batch.clear ();
+        for (std::vector<const event*>::const_iterator e = evnts.begin (); e != evnts.end (); e++)
+        {
+            if (is_valid (*e) && (*i)->equals (*e)) batch.push_back (*e);
+        }
+
+        if (!batch.empty ()) (*i)->raise_events (batch);
+
+        i++;
+    }
+}
+
 // Unregister a listener
 void move_event_manager::remove (listener *li)
 {
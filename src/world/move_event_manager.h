@@ -30,6 +30,8 @@
 #include <adonthell/event/manager_base.h>
 
 #include <list>
+#include <map>
+#include <set>
 
 using events::manager_base;
 using events::listener;
@@ -37,6 +39,8 @@ using events::event;
 
 namespace world
 {
+	class moving;
+
 	/**
 	 * Manager keeping track of move_events.
 	 */
@@ -75,9 +79,65 @@ namespace world
          */
         void raise_event (const event* ev);
 
+        /**
+         * Queue a move %event for deferred dispatch. Only one move per
+         * actor is kept until the next dispatch, starting at the position
+         * the actor had at its first move and ending at its current
+         * position.
+         *
+         * @param ev %event to queue.
+         */
+        void queue_event (const event* ev);
+
+        /**
+         * Raise all move events queued since the last call.
+         */
+        void dispatch ();
+
+        /**
+         * Drop the queued move of the given actor, if any. Called
+         * when the actor is destroyed before its move is dispatched,
+         * which includes being destroyed by a callback while the
+         * queued moves are being raised.
+         *
+         * @param actor the actor about to be destroyed.
+         */
+        static void remove_actor (const world::moving *actor);
+
 	protected:
+        /**
+         * Pass each %listener all queued move events matching it at once.
+         *
+         * @param evnts the queued events.
+         */
+        void raise_events (const std::vector<const event*> & evnts);
+
 		/// registered move events
 		std::list<listener*> Events;
+
+        /**
+         * Check whether a move is still valid, i.e. it is not being
+         * dispatched while its actor has been destroyed.
+         *
+         * @param ev the move to check.
+         * @return \b false if the move must no longer be raised.
+         */
+        bool is_valid (const event *ev) const
+        {
+            return Dropped.empty () || Dropped.find (ev) == Dropped.end ();
+        }
+
+		/// queued move events by actor
+		std::map<const world::moving*, event*> Pending;
+
+		/// moves currently being dispatched by actor
+		std::map<const world::moving*, event*> Dispatching;
+
+		/// moves being dispatched whose actor has been destroyed
+		std::set<const event*> Dropped;
+
+		/// the manager instance
+		static move_event_manager *Instance;
 	};
 	
 }
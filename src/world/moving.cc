@@ -36,6 +36,7 @@
 #include "plane3.h"
 #include "shadow.h"
 #include "move_event.h"
+#include "move_event_manager.h"
 #include <adonthell/event/manager.h>
 #include <adonthell/base/logging.h>
 
@@ -71,6 +72,7 @@ moving::moving (world::area & mymap, const std::string & hash)
     GroundPos = -10000;
     MyShadow = NULL;
     Terrain = NULL;
+    HasPlan = false;
 
 #if DEBUG_COLLISION
     Image = gfx::create_surface();
@@ -82,6 +84,9 @@ moving::moving (world::area & mymap, const std::string & hash)
 // dtor
 moving::~moving ()
 {
+    // a queued move must not refer to us once we are gone
+    move_event_manager::remove_actor (this);
+
     delete MyShadow;
 #if DEBUG_COLLISION
     delete Image;
@@ -93,12 +98,16 @@ void moving::set_velocity (const float & vx, const float & vy)
 {
     Velocity.set_x (vx);
     Velocity.set_y (vy);
+
+    if (vx != 0.0f || vy != 0.0f) Mymap.wake (this);
 }
 
 // indicate falling or jumping
 void moving::set_vertical_velocity (const float & vz)
 {
     Velocity.set_z (vz);
+
+    if (vz != 0.0f) Mymap.wake (this);
 }
 
 // set x,y coordinates
@@ -111,6 +120,9 @@ void moving::set_position (const s_int32 & x, const s_int32 & y)
     // precise location
     Position.set_x (x);
     Position.set_y (y);
+
+    // there might be different ground below us
+    Mymap.wake (this);
 }
 
 // set z position
@@ -119,6 +131,9 @@ void moving::set_altitude (const s_int32 & z)
     coordinates::set_z (z);
     Position.set_z (z);
     GroundPos = z;
+
+    // there might be different ground below us
+    Mymap.wake (this);
 }
 
 // check objects on map for collision
@@ -143,6 +158,9 @@ bool moving::collide_with_objects (collision *collisionData)
     {
         const placeable *object = (*i)->get_object();
 
+        // when planning a move, we are still on the map ourself
+        if (object == this) continue;
+
         // check all models the placeable consists of
         for (placeable::iterator model = object->begin(); model != object->end(); model++)
         {
@@ -223,7 +241,7 @@ vector3<float> moving::execute_move (collision *collisionData, u_int16 depth)
 }
 
 // calculate new position
-void moving::update_position ()
+vector3<float> moving::calculate_position ()
 {
     static float gravity = -4.905f;
     
@@ -297,21 +315,43 @@ void moving::update_position ()
     Velocity.set_z (vz);
     
     // convert final result back to R3
-    float x = (finalPosition.x() - 1) * eRadius.x();
-    float y = (finalPosition.y() - 1) * eRadius.y();
-    float z = (finalPosition.z() - 1) * eRadius.z();
+    vector3<float> result ((finalPosition.x() - 1) * eRadius.x(),
+                           (finalPosition.y() - 1) * eRadius.y(),
+                           (finalPosition.z() - 1) * eRadius.z());
         
 #if DEBUG_COLLISION
     if (tri != NULL)
     {
         // draw actual movement along x,y axis
-        Image->draw_line (pos_x, pos_y, (u_int16) (pos_x + (x - Position.x()) * 20), (u_int16) (pos_y + (y - Position.y()) * 20), Image->map_color (0, 255, 0), &da);
+        Image->draw_line (pos_x, pos_y, (u_int16) (pos_x + (result.x() - Position.x()) * 20), (u_int16) (pos_y + (result.y() - Position.y()) * 20), Image->map_color (0, 255, 0), &da);
     
         // draw actual movement along z axis
-        Image->draw_line (pos_x, pos_y, pos_x, (u_int16) (pos_y - (z - Z) * 20), Image->map_color (0, 255, 0), &da);
+        Image->draw_line (pos_x, pos_y, pos_x, (u_int16) (pos_y - (result.z() - Z) * 20), Image->map_color (0, 255, 0), &da);
     }
 #endif
 
+    return result;
+}
+
+// plan movement without changing the map
+void moving::plan_move ()
+{
+    if (is_moving ())
+    {
+        Planned = calculate_position ();
+        HasPlan = true;
+    }
+}
+
+// update position on the map
+void moving::update_position ()
+{
+    const vector3<float> pos = HasPlan ? Planned : calculate_position ();
+    const float x = pos.x();
+    const float y = pos.y();
+    const float z = pos.z();
+    HasPlan = false;
+
     // update position on map, which must be in whole pixels     
     X = (s_int32) round(x);
     Y = (s_int32) round(y);
@@ -352,16 +392,16 @@ void moving::calculate_ground_pos ()
     
     if (!ground_tiles.empty ())
     {
-        // prepare shadow
-        MyShadow->init ();
-
         // sort according to their z-Order
         ground_tiles.sort (z_order());
 
+        // prepare shadow, unless it is still valid from last time
+        bool cached = MyShadow == NULL || MyShadow->init (ground_tiles);
+
         // find tile beneath character
         for (ci = ground_tiles.begin (); ci != ground_tiles.end(); ci++)
         {
-            MyShadow->cast_on (*ci);
+            if (!cached) MyShadow->cast_on (*ci);
 
             // position of character's center relative to tile
             s_int32 px = x() + placeable::length()/2 - (*ci)->center_min().x();
@@ -381,7 +421,7 @@ void moving::calculate_ground_pos ()
         }
 
         // apply remainder of shadow
-        while (ci != ground_tiles.end())
+        while (!cached && ci != ground_tiles.end())
         {
             MyShadow->cast_on (*ci);
             ci++;
@@ -389,6 +429,9 @@ void moving::calculate_ground_pos ()
     }
     else
     {
+        // nothing to cast our shadow on
+        if (MyShadow != NULL) MyShadow->reset ();
+
         // there are no objects below ... this also means we will
         // drop out of the world, so here could be a good place
         // to avoid this. But for now we'll just let it happen ...
@@ -398,6 +441,16 @@ void moving::calculate_ground_pos ()
 
 // update movable position
 bool moving::update ()
+{
+    begin_update ();
+    move ();
+    end_update ();
+
+    return true; 
+}
+
+// move on the map
+void moving::move ()
 {
     // this is a dummy, as we don't know the real entity
     named_entity e (this, "", false);
@@ -408,17 +461,23 @@ bool moving::update ()
 #endif
     
     // we can skip the whole collision stuff if we're not moving
-    if (vx() != 0.0f || vy() != 0.0f || vz() != 0.0f || GroundPos != Z)
+    if (is_moving ())
     {
-        // reset shadow for next frame
-        MyShadow->reset ();
-
         // prepare move notification (before the move takes place!)
         world::move_event evt (this);
 
         entity *myEntity = Mymap.remove (&e, *this);
         if (myEntity != NULL)
         {
+            // objects resting on top of us might start falling
+            const vector3<s_int32> min (x(), y(), z() + placeable::height());
+            const vector3<s_int32> max (x() + placeable::length() - 1, y() + placeable::width() - 1, min.z());
+            const std::list<chunk_info*> & above = Mymap.objects_in_bbox (min, max, CHARACTER);
+            for (std::list<chunk_info*>::const_iterator i = above.begin(); i != above.end(); i++)
+            {
+                Mymap.wake ((*i)->get_object());
+            }
+
             update_position ();
             Mymap.add (myEntity, *this);
 
@@ -426,8 +485,9 @@ bool moving::update ()
             events::manager::raise_event(&evt);
         }
     }
-    
-    return true; 
+
+    // discard plan if we did not move after all
+    HasPlan = false;
 }
 
 // debugging
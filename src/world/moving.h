@@ -141,6 +141,74 @@ namespace world
          */
         virtual bool update (); 
 
+        /**
+         * Check whether the object needs to move this cycle.
+         * @return \b true if the object has a velocity or is falling.
+         */
+        bool is_moving () const
+        {
+            return Velocity.x() != 0.0f || Velocity.y() != 0.0f || Velocity.z() != 0.0f || GroundPos != Z;
+        }
+
+        /**
+         * A moving object is idle while it is not moving. Changing
+         * its position or velocity will wake it up again.
+         * @return true if the object is idle, false otherwise.
+         */
+        virtual bool is_idle () const
+        {
+            return !is_moving ();
+        }
+
+#ifndef SWIG
+        /**
+         * @name Two-phase update
+         *
+         * The update of a moving object is split into several steps, so
+         * that the expensive collision detection of all objects on a map
+         * can run in parallel. update() simply performs them in order.
+         *
+         * To update objects in parallel, begin_update() is called for each
+         * object first. Then plan_move() is called concurrently for all of
+         * them. Finally move() and end_update() are called for each object
+         * in turn. As all planned moves are based on the same state of the
+         * map, the outcome does not depend on the number of threads used.
+         */
+        //@{
+        /**
+         * Perform everything that has to happen before moving, like
+         * deciding on a new velocity.
+         */
+        virtual void begin_update ()
+        {
+        }
+
+        /**
+         * Calculate the position this object will move to, based on the
+         * current state of the map. Neither map nor any other object will
+         * be modified, so it is safe to call this for different objects
+         * concurrently. The result is applied by the following call to
+         * move().
+         */
+        void plan_move ();
+
+        /**
+         * Move the object on the map, using the position calculated by
+         * plan_move() if available, and notify interested parties about
+         * the move.
+         */
+        void move ();
+
+        /**
+         * Perform everything that has to happen after moving, like
+         * reacting to having landed on the ground.
+         */
+        virtual void end_update ()
+        {
+        }
+        //@}
+#endif
+
         /**
          * When compiled with -DDEBUG_COLLISION, calling this method
          * before blitting a frame to the screen will create an overlay with
@@ -161,6 +229,12 @@ namespace world
          * Update position on the map.
          */
         void update_position ();
+
+        /**
+         * Calculate the position the object would move to.
+         * @return the position in world space.
+         */
+        vector3<float> calculate_position ();
         
         /**
          * Find the z-position of the ground under the movable.
@@ -201,6 +275,11 @@ namespace world
 
         /// the type of terrain this moveable sits on
         const std::string *Terrain;
+
+        /// position calculated by plan_move ()
+        vector3<float> Planned;
+        /// whether Planned holds the position for the next move
+        bool HasPlan;
         
     private:
         /// for debugging
@@ -25,6 +25,7 @@
  */
 
 #include <adonthell/base/diskio.h>
+#include <adonthell/base/trace.h>
 #include "pathfinding_manager.h"
 #include "area_manager.h"
 #include "character.h"
@@ -278,6 +279,7 @@ const world::pathfinding_task* pathfinding_manager::get_task(const s_int16 & id)
 
 void pathfinding_manager::update()
 {
+    base::trace::zone zone ("pathfinding_manager::update");
     for (s_int16 id = 0; id <= m_taskHighest; id++)
     {
         if (m_locked[id] == true)
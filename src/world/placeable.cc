@@ -32,6 +32,7 @@
 #include "placeable_shape.h"
 #include "area.h"
 #include <adonthell/base/logging.h>
+#include <adonthell/base/state_name.h>
 
 using world::placeable;
 
@@ -60,6 +61,7 @@ placeable::placeable(world::area & mymap, const std::string & hash)
     Type = UNKNOWN;
     Solid = true;
     State = "";
+    StateId = 0;
     HaveSolid = false;
     HaveEntire = false;
 }
@@ -85,12 +87,23 @@ const std::string & placeable::uid () const
 
 // change state of placeable
 void placeable::set_state (const std::string & state)
+{
+    set_state (base::state_name::id (state));
+}
+
+// change state of placeable by id
+void placeable::set_state (const u_int16 & state)
 {   
     // object becomes solid if there is at least one solid component
     Solid = false;
 
     std::vector<world::placeable_model*>::iterator i = Model.begin();
-    State = (*i)->set_shape (state);
+    u_int16 id = (*i)->set_shape (state);
+    if (id != StateId)
+    {
+        State = base::state_name::name (id);
+        StateId = id;
+    }
 
     // reset current size and position
     const placeable_shape *shape = (*i)->current_shape ();
@@ -111,7 +124,7 @@ void placeable::set_state (const std::string & state)
     // update shape and size of composite placeables
     for (i++; i != Model.end(); i++)
     {
-        (*i)->set_shape (State);
+        (*i)->set_shape (StateId);
         const placeable_shape *shape = (*i)->current_shape ();
         if (shape != NULL)
         {
@@ -333,7 +346,7 @@ bool placeable::load_model (base::flat & model)
     // load shapes and sprites
     while (model.next (&value, &size, &name) == base::flat::T_FLAT) 
     {
-        base::flat pm ((const char*) value, size);
+        base::flat_view pm (value, size);
         placeable_model * mdl = new placeable_model ();
         mdl->get_state (pm);
         add_model (mdl);
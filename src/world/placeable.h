@@ -99,14 +99,23 @@ namespace world
         /**
          * Update placeable each game cycle.
          * @return true on success, false otherwise.
-         * @todo if only characters really require this,
-         *      then limit to those for efficiency.
          */
         virtual bool update ()
         {
             return true;
         }
 
+        /**
+         * Check whether the placeable has nothing to do. Idle placeables
+         * are no longer updated each game cycle, until area::wake() is
+         * called for them.
+         * @return true if the placeable is idle, false otherwise.
+         */
+        virtual bool is_idle () const
+        {
+            return true;
+        }
+
         /**
          * @name Placeable representation
          *
@@ -323,6 +332,24 @@ namespace world
          */
         void set_state (const std::string & state);
 
+#ifndef SWIG
+        /**
+         * Set the state of the underlying model by the id
+         * of its name. This saves looking up the state by
+         * name for frequent state changes.
+         *
+         * @param state id of the new state, as returned by
+         *      base::state_name::id().
+         */
+        void set_state (const u_int16 & state);
+
+        /**
+         * Get the id of the current state of the placeable.
+         * @return id of the current state of the placeable.
+         */
+        u_int16 state_id () const { return StateId; }
+#endif // SWIG
+
         /**
          * Get the current state of the placeable.
          * @return current state of the placeable.
@@ -422,6 +449,8 @@ namespace world
         vector3<s_int16> EntireCurPos;
         /// the placeables current state
         std::string State;
+        /// id of the placeables current state
+        u_int16 StateId;
         /// whether placeable is character, scenery or item
         placeable_type Type;
         /// whether the placeable in its current state is solid or not 
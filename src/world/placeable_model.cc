@@ -29,6 +29,7 @@
  */
 
 
+#include <adonthell/base/state_name.h>
 #include "placeable_model.h"
 
 using namespace world;
@@ -37,6 +38,7 @@ using namespace world;
 placeable_model::placeable_model()
 {
     CurrentShape = Shapes.end ();
+    CurrentShapeId = 0;
     Terrain = "None";
 }
 
@@ -74,51 +76,68 @@ const std::string placeable_model::current_shape_name() const
 // add new shape
 placeable_shape * placeable_model::add_shape (const std::string & name)
 {
+    ShapeById.clear ();
     return &((Shapes.insert(std::pair<const std::string, const placeable_shape> (name, placeable_shape()))).first->second);
 }
 
 // delete given shape
 bool placeable_model::del_shape (const std::string & name)
 {
+    ShapeById.clear ();
     return Shapes.erase(name);
 }
 
 // set the current shape
 std::string placeable_model::set_shape (const std::string & name)
 {
-    // shape is already set
-    if (CurrentShape != Shapes.end() && CurrentShape->first == name)
-        return name;
+    set_shape (base::state_name::id (name));
+    return current_shape_name ();
+}
+
+// set the current shape by id
+u_int16 placeable_model::set_shape (const u_int16 & id)
+{
+    // index shapes by the id of their name
+    if (ShapeById.empty ())
+    {
+        for (iterator i = Shapes.begin (); i != Shapes.end (); i++)
+        {
+            u_int16 shape_id = base::state_name::id (i->first);
+            if (shape_id >= ShapeById.size ()) ShapeById.resize (shape_id + 1, Shapes.end ());
+            ShapeById[shape_id] = i;
+        }
+    }
 
-    // keep track of current shape in case we need to revert
-    std::map <std::string, placeable_shape>::iterator prev_shape = CurrentShape;
+    // shape is already set
+    if (CurrentShape != Shapes.end() && CurrentShapeId == id)
+        return id;
 
-    if (name == "")
+    iterator shape;
+    if (id == 0)
     {
         // set default shape
-        CurrentShape = Shapes.begin ();
+        shape = Shapes.begin ();
     }
     else
     {
         // find new shape
-        CurrentShape = Shapes.find (name);
-    }
-    
-    if (CurrentShape == Shapes.end())
-    {
-        // shape not found
-        CurrentShape = prev_shape;
+        shape = id < ShapeById.size () ? ShapeById[id] : Shapes.end ();
     }
-    else
+
+    // shape not found, keep current shape
+    if (shape == Shapes.end())
+        return CurrentShapeId;
+
+    CurrentShape = shape;
+    CurrentShapeId = id == 0 ? base::state_name::id (shape->first) : id;
+
+    // shape found, update sprite
+    if (Sprite.change_animation (id))
     {
-        // shape found, update sprite
-        if (Sprite.change_animation (name))
-        {
-            Sprite.play ();
-        }
+        Sprite.play ();
     }
-    
-    return CurrentShape->first;
+
+    return CurrentShapeId;
 }
 
 // set graphical representation of model
@@ -138,7 +157,7 @@ gfx::sprite *placeable_model::get_sprite ()
 
         if (CurrentShape != Shapes.end())
         {
-            Sprite.change_animation (CurrentShape->first);
+            Sprite.change_animation (CurrentShapeId);
             Sprite.play ();
         }
     }
@@ -180,13 +199,14 @@ bool placeable_model::get_state (base::flat & file)
     // load actual shapes
     while (file.next (&value, &size, &name) == base::flat::T_FLAT)
     {
-        base::flat shape ((const char*) value, size);
+        base::flat_view shape (value, size);
         placeable_shape * mpa = add_shape (std::string (name));
         mpa->get_state (shape);
     }
 
     // no shape selected yet
     CurrentShape = Shapes.end();
+    CurrentShapeId = 0;
 
     // get associated sprite
     std::string sprite = file.get_string ("sprite");
@@ -127,6 +127,17 @@ namespace world
          * @return name of the shape actually activated.
          */
         std::string set_shape (const std::string & name);
+
+#ifndef SWIG
+        /**
+         * Make shape with given id the current shape. If no such
+         * shape exists, the current shape remains unchanged.
+         * @param id id of the name of the shape to activate, as
+         *      returned by base::state_name::id().
+         * @return id of the name of the shape actually activated.
+         */
+        u_int16 set_shape (const u_int16 & id);
+#endif // SWIG
         //@}
 
         /**
@@ -207,6 +218,10 @@ namespace world
         mutable std::map <std::string, placeable_shape> Shapes;
         /// current state of this object
         std::map <std::string, placeable_shape>::iterator CurrentShape;
+        /// id of the name of the current state
+        u_int16 CurrentShapeId;
+        /// states of this object by id of their name, built on demand
+        std::vector<std::map <std::string, placeable_shape>::iterator> ShapeById;
         /// the sprite associated with this model
         gfx::sprite Sprite;
         /// type of terrain this object represents
@@ -180,7 +180,7 @@ bool placeable_shape::put_state (base::flat & file) const
 // load from stream
 bool placeable_shape::get_state (base::flat & file)
 {
-	base::flat record = file.get_flat ("shape");
+	base::flat_view record (file, "shape");
     if (!file.success ()) return false;
 
     // optional non-solid flag, false if missing
@@ -50,10 +50,12 @@ public:
      * @param shape the physical representation of the object
      * @param sprite the graphical representation of the object
      * @param pos the position of the object in world-space
-     * @param shdw the shadow cast onto this object
+     * @param shdw the shadows cast onto the placeable this object belongs to
+     * @param model the part of the placeable represented by this object
      */
-    render_info (const placeable_shape *shape, const gfx::sprite *sprite, const vector3<s_int32> & pos, const std::vector<shadow_info> *shdw) 
-    : Pos (pos), Shape (shape), Sprite (sprite), Shadow (shdw)
+    render_info (const placeable_shape *shape, const gfx::sprite *sprite, const vector3<s_int32> & pos,
+                 const std::vector<shadow_info> *shdw, const placeable_model *model) 
+    : Pos (pos), Shape (shape), Sprite (sprite), Shadow (shdw), Model (model)
     {
         Projection[0] = x() /*+ shape->ox()*/;
         Projection[1] = y() /*+ shape->oy()*/ - z() - shape->height();
@@ -66,7 +68,7 @@ public:
      * @param ri the render data to duplicate.
      */
     render_info (const render_info & ri)
-    : Pos (ri.Pos), Shape (ri.Shape), Sprite (ri.Sprite), Shadow (ri.Shadow)
+    : Pos (ri.Pos), Shape (ri.Shape), Sprite (ri.Sprite), Shadow (ri.Shadow), Model (ri.Model)
     {
         Projection[0] = ri.Projection[0];
         Projection[1] = ri.Projection[1];
@@ -177,8 +179,10 @@ public:
     const placeable_shape *Shape;
     /// the object's graphical representation
     const gfx::sprite *Sprite;
-    /// shadows cast onto this object
+    /// shadows cast onto the placeable this object belongs to
     const std::vector<shadow_info> *Shadow;
+    /// the part of the placeable represented by this object
+    const placeable_model *Model;
     
 private:
     /// the 2D projection of the object onto the drawing surface
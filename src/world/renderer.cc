@@ -45,10 +45,13 @@ void renderer_base::draw (const s_int16 & x, const s_int16 & y, const render_inf
         // render shadows cast onto the object
         for (std::vector<shadow_info>::const_iterator shdw = obj.Shadow->begin(); shdw != obj.Shadow->end(); shdw++)
         {
+            // skip shadows cast onto other parts of the object
+            if (shdw->Model != obj.Model) continue;
+
             // set shadow opacity according to distance above ground
             shdw->Image->set_alpha (192 - (shdw->Distance > 192 ? 32 : shdw->Distance));
             // draw all pieces of the shadow
-            for (std::list<gfx::drawing_area>::const_iterator area = shdw->Area.begin(); area != shdw->Area.end(); area++)
+            for (std::vector<gfx::drawing_area>::const_iterator area = shdw->Area.begin(); area != shdw->Area.end(); area++)
             {
                 // relocate area to mapview position
                 gfx::drawing_area part (x + area->x(), y + area->y() - (obj.z() + obj.Shape->height()), area->length(), area->height());
@@ -73,7 +76,7 @@ void default_renderer::render (const s_int16 & x, const s_int16 & y, const std::
         
         for (placeable::iterator obj = object->begin(); obj != object->end(); obj++)
         {
-            render_queue.push_back (render_info ((*obj)->current_shape(), (*obj)->get_sprite(), (*i)->center_min(), (*i)->get_shadow(*obj)));
+            render_queue.push_back (render_info ((*obj)->current_shape(), (*obj)->get_sprite(), (*i)->center_min(), (*i)->get_shadow(), *obj));
         }
     }
     
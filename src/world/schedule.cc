@@ -25,6 +25,8 @@
  */
  
 #include "schedule.h"
+#include "area.h"
+#include "character.h"
 #include <adonthell/event/date.h>
 #include <adonthell/event/time_event.h>
 
@@ -32,11 +34,15 @@ using world::schedule;
 
 // standart constructor
 schedule::schedule ()
+    : Run ("run"), Start ("start"), Pause ("pause"), Resume ("resume"), Stop ("stop")
 {
     Paused = 0;
     Running = false;
     QueuedSchedule = NULL;
     Owner = NULL;
+    ManagerBehaviour = NULL;
+    ScheduleBehaviour = NULL;
+    RunningManager = NULL;
 }
 
 // destructor
@@ -44,6 +50,7 @@ schedule::~schedule ()
 {
     clear_schedule();
     delete QueuedSchedule;
+    delete_behaviour (ManagerBehaviour);
 }
 
 // execute the schedule
@@ -68,18 +75,60 @@ void schedule::update ()
             clear_schedule ();
             
             // determine new schedule ...
-            Manager.call_method ("run");
+            if (ManagerBehaviour)
+            {
+                // the manager might replace itself while running
+                RunningManager = ManagerBehaviour;
+                RunningManager->run (this);
+
+                behaviour *manager = RunningManager;
+                RunningManager = NULL;
+                if (manager != ManagerBehaviour) delete_behaviour (manager);
+            }
+            else Manager.call_method (Run);
             
             // ... and start it
-            Schedule.call_method ("start");
+            start_schedule ();
             
             // pause schedule, if required
             if (Paused > 0)
             {
-                Schedule.call_method ("pause");
+                pause_schedule ();
             }
         }
     }
+    // native schedules may need to continue their activity
+    else if (ScheduleBehaviour != NULL && Paused == 0 && ScheduleBehaviour->needs_update ())
+    {
+        ScheduleBehaviour->update (this);
+    }
+}
+
+// stop the current schedule
+void schedule::clear_schedule ()
+{
+    if (ScheduleBehaviour)
+    {
+        delete_behaviour (ScheduleBehaviour);
+        ScheduleBehaviour = NULL;
+    }
+
+    Schedule.call_method (Stop);
+    Schedule.clear ();
+}
+
+// start the current schedule
+void schedule::start_schedule ()
+{
+    if (ScheduleBehaviour) ScheduleBehaviour->start (this);
+    else Schedule.call_method (Start);
+}
+
+// pause the current schedule
+void schedule::pause_schedule ()
+{
+    if (ScheduleBehaviour) ScheduleBehaviour->pause (this);
+    else Schedule.call_method (Pause);
 }
 
 // pause or resume schedule
@@ -90,7 +139,7 @@ void schedule::set_active (const bool & a)
         Paused++;
         if (Paused == 1)
         {
-            Schedule.call_method ("pause");
+            pause_schedule ();
         }
     }
     else if (Paused > 0)
@@ -98,13 +147,15 @@ void schedule::set_active (const bool & a)
         Paused--;
         if (Paused == 0)
         {
-            Schedule.call_method ("resume");
+            if (ScheduleBehaviour) ScheduleBehaviour->resume (this);
+            else Schedule.call_method (Resume);
         }
     }
     else
     {
-        LOG(WARNING) << "schedule " << Schedule.file_name() << "."
-                     << Schedule.class_name() << " is active already!";
+        if (ScheduleBehaviour) LOG(WARNING) << "schedule " << ScheduleBehaviour->name () << " is active already!";
+        else LOG(WARNING) << "schedule " << Schedule.file_name() << "."
+                          << Schedule.class_name() << " is active already!";
     }
 }
 
@@ -116,7 +167,29 @@ bool schedule::set_schedule (const string & file, PyObject *args)
         LOG(WARNING) << "stop current schedule first!";
         return false;
     }
-    
+
+    // native schedule takes precedence over script
+    behaviour *native = behaviour::create (file);
+    if (native != NULL)
+    {
+        if (!init_behaviour (native, args))
+        {
+            delete native;
+            return false;
+        }
+
+        delete_behaviour (ScheduleBehaviour);
+        ScheduleBehaviour = native;
+        Schedule.clear ();
+
+        Running = true;
+        Factory.clear ();
+        return true;
+    }
+
+    delete_behaviour (ScheduleBehaviour);
+    ScheduleBehaviour = NULL;
+
     // pass schedule as first argument
     PyObject *new_args = add_schedule (args);
 
@@ -137,6 +210,15 @@ bool schedule::set_schedule (const string & file, PyObject *args)
     return false;
 }
 
+// start or stop the current schedule
+void schedule::set_running (const bool & r)
+{
+    Running = r;
+
+    // make sure the manager gets a chance to run
+    if (!Running) wake ();
+}
+
 // queue a schedule
 void schedule::queue_schedule (const string & file, PyObject *args)
 {
@@ -148,8 +230,50 @@ void schedule::queue_schedule (const string & file, PyObject *args)
 // assign a (new) manager script
 bool schedule::set_manager (const string &file, PyObject *args)
 {
-    PyObject *new_args = add_schedule (args);
-    return Manager.create_instance (SCHEDULE_DIR + file, file, new_args);
+    bool result;
+
+    // native manager takes precedence over script
+    delete_behaviour (ManagerBehaviour);
+    ManagerBehaviour = behaviour::create (file);
+    if (ManagerBehaviour != NULL)
+    {
+        Manager.clear ();
+        result = init_behaviour (ManagerBehaviour, args);
+        if (!result)
+        {
+            delete ManagerBehaviour;
+            ManagerBehaviour = NULL;
+        }
+    }
+    else
+    {
+        PyObject *new_args = add_schedule (args);
+        result = Manager.create_instance (SCHEDULE_DIR + file, file, new_args);
+        Py_DECREF(new_args);
+    }
+
+    // make sure the manager gets a chance to run
+    wake ();
+    return result;
+}
+
+// pass arguments to native manager or schedule
+bool schedule::init_behaviour (behaviour *native, PyObject *args)
+{
+    base::flat record;
+    python::put_tuple (args, record);
+    if (!native->init (this, record))
+    {
+        LOG(ERROR) << "invalid arguments for behaviour '" << native->name () << "'.";
+        return false;
+    }
+    return true;
+}
+
+// update owner during the next game cycle
+void schedule::wake ()
+{
+    if (Owner != NULL) Owner->map().wake (Owner);
 }
 
 // get manager script, if initialized
@@ -225,12 +349,27 @@ void schedule::put_state (base::flat & file) const
     
     // save manager script
     base::flat record;
-    record.put_string ("script", Manager.class_name());
-    python::put_tuple (Manager.get_args(), record, 1);
+    if (ManagerBehaviour)
+    {
+        record.put_string ("script", ManagerBehaviour->name());
+        ManagerBehaviour->put_state (record);
+    }
+    else
+    {
+        record.put_string ("script", Manager.class_name());
+        python::put_tuple (Manager.get_args(), record, 1);
+    }
     file.put_flat ("mgr", record);
     
     // save schedule script, if any
-    if (Schedule.get_instance() != NULL)
+    if (ScheduleBehaviour)
+    {
+        record.clear();
+        record.put_string ("script", ScheduleBehaviour->name());
+        ScheduleBehaviour->put_state (record);
+        file.put_flat ("sdl", record);
+    }
+    else if (Schedule.get_instance() != NULL)
     {
         record.clear();
         record.put_string ("script", Schedule.class_name());
@@ -261,39 +400,29 @@ bool schedule::get_state (base::flat & file)
     // restore manager script
     
     record = file.get_flat ("mgr");
-    std::string script = record.get_string ("script");
-    PyObject *args = python::get_tuple (record, 1);
-    PyTuple_SET_ITEM (args, 0, python::pass_instance (this));
-    if (!Manager.create_instance (SCHEDULE_DIR + script, script, args))
+    if (!load_script (Manager, ManagerBehaviour, record))
     {
-        LOG(ERROR) << "failed loading manager script '" << script << "'.";
-        Py_DECREF(args);
+        LOG(ERROR) << "failed loading manager script '" << record.get_string ("script") << "'.";
         return false;
     }
-    Py_DECREF(args);
     
     // restore schedule script, if any
     record = file.get_flat ("sdl", false);
     if (record.size() > 1)
     {
-        script = record.get_string ("script");
-        args = python::get_tuple (record, 1);
-        PyTuple_SET_ITEM (args, 0, python::pass_instance (this));
-        if (!Schedule.create_instance (SCHEDULE_DIR + script, script, args))
+        if (!load_script (Schedule, ScheduleBehaviour, record))
         {
-            LOG(ERROR) << "failed loading schedule script '" << script << "'.";
-            Py_DECREF(args);
+            LOG(ERROR) << "failed loading schedule script '" << record.get_string ("script") << "'.";
             return false;
         }
-        Py_DECREF(args);
         
         // restart schedule
-        Schedule.call_method ("start");
+        start_schedule ();
         
         // pause schedule, if required
         if (Paused > 0)
         {
-            Schedule.call_method ("pause");
+            pause_schedule ();
         }        
     }
         
@@ -325,3 +454,38 @@ bool schedule::get_state (base::flat & file)
         
     return file.success ();
 }
+
+// restore manager or schedule
+bool schedule::load_script (python::script & script, behaviour *& native, base::flat & record)
+{
+    std::string name = record.get_string ("script");
+
+    delete_behaviour (native);
+    native = behaviour::create (name);
+    if (native != NULL)
+    {
+        script.clear ();
+        if (native->get_state (this, record)) return true;
+
+        delete native;
+        native = NULL;
+        return false;
+    }
+
+    PyObject *args = python::get_tuple (record, 1);
+    PyTuple_SET_ITEM (args, 0, python::pass_instance (this));
+    bool result = script.create_instance (SCHEDULE_DIR + name, name, args);
+    Py_DECREF(args);
+
+    return result;
+}
+
+// stop and delete a behaviour
+void schedule::delete_behaviour (behaviour *native)
+{
+    // deleted by update () once its run method returns
+    if (native == NULL || native == RunningManager) return;
+
+    native->stop (this);
+    delete native;
+}
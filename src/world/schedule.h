@@ -32,6 +32,7 @@
 #include <adonthell/python/script.h>
 #include <adonthell/event/factory.h>
 #include "schedule_data.h"
+#include "behaviour.h"
 
 /**
  * Path to the character schedule scripts.
@@ -64,6 +65,10 @@ namespace world
      *
      * It is possible to bypass the manager schedule and select a new
      * schedule by queuing it prior to calling set_running(false).
+     *
+     * Instead of scripts, both manager and %schedule may be native
+     * behaviours, if a %behaviour has been registered under the name
+     * given to set_manager() or set_schedule().
      */
     class schedule
     {
@@ -150,13 +155,36 @@ namespace world
          *
          * @param a \c false if the %schedule should be stopped, \c true otherwise.
          */
-        void set_running (const bool & r)    { Running = r; }
+        void set_running (const bool & r);
+
+#ifndef SWIG
+        /**
+         * Check whether the %schedule needs to be updated, i.e. whether
+         * the manager script has to pick a new %schedule.
+         * @return \c true if update() has work to do, \c false otherwise.
+         */
+        bool needs_update () const
+        {
+            if (Running)
+            {
+                return ScheduleBehaviour != NULL && Paused == 0 && ScheduleBehaviour->needs_update ();
+            }
+            return QueuedSchedule != NULL || ManagerBehaviour != NULL || Manager.get_instance (false) != NULL;
+        }
+
+        /**
+         * Make sure the owner of this schedule is updated
+         * during the next game cycle.
+         */
+        void wake ();
+#endif
                 
         /**
          * Assign a (new) manager script. This script is responsible for
          * the overall %character behaviour.
          *
-         * @param file Filename of the script to load.
+         * @param file Filename of the script to load, or name of a
+         *      native %behaviour.
          * @param args Addional arguments to pass to the script constructor.
          * @return \e true on success, \e false otherwise
          */
@@ -164,7 +192,8 @@ namespace world
 
         /**
          * Return a pointer to the manager script object.
-         * @return pointer to manager script or NULL if not initialized yet.
+         * @return pointer to manager script or NULL if not initialized yet
+         *      or if the manager is a native %behaviour.
          */
         const python::script *get_manager () const;
         //@}
@@ -179,7 +208,8 @@ namespace world
          * from the manager %schedule. From within a %schedule script, use
          * queue_schedule () instead.
          *
-         * @param file Filename of the script to load.
+         * @param file Filename of the script to load, or name of a
+         *      native %behaviour.
          * @param args Addional arguments to pass to the script constructor.
          *
          * @return \e true on success, \e false otherwise
@@ -192,11 +222,7 @@ namespace world
          * also run the destructor (__del__ method) of the script, if it
          * exists.
          */
-        void clear_schedule ()
-        {
-            Schedule.call_method ("stop");
-            Schedule.clear ();
-        }
+        void clear_schedule ();
                 
         /**
          * Set %schedule to use once the current one stops. Overrides
@@ -281,7 +307,39 @@ namespace world
          * @return a new tuple with the schedule at first position.
          */
         PyObject *add_schedule (PyObject *args) const;
-        
+
+        /**
+         * Pass the arguments given to set_manager or set_schedule
+         * to a native %behaviour.
+         * @param native the newly created %behaviour.
+         * @param args arguments for the %behaviour.
+         * @return \e false if the arguments are not valid.
+         */
+        bool init_behaviour (behaviour *native, PyObject *args);
+
+        /**
+         * Restore manager or schedule from a saved record.
+         * @param script the script to restore, unless native.
+         * @param native the %behaviour to restore, if native.
+         * @param record stream to load the script or %behaviour from.
+         * @return \e true on success, \e false otherwise.
+         */
+        bool load_script (python::script & script, behaviour *& native, base::flat & record);
+
+        /**
+         * Stop and delete a %behaviour that is no longer used. A manager
+         * replacing itself from within its run method is only deleted
+         * once that method returns.
+         * @param native the %behaviour to get rid of.
+         */
+        void delete_behaviour (behaviour *native);
+
+        /// call start method of the current schedule
+        void start_schedule ();
+
+        /// call pause method of the current schedule
+        void pause_schedule ();
+
         /// callback for alarm event
         void on_alarm (const events::event *evt) { set_running (false); }
 
@@ -296,6 +354,18 @@ namespace world
         
         /// the script describing a specific activity in detail.
         python::script Schedule;
+
+        /// cached methods of the manager and schedule scripts
+        python::script::method_handle Run, Start, Pause, Resume, Stop;
+
+        /// native manager, used instead of the manager script
+        behaviour *ManagerBehaviour;
+
+        /// native schedule, used instead of the schedule script
+        behaviour *ScheduleBehaviour;
+
+        /// native manager whose run method is currently executing
+        behaviour *RunningManager;
         
         /// store the alarm event to execute the manager script at a certain time
         events::factory Factory;
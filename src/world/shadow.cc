@@ -40,39 +40,65 @@ shadow::shadow (const std::string & shadow, const coordinates *pos, const vector
     Shadow = gfx::surfaces->get_surface_only (shadow, true, false);
     Offset = offset;
     Pos = pos;
-    init ();
 }
 
 // dtor
 shadow::~shadow ()
 {
+    // objects must not refer to the shadow after it is gone
+    reset ();
+
     gfx::surfaces->free_surface (Shadow);
     Shadow = NULL;
 }
 
-// init at the beginning of each frame
-void shadow::init ()
+// prepare casting shadow onto the given objects
+bool shadow::init (const std::list<chunk_info*> & ground)
 {
-    // prepare shadow for next frame
+    vector3<s_int32> pos (Pos->x() + Offset.x(), Pos->y() + Offset.y(), Pos->z());
+
+    // nothing has moved since last time?
+    if (pos == CastPos && ground.size() == Ground.size())
+    {
+        std::vector<ground_info>::const_iterator g = Ground.begin();
+        std::list<chunk_info*>::const_iterator ci = ground.begin();
+
+        for (; ci != ground.end(); ci++, g++)
+        {
+            if (g->Object != *ci || g->Pos != (*ci)->Min || g->State != (*ci)->get_object()->state_id()) break;
+        }
+
+        if (ci == ground.end()) return true;
+    }
+
+    // remove outdated shadow
+    reset ();
+
+    CastPos = pos;
+    for (std::list<chunk_info*>::const_iterator ci = ground.begin(); ci != ground.end(); ci++)
+    {
+        Ground.push_back (ground_info (*ci, (*ci)->Min, (*ci)->get_object()->state_id()));
+    }
+
+    // prepare shadow for casting
     Remaining.clear();
-    drawing_area area (Pos->x() + Offset.x(), Pos->y() + Offset.y(), Shadow->length(), Shadow->height());
+    drawing_area area (pos.x(), pos.y(), Shadow->length(), Shadow->height());
     Remaining.push_back (area);
+
+    return false;
 }
 
-// cleanup at the end of each frame
+// remove shadow from all objects
 void shadow::reset ()
 {
-    // prepare shadow for next frame
-    s_int32 x = Pos->x() + Offset.x();
-    s_int32 y = Pos->y() + Offset.y();
-
     // clean tiles with shadow on them
     for (std::vector<chunk_info*>::const_iterator i = TilesWithShadow.begin(); i != TilesWithShadow.end(); i++)
     {
-        (*i)->remove_shadow(x, y);
+        (*i)->remove_shadow (this);
     }
 
     TilesWithShadow.clear();
+    Ground.clear();
 }
 
 // cast shadow on a "floor" object
@@ -106,7 +132,7 @@ void shadow::cast_on (chunk_info* ci)
             // if (shape_distance < 0) continue;
 
             // data for rendering shadow later on
-            shadow_info si (Pos->x() + Offset.x(), Pos->y() + Offset.y(), Shadow, shape_distance);
+            shadow_info si (CastPos.x(), CastPos.y(), Shadow, shape_distance, this, *i);
 
             // floor surface area
             drawing_area obj_surface (ci->Min.x() + shape->x(),
@@ -142,9 +168,12 @@ void shadow::cast_on (chunk_info* ci)
             if (si.Area.size() > 0)
             {
                 // assign shadow to floor ...
-                ci->add_shadow (*i, si);
+                ci->add_shadow (si);
                 // ... and remember for later cleanup
-                TilesWithShadow.push_back (ci);
+                if (TilesWithShadow.empty() || TilesWithShadow.back() != ci)
+                {
+                    TilesWithShadow.push_back (ci);
+                }
             }
         }
     }
@@ -45,6 +45,11 @@ class chunk_info;
  * represent the shadow. Depending on the distance between
  * character and ground, the opacity of the shadow will be
  * changed.
+ *
+ * Shadow fragments stay attached to the objects they are cast
+ * on until the shadow is cast again. As long as neither the
+ * shadow nor the objects below it have moved, the fragments
+ * of the previous frame are reused.
  */
 class shadow
 {
@@ -58,17 +63,26 @@ public:
     shadow (const std::string & shadow, const coordinates * pos, const vector3<s_int32> & offset);
 
     /**
-     * Destroy shadow object.
+     * Remove shadow from all objects it has been cast on and
+     * destroy shadow object.
      */
     ~shadow ();
 
     /**
-     * Initialize shadow at the beginning of a frame.
+     * Prepare casting the shadow onto the given objects, which must
+     * be sorted by their z-order. If the shadow has already been cast
+     * onto the same objects in the same state from the same position,
+     * nothing needs to be done. Otherwise, the shadow is removed from
+     * the objects it has previously been cast on and casting starts anew.
+     *
+     * @param ground the objects below the shadow casting object.
+     * @return \b true if the shadow from the previous frame is still
+     *      valid, \b false if it needs to be cast with cast_on().
      */
-    void init();
+    bool init (const std::list<chunk_info*> & ground);
     
     /**
-     * Clear shadow object before rendering next frame.
+     * Remove shadow from all objects it has been cast on.
      */
     void reset ();
     
@@ -87,6 +101,22 @@ public:
 private:
     /// a list of shadow pieces
     typedef std::list<gfx::drawing_area> parts;
+
+    /// an object below the shadow and its position and state when the shadow was cast
+    struct ground_info
+    {
+        ground_info (const chunk_info *object, const vector3<s_int32> & pos, const u_int16 & state)
+            : Object (object), Pos (pos), State (state)
+        {
+        }
+
+        /// the object below the shadow
+        const chunk_info *Object;
+        /// its position
+        vector3<s_int32> Pos;
+        /// its state, which determines the shape the shadow is cast on
+        u_int16 State;
+    };
     
     /// current position of shadow casting object
     const coordinates *Pos;
@@ -104,6 +134,16 @@ private:
     /// list of objects with a shadow on them
     std::vector<chunk_info*> TilesWithShadow;
     ///@}
+
+    /**
+     * @name Cast cache
+     */
+    ///@{
+    /// position the shadow was last cast from
+    vector3<s_int32> CastPos;
+    /// objects below the shadow when it was last cast
+    std::vector<ground_info> Ground;
+    ///@}
 };
 
 }
@@ -31,12 +31,15 @@
 #ifndef WORLD_SHADOW_INFO_H
 #define WORLD_SHADOW_INFO_H
 
-#include <list>
+#include <vector>
 #include <adonthell/gfx/surface.h>
 
 namespace world
 {
-    
+
+class shadow;
+class placeable_model;
+
 /**
  * Container class for date required to render shadow onto a placeable.
  */
@@ -49,20 +52,26 @@ public:
      * @param y y-coordinate of shadow casting object.
      * @param image graphical representation of shadow.
      * @param distance distance between object and its shadow.
+     * @param caster the %shadow this information belongs to.
+     * @param model part of the placeable the shadow is cast on.
      */
-    shadow_info (const s_int32 & x, const s_int32 & y, const gfx::surface *image, const s_int32 & distance)
+    shadow_info (const s_int32 & x, const s_int32 & y, const gfx::surface *image, const s_int32 & distance,
+                 const shadow *caster, const placeable_model *model)
     {
         X = x;
         Y = y;
         Image = (gfx::surface *) image;
         Distance = distance;
+        Caster = caster;
+        Model = model;
     }
 
     /**
      * Copy constructor.
      * @param si %shadow info structure to create a copy of.
      */
-    shadow_info (const shadow_info & si) : X (si.X), Y (si.Y), Distance (si.Distance), Image (si.Image)
+    shadow_info (const shadow_info & si) : X (si.X), Y (si.Y), Distance (si.Distance), Image (si.Image),
+        Caster (si.Caster), Model (si.Model)
     {
         Area = si.Area;
     }
@@ -75,8 +84,12 @@ public:
     s_int32 Distance;
     /// image representing the shadow
     gfx::surface *Image;
+    /// the shadow casting object
+    const shadow *Caster;
+    /// part of the placeable the shadow is cast on
+    const placeable_model *Model;
     /// parts of the shadow to render
-    std::list<gfx::drawing_area> Area;
+    std::vector<gfx::drawing_area> Area;
 };
 
 }
@@ -0,0 +1,313 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   world/test_area.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for updating the area class.
+ *
+ *
+ */
+
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+
+#include "area_manager.h"
+#include "moving.h"
+#include "object.h"
+
+#include <gtest/gtest.h>
+
+namespace world
+{
+    /**
+     * A moving object that other objects collide with.
+     */
+    class mover : public moving
+    {
+    public:
+        mover (area & mymap) : moving (mymap, "")
+        {
+            Type = CHARACTER;
+        }
+    };
+
+    class area_Test : public ::testing::Test {
+
+    protected:
+        /**
+         * Add a solid shape of given extent to the object.
+         */
+        void add_cube (placeable & object, const vector3<s_int16> & min, const vector3<s_int16> & max)
+        {
+            cube3 *part = new cube3 (min, max);
+            part->create_bounding_box ();
+            part->create_mesh ();
+
+            placeable_model *model = new placeable_model;
+            placeable_shape *shape = model->add_shape ("default");
+            shape->add_part (part);
+            shape->set_solid (true);
+
+            object.add_model (model);
+            object.set_state ("default");
+        }
+
+        /**
+         * Create a map with a floor and a number of objects walking around
+         * in a grid with given spacing.
+         */
+        void populate (area & map, const u_int32 & count, const s_int16 & spacing)
+        {
+            object *floor = new object (map, "");
+            add_cube (*floor, vector3<s_int16>(0, 0, 0), vector3<s_int16>(2048, 2048, 10));
+
+            coordinates pos (0, 0, 0);
+            map.place_entity (map.add_entity (new entity (floor)), pos);
+
+            const u_int32 columns = 16;
+            for (u_int32 i = 0; i < count; i++)
+            {
+                moving *m = new mover (map);
+                add_cube (*m, vector3<s_int16>(0, 0, 0), vector3<s_int16>(16, 16, 32));
+
+                m->set_position (200 + (i % columns) * spacing, 200 + (i / columns) * spacing);
+                m->set_altitude (20 + i % 3);
+                m->set_velocity ((float) (i % 5) - 2.0f, (float) ((i * 7) % 5) - 2.0f);
+
+                std::ostringstream id;
+                id << "mover_" << i;
+                map.place_entity (map.add_entity (new named_entity (m, id.str ())), *m);
+                Movers.push_back (m);
+            }
+        }
+
+        /**
+         * Update a freshly populated map for a number of frames and
+         * return the final position of each moving object.
+         */
+        std::vector<vector3<s_int32> > run (const u_int32 & threads, const u_int32 & count, const s_int16 & spacing, const u_int32 & frames)
+        {
+            area map;
+            Movers.clear ();
+            populate (map, count, spacing);
+
+            map.set_update_threads (threads);
+            EXPECT_EQ(threads, map.update_threads ());
+
+            for (u_int32 i = 0; i < frames; i++)
+            {
+                map.update ();
+            }
+
+            std::vector<vector3<s_int32> > result;
+            for (std::vector<moving*>::const_iterator m = Movers.begin(); m != Movers.end(); m++)
+            {
+                result.push_back (vector3<s_int32> ((*m)->x(), (*m)->y(), (*m)->z()));
+            }
+            return result;
+        }
+
+        std::vector<moving*> Movers;
+    }; // class{}
+
+    TEST_F(area_Test, parallel_matches_serial) {
+        // objects far enough apart not to run into each other
+        std::vector<vector3<s_int32> > serial = run (0, 64, 100, 40);
+        std::vector<vector3<s_int32> > parallel = run (4, 64, 100, 40);
+
+        ASSERT_EQ(serial.size (), parallel.size ());
+        for (u_int32 i = 0; i < serial.size (); i++)
+        {
+            EXPECT_EQ(serial[i], parallel[i]) << "mover " << i;
+        }
+    }
+
+    TEST_F(area_Test, parallel_is_deterministic) {
+        // crowded objects that keep bumping into each other
+        std::vector<vector3<s_int32> > expected = run (1, 128, 20, 60);
+
+        for (u_int32 threads = 1; threads <= 4; threads++)
+        {
+            std::vector<vector3<s_int32> > result = run (threads, 128, 20, 60);
+            ASSERT_EQ(expected.size (), result.size ());
+            for (u_int32 i = 0; i < expected.size (); i++)
+            {
+                EXPECT_EQ(expected[i], result[i]) << "mover " << i << " with " << threads << " threads";
+            }
+        }
+    }
+
+    TEST_F(area_Test, idle_objects_are_skipped) {
+        for (u_int32 threads = 0; threads <= 2; threads += 2)
+        {
+            area map;
+            Movers.clear ();
+            populate (map, 32, 100);
+            map.set_update_threads (threads);
+
+            // the floor and all moving objects
+            EXPECT_EQ(33u, map.unique_entities ());
+
+            // stop every other object
+            for (u_int32 i = 0; i < Movers.size (); i += 2)
+            {
+                Movers[i]->set_velocity (0.0f, 0.0f);
+            }
+
+            // everyone is updated once, then only the moving objects
+            map.update ();
+            EXPECT_EQ(33u, map.active_entities ());
+
+            for (u_int32 i = 0; i < 20; i++)
+            {
+                map.update ();
+            }
+            EXPECT_EQ(16u, map.active_entities ());
+
+            // changing velocity wakes an object up ...
+            Movers[0]->set_velocity (1.0f, 0.0f);
+            map.update ();
+            EXPECT_EQ(17u, map.active_entities ());
+            EXPECT_EQ(201, Movers[0]->x());
+
+            // ... and it goes back to sleep once stopped
+            Movers[0]->set_velocity (0.0f, 0.0f);
+            map.update ();
+            EXPECT_EQ(17u, map.active_entities ());
+            map.update ();
+            EXPECT_EQ(16u, map.active_entities ());
+            EXPECT_EQ(201, Movers[0]->x());
+        }
+    }
+
+    TEST_F(area_Test, streamed_save) {
+        const std::string model_file = "/tmp/test_area_model";
+        const std::string map_file = "/tmp/test_area_map.gz";
+
+        area map;
+        object model (map, "");
+        add_cube (model, vector3<s_int16>(0, 0, 0), vector3<s_int16>(40, 40, 40));
+        ASSERT_TRUE(model.save_model (model_file));
+
+        object *obj = new object (map, "");
+        ASSERT_TRUE(obj->load_model (model_file));
+        obj->set_state ("default");
+
+        s_int32 index = map.add_entity (new entity (obj));
+        for (u_int32 i = 0; i < 2000; i++)
+        {
+            coordinates pos ((i % 50) * 50, (i / 50) * 50, 0);
+            map.place_entity (index, pos);
+        }
+        map.add_zone (new zone (zone::TYPE_RENDER, "zone", vector3<s_int32>(0, 0, 0), vector3<s_int32>(100, 100, 100)));
+
+        // binary maps are streamed to disk, but read like any other record
+        ASSERT_TRUE(map.save (map_file));
+        base::flat expected;
+        ASSERT_TRUE(map.put_state (expected));
+
+        base::diskio record;
+        ASSERT_TRUE(record.get_record (map_file));
+        EXPECT_EQ(expected.size (), record.size ());
+        EXPECT_EQ(expected.checksum (), record.checksum ());
+
+        area loaded;
+        ASSERT_TRUE(loaded.get_state (record));
+        EXPECT_EQ(2000u, loaded.objects_in_bbox (vector3<s_int32>(0, 0, 0), vector3<s_int32>(3000, 3000, 100)).size ());
+
+        remove (model_file.c_str ());
+        remove (map_file.c_str ());
+    }
+
+    TEST_F(area_Test, preloaded_map) {
+        const std::string model_file = "/tmp/test_area_model.xml";
+        const std::string map_file = "/tmp/test_area_map.xml";
+        const std::string other_file = "/tmp/test_area_other.xml";
+
+        // create a map from a model file
+        {
+            area map;
+            object model (map, "");
+            add_cube (model, vector3<s_int16>(0, 0, 0), vector3<s_int16>(40, 40, 40));
+            ASSERT_TRUE(model.save_model (model_file));
+
+            object *obj = new object (map, "");
+            ASSERT_TRUE(obj->load_model (model_file));
+            obj->set_state ("default");
+
+            s_int32 index = map.add_entity (new entity (obj));
+            for (u_int32 i = 0; i < 100; i++)
+            {
+                coordinates pos ((i % 10) * 50, (i / 10) * 50, 0);
+                map.place_entity (index, pos);
+            }
+            ASSERT_TRUE(map.save (map_file));
+            ASSERT_TRUE(map.save (other_file));
+        }
+
+        const u_int32 limit = area_manager::preload_limit ();
+        EXPECT_FALSE(area_manager::preload ("no_such_map.xml"));
+        ASSERT_TRUE(area_manager::preload (map_file));
+        for (u_int32 i = 0; i < 500 && !area_manager::is_preloaded (map_file); i++)
+        {
+            usleep (10000);
+        }
+        ASSERT_TRUE(area_manager::is_preloaded (map_file));
+        EXPECT_LT(0u, area_manager::preloaded_size ());
+
+        // preloaded map becomes active
+        ASSERT_TRUE(area_manager::set_active_map (map_file));
+        EXPECT_FALSE(area_manager::is_preloaded (map_file));
+        EXPECT_EQ(0u, area_manager::preloaded_size ());
+
+        area *map = area_manager::get_map ();
+        EXPECT_EQ(map_file, map->filename ());
+        EXPECT_EQ(100u, map->objects_in_bbox (vector3<s_int32>(0, 0, 0), vector3<s_int32>(1000, 1000, 100)).size ());
+
+        // maps exceeding the limit are discarded
+        ASSERT_TRUE(area_manager::preload (other_file));
+        for (u_int32 i = 0; i < 500 && !area_manager::is_preloaded (other_file); i++)
+        {
+            usleep (10000);
+        }
+        EXPECT_TRUE(area_manager::is_preloaded (other_file));
+        area_manager::set_preload_limit (1);
+        EXPECT_FALSE(area_manager::is_preloaded (other_file));
+        EXPECT_EQ(0u, area_manager::preloaded_size ());
+
+        area_manager::set_preload_limit (0);
+        EXPECT_FALSE(area_manager::preload (other_file));
+        area_manager::set_preload_limit (limit);
+
+        area_manager::cleanup ();
+        remove (model_file.c_str ());
+        remove (map_file.c_str ());
+        remove (other_file.c_str ());
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,246 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+
+/**
+ * @file   world/test_chunk.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for building and querying the chunk tree.
+ *
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "area.h"
+#include "object.h"
+
+#include <gtest/gtest.h>
+
+namespace world
+{
+    /// an object position, for comparing query results
+    typedef std::pair<const entity*, vector3<s_int32> > location;
+
+    class chunk_Test : public ::testing::Test {
+
+    protected:
+        /**
+         * Create the map objects that will be placed.
+         */
+        virtual void SetUp ()
+        {
+            static const s_int16 sizes[][3] = {
+                { 16, 16, 32 }, { 48, 48, 10 }, { 200, 40, 60 }, { 512, 512, 4 }, { 30, 300, 100 }
+            };
+
+            for (u_int32 i = 0; i < 5; i++)
+            {
+                object *obj = new object (Map, "");
+                cube3 *part = new cube3 (vector3<s_int16>(0, 0, 0), vector3<s_int16>(sizes[i][0], sizes[i][1], sizes[i][2]));
+                part->create_bounding_box ();
+
+                placeable_model *model = new placeable_model;
+                placeable_shape *shape = model->add_shape ("default");
+                shape->add_part (part);
+
+                obj->add_model (model);
+                obj->set_state ("default");
+
+                entity *ety = new entity (obj);
+                Map.add_entity (ety);
+                Entities.push_back (ety);
+            }
+        }
+
+        /**
+         * Scatter the given number of objects over the map.
+         */
+        void scatter (const u_int32 & count, const s_int32 & extent)
+        {
+            Positions.clear ();
+            srand (count);
+
+            for (u_int32 i = 0; i < count; i++)
+            {
+                coordinates pos (rand () % extent, rand () % extent, (rand () % 4) * 50);
+                Positions.push_back (std::make_pair (Entities[i % Entities.size ()], pos));
+            }
+        }
+
+        /**
+         * Add the scattered objects one by one to the first chunk and
+         * all at once to the second.
+         */
+        void populate (chunk & incremental, chunk & bulk)
+        {
+            std::vector<chunk_info*> objects;
+            for (std::vector<std::pair<entity*, coordinates> >::iterator i = Positions.begin(); i != Positions.end(); i++)
+            {
+                incremental.add (i->first, i->second);
+                objects.push_back (chunk::create_info (i->first, i->second));
+            }
+            bulk.add (objects);
+        }
+
+        /**
+         * Sorted locations of the given objects.
+         */
+        std::vector<location> locations (const std::list<chunk_info*> & objects)
+        {
+            std::vector<location> result;
+            for (std::list<chunk_info*>::const_iterator i = objects.begin(); i != objects.end(); i++)
+            {
+                result.push_back (std::make_pair ((*i)->get_entity (), (*i)->Min));
+            }
+            std::sort (result.begin(), result.end(), compare);
+            return result;
+        }
+
+        static bool compare (const location & a, const location & b)
+        {
+            if (a.first != b.first) return a.first < b.first;
+            if (a.second.x() != b.second.x()) return a.second.x() < b.second.x();
+            if (a.second.y() != b.second.y()) return a.second.y() < b.second.y();
+            return a.second.z() < b.second.z();
+        }
+
+        /**
+         * Check that both chunks return the same objects for a
+         * number of queries.
+         */
+        void expect_same (const chunk & expected, const chunk & result, const s_int32 & extent)
+        {
+            vector3<s_int32> all_min (-1000, -1000, -1000);
+            vector3<s_int32> all_max (extent + 1000, extent + 1000, 1000);
+            EXPECT_EQ(locations (expected.objects_in_bbox (all_min, all_max)), locations (result.objects_in_bbox (all_min, all_max)));
+
+            for (u_int32 i = 0; i < 50; i++)
+            {
+                vector3<s_int32> min (rand () % extent, rand () % extent, rand () % 200);
+                vector3<s_int32> max (min.x() + rand () % 400, min.y() + rand () % 400, min.z() + rand () % 200);
+                EXPECT_EQ(locations (expected.objects_in_bbox (min, max)), locations (result.objects_in_bbox (min, max)));
+
+                s_int32 x = rand () % extent, y = rand () % extent;
+                EXPECT_EQ(locations (expected.objects_in_view (x, y, 0, 640, 480)), locations (result.objects_in_view (x, y, 0, 640, 480)));
+            }
+        }
+
+        area Map;
+        std::vector<entity*> Entities;
+        std::vector<std::pair<entity*, coordinates> > Positions;
+    }; // class{}
+
+    TEST_F(chunk_Test, bulk_matches_incremental) {
+        const u_int32 counts[] = { 0, 1, 16, 17, 500, 5000 };
+        for (u_int32 i = 0; i < 6; i++)
+        {
+            chunk incremental, bulk;
+            scatter (counts[i], 8000);
+            populate (incremental, bulk);
+
+            EXPECT_EQ(incremental.min (), bulk.min ()) << counts[i] << " objects";
+            EXPECT_EQ(incremental.max (), bulk.max ()) << counts[i] << " objects";
+            EXPECT_EQ(counts[i], bulk.objects_in_bbox (bulk.min (), bulk.max ()).size ());
+            expect_same (incremental, bulk, 8000);
+        }
+    }
+
+    TEST_F(chunk_Test, bulk_then_incremental) {
+        chunk incremental, bulk;
+        scatter (2000, 6000);
+        populate (incremental, bulk);
+
+        // every object can be found and removed again
+        for (u_int32 i = 0; i < Positions.size (); i += 2)
+        {
+            EXPECT_TRUE(bulk.exists (Positions[i].first, Positions[i].second));
+            EXPECT_EQ(Positions[i].first, bulk.remove (Positions[i].first, Positions[i].second));
+            EXPECT_FALSE(bulk.exists (Positions[i].first, Positions[i].second));
+            incremental.remove (Positions[i].first, Positions[i].second);
+        }
+        expect_same (incremental, bulk, 6000);
+
+        // the tree keeps growing as usual
+        for (u_int32 i = 0; i < 500; i++)
+        {
+            coordinates pos (rand () % 9000 - 1000, rand () % 9000 - 1000, 0);
+            incremental.add (Entities[i % Entities.size ()], pos);
+            bulk.add (Entities[i % Entities.size ()], pos);
+        }
+        expect_same (incremental, bulk, 8000);
+
+        // adding many objects to a populated chunk
+        std::vector<chunk_info*> more;
+        for (u_int32 i = 0; i < 100; i++)
+        {
+            coordinates pos (i * 10, i * 20, 0);
+            incremental.add (Entities[0], pos);
+            more.push_back (chunk::create_info (Entities[0], pos));
+        }
+        bulk.add (more);
+        expect_same (incremental, bulk, 6000);
+    }
+
+    TEST_F(chunk_Test, stacked_objects) {
+        // objects that cannot be told apart must not split forever
+        chunk incremental, bulk;
+        Positions.clear ();
+        for (u_int32 i = 0; i < 200; i++)
+        {
+            Positions.push_back (std::make_pair (Entities[2], coordinates (1000, 1000, 0)));
+            Positions.push_back (std::make_pair (Entities[3], coordinates (10 * (i % 3), 0, 0)));
+        }
+        populate (incremental, bulk);
+        expect_same (incremental, bulk, 2000);
+        EXPECT_EQ(400u, bulk.objects_in_bbox (vector3<s_int32>(0, 0, 0), vector3<s_int32>(2000, 2000, 100)).size ());
+    }
+
+    TEST_F(chunk_Test, touching_objects) {
+        // floor tiles, each touching its neighbours
+        chunk incremental, bulk;
+        Positions.clear ();
+        for (u_int32 i = 0; i < 1600; i++)
+        {
+            Positions.push_back (std::make_pair (Entities[1], coordinates ((i % 40) * 48, (i / 40) * 48, 0)));
+        }
+        populate (incremental, bulk);
+
+        // the bbox of a tile also touches the 8 tiles around it
+        std::list<chunk_info*> all = bulk.objects_in_bbox (bulk.min (), bulk.max ());
+        for (std::list<chunk_info*>::const_iterator i = all.begin(); i != all.end(); i++)
+        {
+            const vector3<s_int32> & min = (*i)->Min;
+            u_int32 neighbours = (min.x() > 0 ? 1 : 0) + (min.x() < 39 * 48 ? 1 : 0) + 1;
+            neighbours *= (min.y() > 0 ? 1 : 0) + (min.y() < 39 * 48 ? 1 : 0) + 1;
+
+            EXPECT_EQ(neighbours, bulk.objects_in_bbox ((*i)->solid_min (), (*i)->solid_max ()).size ()) << min;
+            EXPECT_EQ(neighbours, incremental.objects_in_bbox ((*i)->solid_min (), (*i)->solid_max ()).size ()) << min;
+        }
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
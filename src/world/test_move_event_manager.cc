@@ -0,0 +1,155 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   world/test_move_event_manager.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for deferred dispatch of move events.
+ *
+ *
+ */
+
+#include <adonthell/event/factory.h>
+
+#include "area.h"
+#include "move_event.h"
+#include "move_event_manager.h"
+#include "moving.h"
+
+#include <gtest/gtest.h>
+
+namespace world
+{
+    /**
+     * A moving object.
+     */
+    class mover : public moving
+    {
+    public:
+        mover (area & mymap) : moving (mymap, "")
+        {
+            Type = CHARACTER;
+        }
+    };
+
+    /**
+     * A move event manager that reveals its queue.
+     */
+    class move_queue : public move_event_manager
+    {
+    public:
+        u_int32 queued () const
+        {
+            return Queue.size ();
+        }
+    };
+
+    /**
+     * Destroys an actor once another actor moves.
+     */
+    class destroyer
+    {
+    public:
+        destroyer (mover *victim) : Victim (victim), Moves (0)
+        {
+        }
+
+        void destroy (const events::event *e)
+        {
+            delete Victim;
+            Victim = NULL;
+        }
+
+        void count (const events::event *e)
+        {
+            Moves++;
+        }
+
+        /// the actor to destroy
+        mover *Victim;
+        /// moves of the victim raised
+        u_int32 Moves;
+    };
+
+    TEST(move_event_manager, destroyed_actor_leaves_queue) {
+        move_queue manager;
+        area map;
+        mover *gone = new mover (map);
+        mover stays (map);
+
+        // one queued move per actor
+        move_event first (gone);
+        move_event second (&stays);
+        manager.queue_event (&first);
+        manager.queue_event (&second);
+        manager.queue_event (&first);
+        EXPECT_EQ(2u, manager.queued ());
+
+        // the move of a destroyed actor is not dispatched
+        delete gone;
+        EXPECT_EQ(1u, manager.queued ());
+
+        manager.dispatch ();
+        EXPECT_EQ(0u, manager.queued ());
+
+        // actors destroyed after dispatch are no longer queued
+        mover *later = new mover (map);
+        move_event third (later);
+        manager.queue_event (&third);
+        manager.dispatch ();
+        delete later;
+        EXPECT_EQ(0u, manager.queued ());
+    }
+
+    TEST(move_event_manager, actor_destroyed_while_dispatching) {
+        const u_int8 modes[] = { events::DISPATCH_DEFERRED, events::DISPATCH_BATCHED };
+        for (u_int32 m = 0; m < 2; m++)
+        {
+            move_queue manager;
+            manager.set_dispatch_mode (modes[m]);
+
+            area map;
+            mover killer (map);
+            destroyer d (new mover (map));
+
+            events::factory factory;
+            factory.register_event (new move_event (&killer), base::make_functor (d, &destroyer::destroy));
+            factory.register_event (new move_event (d.Victim), base::make_functor (d, &destroyer::count));
+
+            move_event first (&killer);
+            move_event second (d.Victim);
+            manager.queue_event (&first);
+            manager.queue_event (&second);
+
+            // the first move destroys the actor of the second
+            manager.dispatch ();
+            EXPECT_TRUE(d.Victim == NULL);
+            EXPECT_EQ(0u, d.Moves);
+            EXPECT_EQ(0u, manager.queued ());
+        }
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
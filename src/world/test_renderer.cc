@@ -59,8 +59,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_1)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 224, -100), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 224, -100), NULL, NULL);
         
         EXPECT_EQ(false, is_object_below (obj1, obj2));
         EXPECT_EQ(true, is_object_below (obj2, obj1));
@@ -68,8 +68,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_2)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 280, -100), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 280, -100), NULL, NULL);
         
         EXPECT_EQ(false, is_object_below (obj1, obj2));
         EXPECT_EQ(true, is_object_below (obj2, obj1));
@@ -77,8 +77,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_3)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 196, -100), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 196, -100), NULL, NULL);
         
         EXPECT_EQ(false, is_object_below (obj1, obj2));
         EXPECT_EQ(true, is_object_below (obj2, obj1));
@@ -86,8 +86,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_4)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 182, -5), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 182, -5), NULL, NULL);
         
         EXPECT_EQ(true, is_object_below (obj1, obj2));
         EXPECT_EQ(false, is_object_below (obj2, obj1));
@@ -95,8 +95,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_5)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 280, -5), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 280, -5), NULL, NULL);
         
         EXPECT_EQ(true, is_object_below (obj1, obj2));
         EXPECT_EQ(false, is_object_below (obj2, obj1));
@@ -104,8 +104,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_6)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 224, -5), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 224, -5), NULL, NULL);
         
         EXPECT_EQ(true, is_object_below (obj1, obj2));
         EXPECT_EQ(false, is_object_below (obj2, obj1));
@@ -113,8 +113,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_7)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 0, 0), NULL);
-        render_info obj2 (&s1, NULL, vector3<s_int32>(-256, 96, 0), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 0, 0), NULL, NULL);
+        render_info obj2 (&s1, NULL, vector3<s_int32>(-256, 96, 0), NULL, NULL);
 
         EXPECT_EQ(true, is_object_below (obj1, obj2));
         EXPECT_EQ(false, is_object_below (obj2, obj1));
@@ -122,8 +122,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_8)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 91, 0), NULL);
-        render_info obj2 (&s1, NULL, vector3<s_int32>(-256, 96, 5), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 91, 0), NULL, NULL);
+        render_info obj2 (&s1, NULL, vector3<s_int32>(-256, 96, 5), NULL, NULL);
 
         EXPECT_EQ(obj1.min_yz(), obj2.min_yz());
         EXPECT_EQ(obj1.max_yz(), obj2.max_yz());
@@ -134,8 +134,8 @@ namespace world
 
     TEST_F(renderer_Test, is_object_below_9)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 91, 0), NULL);
-        render_info obj2 (&s1, NULL, vector3<s_int32>(-256, 192, 101), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 91, 0), NULL, NULL);
+        render_info obj2 (&s1, NULL, vector3<s_int32>(-256, 192, 101), NULL, NULL);
 
         EXPECT_EQ(obj1.min_yz(), obj2.min_yz());
         EXPECT_EQ(obj1.max_yz(), obj2.max_yz());
@@ -147,8 +147,8 @@ namespace world
 /*
     TEST_F(renderer_Test, is_object_below_7)
     {
-        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL);
-        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 224, -100), NULL);
+        render_info obj1 (&s1, NULL, vector3<s_int32>(-256, 192, 0), NULL, NULL);
+        render_info obj2 (&s2, NULL, vector3<s_int32>(-256, 224, -100), NULL, NULL);
         
         EXPECT_EQ(true, is_object_below (obj1, obj2));
         EXPECT_EQ(false, is_object_below (obj2, obj1));
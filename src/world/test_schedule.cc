@@ -0,0 +1,248 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   world/test_schedule.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Unit tests for native character schedules.
+ *
+ *
+ */
+
+#include "schedule.h"
+
+#include <gtest/gtest.h>
+
+namespace world
+{
+    /// calls received by the test behaviours
+    static std::vector<std::string> Calls;
+
+    /**
+     * Manager that always picks the test activity.
+     */
+    class test_manager : public behaviour
+    {
+    public:
+        void run (schedule *s)
+        {
+            Calls.push_back ("run");
+            s->set_schedule ("test_activity");
+        }
+
+        static behaviour *create () { return new test_manager (); }
+    };
+
+    /**
+     * Activity that records the calls it receives.
+     */
+    class test_activity : public behaviour
+    {
+    public:
+        test_activity () : Starts (0) { }
+
+        void start (schedule *s) { Calls.push_back ("start"); Starts++; }
+        void pause (schedule *s) { Calls.push_back ("pause"); }
+        void resume (schedule *s) { Calls.push_back ("resume"); }
+        void stop (schedule *s) { Calls.push_back ("stop"); }
+
+        void put_state (base::flat & file) const { file.put_uint32 ("tst", Starts); }
+        bool get_state (schedule *s, base::flat & file) { Starts = file.get_uint32 ("tst"); return file.success (); }
+
+        static behaviour *create () { return new test_activity (); }
+
+        u_int32 Starts;
+    };
+
+    /**
+     * Manager that replaces itself with the test manager.
+     */
+    class replacing_manager : public behaviour
+    {
+    public:
+        ~replacing_manager () { Calls.push_back ("deleted"); }
+
+        void run (schedule *s)
+        {
+            s->set_manager ("test_manager");
+            Calls.push_back ("replaced");
+            s->set_schedule ("test_activity");
+        }
+
+        static behaviour *create () { return new replacing_manager (); }
+    };
+
+    class schedule_Test : public ::testing::Test {
+
+    protected:
+        virtual void SetUp ()
+        {
+            Calls.clear ();
+            behaviour::add ("test_manager", &test_manager::create);
+            behaviour::add ("test_activity", &test_activity::create);
+            behaviour::add ("replacing_manager", &replacing_manager::create);
+        }
+
+        virtual void TearDown ()
+        {
+            behaviour::remove ("test_manager");
+            behaviour::remove ("test_activity");
+            behaviour::remove ("replacing_manager");
+        }
+
+        /**
+         * Return the calls made since the last check.
+         */
+        std::string calls ()
+        {
+            std::string result;
+            for (std::vector<std::string>::const_iterator i = Calls.begin (); i != Calls.end (); i++)
+            {
+                if (i != Calls.begin ()) result += " ";
+                result += *i;
+            }
+            Calls.clear ();
+            return result;
+        }
+    }; // class{}
+
+    TEST_F(schedule_Test, native_calls) {
+        schedule s;
+        EXPECT_FALSE(s.needs_update ());
+
+        ASSERT_TRUE(s.set_manager ("test_manager"));
+        EXPECT_EQ(NULL, s.get_manager ());
+        EXPECT_TRUE(s.needs_update ());
+
+        // manager picks and starts the activity
+        s.update ();
+        EXPECT_EQ("run start", calls ());
+        EXPECT_TRUE(s.is_running ());
+        EXPECT_FALSE(s.needs_update ());
+
+        s.set_active (false);
+        s.set_active (false);
+        s.set_active (true);
+        EXPECT_EQ("pause", calls ());
+        s.set_active (true);
+        EXPECT_EQ("resume", calls ());
+
+        // stopping the activity runs the manager again
+        s.set_running (false);
+        EXPECT_TRUE(s.needs_update ());
+        s.update ();
+        EXPECT_EQ("stop run start", calls ());
+
+        // activities started while inactive are paused right away
+        s.set_active (false);
+        s.set_running (false);
+        s.update ();
+        EXPECT_EQ("pause stop run start pause", calls ());
+    }
+
+    TEST_F(schedule_Test, replaced_behaviours) {
+        schedule s;
+        ASSERT_TRUE(s.set_manager ("test_manager"));
+        s.update ();
+        EXPECT_EQ("run start", calls ());
+
+        // a stopped activity replaced before the next update is stopped
+        s.set_running (false);
+        EXPECT_TRUE(s.set_schedule ("test_activity"));
+        EXPECT_EQ("stop", calls ());
+
+        // a manager replacing itself is deleted after it returns
+        s.set_running (false);
+        ASSERT_TRUE(s.set_manager ("replacing_manager"));
+        s.update ();
+        EXPECT_EQ("stop replaced deleted start", calls ());
+
+        s.set_running (false);
+        s.update ();
+        EXPECT_EQ("stop run start", calls ());
+    }
+
+    TEST_F(schedule_Test, save_and_load) {
+        base::flat record;
+        {
+            schedule s;
+            ASSERT_TRUE(s.set_manager ("test_manager"));
+            s.update ();
+            s.set_active (false);
+            s.put_state (record);
+        }
+        EXPECT_EQ("run start pause stop", calls ());
+
+        // activity is restarted and paused again
+        schedule s;
+        ASSERT_TRUE(s.get_state (record));
+        EXPECT_EQ("start pause", calls ());
+        EXPECT_TRUE(s.is_running ());
+
+        // state of the activity has been restored
+        base::flat again;
+        s.put_state (again);
+        base::flat activity = again.get_flat ("sdl");
+        EXPECT_EQ("test_activity", activity.get_string ("script"));
+        EXPECT_EQ(2u, activity.get_uint32 ("tst"));
+    }
+
+    TEST_F(schedule_Test, stock_arguments) {
+        Py_Initialize ();
+
+        schedule s;
+        ASSERT_TRUE(s.set_manager ("test_manager"));
+        EXPECT_FALSE(s.set_schedule ("patrol"));
+        EXPECT_FALSE(s.set_schedule ("wander"));
+
+        PyObject *args = Py_BuildValue ("(s)", "somewhere");
+        EXPECT_FALSE(s.set_schedule ("go_and_wait", args));
+        EXPECT_TRUE(s.set_schedule ("wander", args));
+        Py_DECREF (args);
+        s.set_running (false);
+
+        args = Py_BuildValue ("(sis)", "here", 5, "there");
+        EXPECT_TRUE(s.set_schedule ("patrol", args));
+        Py_DECREF (args);
+
+        base::flat record;
+        s.put_state (record);
+
+        schedule loaded;
+        ASSERT_TRUE(loaded.get_state (record));
+
+        // without owner, the patrol stops immediately
+        EXPECT_FALSE(loaded.is_running ());
+        loaded.set_running (true);
+
+        base::flat again;
+        loaded.put_state (again);
+        EXPECT_EQ(record.checksum (), again.checksum ());
+
+        Py_Finalize ();
+    }
+} // namespace{}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
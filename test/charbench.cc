@@ -0,0 +1,107 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   test/charbench.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Measure how many movement changes per second a character
+ *         can process, including velocity, state and verbose logging.
+ *
+ * Usage: charbench [changes]
+ *
+ * Compare builds with and without STRIP_VLOG to see the cost of
+ * disabled verbose logging.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+
+#include "world/area.h"
+#include "world/character.h"
+
+/// current time in milliseconds
+static double now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/// give the character a shape for each of its movement states
+static void add_states (world::character & chr)
+{
+    const char *directions[] = { "n", "e", "s", "w" };
+    const char *motions[] = { "_stand", "_walk", "_run" };
+
+    world::placeable_model *model = new world::placeable_model;
+    for (u_int32 d = 0; d < 4; d++)
+    {
+        for (u_int32 m = 0; m < 3; m++)
+        {
+            world::cube3 *part = new world::cube3 (world::vector3<s_int16>(0, 0, 0), world::vector3<s_int16>(20, 20, 40));
+            part->create_bounding_box ();
+
+            world::placeable_shape *shape = model->add_shape (std::string (directions[d]) + motions[m]);
+            shape->add_part (part);
+            shape->set_solid (true);
+        }
+    }
+
+    chr.add_model (model);
+    chr.set_state ("s_stand");
+}
+
+int main (int argc, char* argv[])
+{
+    u_int32 count = argc > 1 ? atoi (argv[1]) : 1000000;
+    if (count == 0) count = 1;
+
+    world::area map;
+    world::character chr (map, "");
+    add_states (chr);
+
+    // walk and run in all directions, stopping in between
+    const s_int32 dirs[] = {
+        world::character::NORTH, world::character::NORTH | world::character::EAST, world::character::EAST, 0,
+        world::character::SOUTH, world::character::SOUTH | world::character::WEST, world::character::WEST, 0
+    };
+
+    double start = now ();
+    for (u_int32 i = 0; i < count; i++)
+    {
+        if (i % 64 == 0)
+        {
+            if (chr.is_running ()) chr.walk ();
+            else chr.run ();
+        }
+        chr.set_direction (dirs[i % 8]);
+    }
+    double time = now () - start;
+
+#ifdef STRIP_VLOG
+    printf ("verbose logging compiled out\n");
+#else
+    printf ("verbose logging compiled in\n");
+#endif
+    printf ("  %u changes %9.3f ms %12.0f changes/sec\n", count, time, count * 1000.0 / time);
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+
+/**
+ * @file   test/chunkbench.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Compare building the chunk tree one object at a time and all
+ *         at once, as well as the cost of querying the resulting trees.
+ *
+ * Usage: chunkbench [objects] [repetitions]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+
+#include "world/area.h"
+#include "world/object.h"
+
+/// current time in milliseconds
+static double now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/// create a map object of the given size
+static world::entity *create (world::area & map, const s_int16 & x, const s_int16 & y, const s_int16 & z)
+{
+    world::object *obj = new world::object (map, "");
+    world::cube3 *part = new world::cube3 (world::vector3<s_int16>(0, 0, 0), world::vector3<s_int16>(x, y, z));
+    part->create_bounding_box ();
+
+    world::placeable_model *model = new world::placeable_model;
+    world::placeable_shape *shape = model->add_shape ("default");
+    shape->add_part (part);
+
+    obj->add_model (model);
+    obj->set_state ("default");
+
+    world::entity *ety = new world::entity (obj);
+    map.add_entity (ety);
+    return ety;
+}
+
+/// run a number of collision and view queries on the given chunk
+static u_int32 query (const world::chunk & tree, const s_int32 & extent)
+{
+    u_int32 found = 0;
+    srand (1);
+
+    for (u_int32 i = 0; i < 1000; i++)
+    {
+        world::vector3<s_int32> min (rand () % extent, rand () % extent, 0);
+        world::vector3<s_int32> max (min.x() + 40, min.y() + 40, 100);
+        found += tree.objects_in_bbox (min, max).size ();
+    }
+    for (u_int32 i = 0; i < 100; i++)
+    {
+        found += tree.objects_in_view (rand () % extent, rand () % extent, 0, 640, 480).size ();
+    }
+    return found;
+}
+
+int main (int argc, char* argv[])
+{
+    u_int32 count = argc > 1 ? atoi (argv[1]) : 20000;
+    u_int32 repeat = argc > 2 ? atoi (argv[2]) : 10;
+    if (repeat == 0) repeat = 1;
+
+    // roughly the mix of a map: floor tiles, walls, scenery and characters
+    world::area map;
+    world::entity *kinds[] = {
+        create (map, 80, 80, 4), create (map, 160, 20, 120), create (map, 60, 40, 80), create (map, 16, 16, 32)
+    };
+
+    const s_int32 extent = (s_int32) sqrt ((double) count) * 80;
+    std::vector<std::pair<world::entity*, world::coordinates> > positions;
+    srand (count);
+    for (u_int32 i = 0; i < count; i++)
+    {
+        world::coordinates pos (rand () % extent, rand () % extent, (i % 4 == 0) ? 0 : 4);
+        positions.push_back (std::make_pair (kinds[i % 4], pos));
+    }
+
+    double incremental = 0, bulk = 0, incremental_query = 0, bulk_query = 0;
+    u_int32 incremental_found = 0, bulk_found = 0;
+
+    for (u_int32 r = 0; r < repeat; r++)
+    {
+        world::chunk one, all;
+
+        double start = now ();
+        for (u_int32 i = 0; i < count; i++)
+        {
+            one.add (positions[i].first, positions[i].second);
+        }
+        incremental += now () - start;
+
+        start = now ();
+        std::vector<world::chunk_info*> objects;
+        objects.reserve (count);
+        for (u_int32 i = 0; i < count; i++)
+        {
+            objects.push_back (world::chunk::create_info (positions[i].first, positions[i].second));
+        }
+        all.add (objects);
+        bulk += now () - start;
+
+        start = now ();
+        incremental_found = query (one, extent);
+        incremental_query += now () - start;
+
+        start = now ();
+        bulk_found = query (all, extent);
+        bulk_query += now () - start;
+    }
+
+    printf ("%u objects on %d x %d pixels\n", count, extent, extent);
+    printf ("  incremental %9.3f ms build %9.3f ms query\n", incremental / repeat, incremental_query / repeat);
+    printf ("  bulk        %9.3f ms build %9.3f ms query\n", bulk / repeat, bulk_query / repeat);
+
+    return incremental_found == bulk_found ? 0 : 1;
+}
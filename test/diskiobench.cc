@@ -0,0 +1,178 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   test/diskiobench.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Compare save and load time and file size of the file formats.
+ *
+ * Usage: diskiobench [repetitions] [record files ...]
+ *
+ * Without files, data/test-world.xml and a record resembling a large
+ * map generated in memory are used.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "base/diskio.h"
+#include "base/diskwriter_xml.h"
+
+using std::cout;
+using std::endl;
+
+/// current time in milliseconds
+static double now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/// create a record with roughly the layout of a large map file
+static void generate (base::flat & record)
+{
+    base::flat objects;
+    for (u_int32 i = 0; i < 5000; i++)
+    {
+        base::flat shape;
+        shape.put_bool ("solid", true);
+        shape.put_sint16 ("min_x", i % 64);
+        shape.put_sint16 ("max_x", 64 + i % 32);
+        shape.put_string ("sprite", "gfx/mapobjects/some_object.xml");
+
+        base::flat object;
+        object.put_uint8 ("type", i % 3);
+        object.put_flat ("default", shape);
+
+        std::ostringstream id;
+        id << "object_" << i;
+        objects.put_flat (id.str (), object);
+    }
+    record.put_flat ("objects", objects);
+}
+
+/// save and load record with given format
+static void measure (const base::flat & record, const base::diskio::file_format & format, const char *name, const u_int32 & repeat)
+{
+    const char *filename = "diskiobench.tmp";
+    double save = 0, load = 0;
+
+    for (u_int32 i = 0; i < repeat; i++)
+    {
+        base::diskio out (format);
+        out.copy (record);
+
+        double start = now ();
+        out.put_record (filename);
+        save += now () - start;
+
+        base::diskio in (format);
+        start = now ();
+        in.get_record (filename);
+        load += now () - start;
+
+        if (in.checksum () != record.checksum ())
+        {
+            cout << "  " << name << ": checksum mismatch!" << endl;
+        }
+    }
+
+    struct stat statbuf;
+    stat (filename, &statbuf);
+    remove (filename);
+
+    printf ("  %-4s %9ld bytes %9.3f ms save %9.3f ms load\n", name, (long) statbuf.st_size, save / repeat, load / repeat);
+}
+
+/// load record from XML with the fast reader and with libxml2
+static void measure_readers (const base::flat & record, const u_int32 & repeat)
+{
+    const char *filename = "diskiobench.tmp";
+    base::disk_writer_xml writer;
+    base::flat copy (record), in;
+    writer.put_state (filename, copy);
+
+    // make sure the file is in the cache
+    writer.get_state (filename, in);
+
+    double fast = 0, sax = 0;
+    for (u_int32 i = 0; i < repeat; i++)
+    {
+        double start = now ();
+        writer.get_state (filename, in);
+        fast += now () - start;
+
+        start = now ();
+        writer.get_state_sax (filename, in);
+        sax += now () - start;
+    }
+    remove (filename);
+
+    printf ("  xml reader %9.3f ms load, libxml2 %9.3f ms load\n", fast / repeat, sax / repeat);
+}
+
+/// compare formats on given record
+static void compare (const base::flat & record, const std::string & title, const u_int32 & repeat)
+{
+    cout << title << " (" << record.size () << " bytes)" << endl;
+    measure (record, base::diskio::GZ_FILE, "gz", repeat);
+    measure (record, base::diskio::LZ_FILE, "lz", repeat);
+    measure (record, base::diskio::MAPPED_FILE, "map", repeat);
+    measure (record, base::diskio::XML_FILE, "xml", repeat);
+    measure_readers (record, repeat);
+}
+
+int main (int argc, char* argv[])
+{
+    u_int32 repeat = argc > 1 ? atoi (argv[1]) : 20;
+    if (repeat == 0) repeat = 1;
+
+    if (argc > 2)
+    {
+        for (int i = 2; i < argc; i++)
+        {
+            base::diskio record;
+            if (!record.get_record (argv[i]))
+            {
+                cout << "Cannot read " << argv[i] << endl;
+                continue;
+            }
+            compare (record, argv[i], repeat);
+        }
+        return 0;
+    }
+
+    base::diskio map;
+    if (map.get_record ("data/test-world.xml"))
+    {
+        compare (map, "data/test-world.xml", repeat);
+    }
+
+    base::flat large;
+    generate (large);
+    compare (large, "generated map", repeat);
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   test/eventbench.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Measure how many events per second can be passed to Python.
+ *
+ * Usage: eventbench [events]
+ *
+ * Requires the adonthell Python modules to be installed.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sys/time.h>
+
+#include "python/python.h"
+#include "event/time_event.h"
+
+using std::cout;
+using std::endl;
+
+/// current time in milliseconds
+static double now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/// print the rate of events per second
+static void report (const char *name, const u_int32 & count, const double & time)
+{
+    printf ("  %-16s %9.3f ms %12.0f events/sec\n", name, time, count * 1000.0 / time);
+}
+
+int main (int argc, char* argv[])
+{
+    u_int32 count = argc > 1 ? atoi (argv[1]) : 1000000;
+    if (count == 0) count = 1;
+
+    python::init ();
+    PyObject *module = python::import_module ("adonthell.event");
+    if (module == NULL)
+    {
+        cout << "Cannot import adonthell.event" << endl;
+        return 1;
+    }
+
+    PyObject *globals = PyModule_GetDict (module);
+    PyObject *callback = python::run_string ("lambda evt: evt.time ()", Py_eval_input, globals);
+    if (callback == NULL)
+    {
+        cout << "Cannot create callback" << endl;
+        return 1;
+    }
+
+    events::time_event evt (100);
+    cout << "Passing " << count << " events to Python" << endl;
+
+    // by type name, as before caching the type information
+    double start = now ();
+    for (u_int32 i = 0; i < count; i++)
+    {
+        PyObject *arg = cxx_to_py ((void *) &evt, evt.get_type_name (), python::c_owns);
+        Py_DECREF (arg);
+    }
+    report ("wrap by name", count, now () - start);
+
+    start = now ();
+    for (u_int32 i = 0; i < count; i++)
+    {
+        PyObject *arg = python::pass_instance (&evt);
+        Py_DECREF (arg);
+    }
+    report ("wrap cached", count, now () - start);
+
+    // including the call of the python callback
+    start = now ();
+    for (u_int32 i = 0; i < count; i++)
+    {
+        PyObject *args = PyTuple_New (1);
+        PyTuple_SET_ITEM (args, 0, python::pass_instance (&evt));
+        PyObject *result = PyObject_CallObject (callback, args);
+        Py_XDECREF (result);
+        Py_DECREF (args);
+    }
+    report ("deliver", count, now () - start);
+
+    // reusing argument tuple and event object, as listeners do
+    python::instance_wrapper wrapper;
+    PyObject *spare = NULL;
+
+    start = now ();
+    for (u_int32 i = 0; i < count; i++)
+    {
+        PyObject *args = python::take_args (spare, 1);
+        PyTuple_SET_ITEM (args, 0, wrapper.wrap (&evt));
+        PyObject *result = PyObject_Call (callback, args, NULL);
+        Py_XDECREF (result);
+        python::recycle_args (spare, args);
+    }
+    report ("deliver pooled", count, now () - start);
+    python::show_traceback ();
+    Py_XDECREF (spare);
+
+    Py_DECREF (callback);
+    Py_DECREF (module);
+    python::cleanup ();
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file   test/flatbench.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Compare reading nested records by copy and by view.
+ *
+ * Usage: flatbench [record file] [repetitions]
+ *
+ * Without a file, a record resembling a map with many objects
+ * is generated in memory.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <sys/time.h>
+
+#include "base/diskio.h"
+
+using std::cout;
+using std::endl;
+
+/// current time in milliseconds
+static double now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/// create a record with roughly the layout of a map file
+static void generate (base::flat & record)
+{
+    base::flat objects;
+    for (u_int32 i = 0; i < 2000; i++)
+    {
+        base::flat shape;
+        shape.put_bool ("solid", true);
+        shape.put_sint16 ("min_x", 0);
+        shape.put_sint16 ("max_x", 64);
+        shape.put_string ("sprite", "gfx/mapobjects/some_object.xml");
+
+        base::flat model;
+        model.put_flat ("default", shape);
+        model.put_flat ("open", shape);
+
+        base::flat object;
+        object.put_uint8 ("type", i % 3);
+        object.put_flat ("model", model);
+
+        std::ostringstream id;
+        id << "object_" << i;
+        objects.put_flat (id.str (), object);
+    }
+    record.put_flat ("objects", objects);
+}
+
+/// walk all nested records, copying each of them
+static u_int32 count_copy (base::flat & record)
+{
+    u_int32 size, count = 1;
+    void *value;
+
+    while (true)
+    {
+        base::flat::data_type type = record.next (&value, &size);
+        if (type == base::flat::T_UNKNOWN) break;
+        if (type == base::flat::T_FLAT)
+        {
+            base::flat nested ((const char*) value, size);
+            count += count_copy (nested);
+        }
+    }
+    return count;
+}
+
+/// walk all nested records, referring to each of them
+static u_int32 count_view (base::flat & record)
+{
+    u_int32 size, count = 1;
+    void *value;
+
+    while (true)
+    {
+        base::flat::data_type type = record.next (&value, &size);
+        if (type == base::flat::T_UNKNOWN) break;
+        if (type == base::flat::T_FLAT)
+        {
+            base::flat_view nested (value, size);
+            count += count_view (nested);
+        }
+    }
+    return count;
+}
+
+int main (int argc, char* argv[])
+{
+    base::diskio record;
+    u_int32 repeat = argc > 2 ? atoi (argv[2]) : 100;
+
+    if (argc > 1)
+    {
+        if (!record.get_record (argv[1]))
+        {
+            cout << "Cannot read " << argv[1] << endl;
+            return 1;
+        }
+    }
+    else
+    {
+        generate (record);
+    }
+
+    cout << "Record size: " << record.size () << " bytes" << endl;
+
+    u_int32 copied = 0, viewed = 0;
+
+    double start = now ();
+    for (u_int32 i = 0; i < repeat; i++)
+    {
+        record.first ();
+        copied += count_copy (record);
+    }
+    double copy_time = now () - start;
+
+    start = now ();
+    for (u_int32 i = 0; i < repeat; i++)
+    {
+        record.first ();
+        viewed += count_view (record);
+    }
+    double view_time = now () - start;
+
+    cout << "Records per pass: " << copied / repeat << endl;
+    cout << "Copy: " << copy_time / repeat << " ms per pass" << endl;
+    cout << "View: " << view_time / repeat << " ms per pass" << endl;
+
+    return copied == viewed ? 0 : 1;
+}
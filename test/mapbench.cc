@@ -0,0 +1,140 @@
+/*
+   Copyright (C) 2026 agent <agent@local>
+   Part of the Adonthell Project http://adonthell.linuxgames.com
+
+   Adonthell is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   Adonthell is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Adonthell; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+
+/**
+ * @file   test/mapbench.cc
+ * @author agent <agent@local>
+ *
+ * @brief  Compare loading a map saved in each file format, separating
+ *         the time spent reading the record from the time spent
+ *         creating the map from it.
+ *
+ * Usage: mapbench [objects] [repetitions]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "base/diskio.h"
+#include "world/area.h"
+#include "world/object.h"
+
+/// current time in milliseconds
+static double now ()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/// file holding the model shared by all objects
+static const char *MODEL = "mapbench_model.xml";
+
+/// create a map with the given number of objects
+static void generate (world::area & map, const u_int32 & count)
+{
+    world::object model (map, "");
+    world::cube3 *part = new world::cube3 (world::vector3<s_int16>(0, 0, 0), world::vector3<s_int16>(40, 40, 40));
+    part->create_bounding_box ();
+    part->create_mesh ();
+
+    world::placeable_model *shapes = new world::placeable_model;
+    world::placeable_shape *shape = shapes->add_shape ("default");
+    shape->add_part (part);
+    shape->set_solid (true);
+    model.add_model (shapes);
+    model.save_model (MODEL);
+
+    // some distinct objects, placed many times each
+    srand (count);
+    for (u_int32 i = 0; i < 16; i++)
+    {
+        world::object *obj = new world::object (map, "");
+        obj->load_model (MODEL);
+        obj->set_state ("default");
+
+        s_int32 index = map.add_entity (new world::entity (obj));
+        for (u_int32 j = i; j < count; j += 16)
+        {
+            world::coordinates pos (rand () % 4000, rand () % 4000, 0);
+            map.place_entity (index, pos);
+        }
+    }
+}
+
+/// load map saved with given format
+static void measure (world::area & map, const base::diskio::file_format & format, const char *name, const u_int32 & repeat)
+{
+    const char *filename = "mapbench.tmp";
+    if (!map.save (filename, format))
+    {
+        printf ("  %-4s cannot save map!\n", name);
+        return;
+    }
+
+    double read = 0, load = 0;
+    for (u_int32 i = 0; i < repeat; i++)
+    {
+        // reading the record alone
+        double start = now ();
+        {
+            base::diskio record (format);
+            record.get_record (filename);
+        }
+        read += now () - start;
+
+        // reading the record and creating the map
+        world::area loaded;
+        start = now ();
+        if (!loaded.load (filename))
+        {
+            printf ("  %-4s cannot load map!\n", name);
+            break;
+        }
+        load += now () - start;
+    }
+
+    struct stat statbuf;
+    stat (filename, &statbuf);
+    remove (filename);
+
+    printf ("  %-4s %9ld bytes %9.3f ms read %9.3f ms load\n", name, (long) statbuf.st_size, read / repeat, load / repeat);
+}
+
+int main (int argc, char* argv[])
+{
+    u_int32 count = argc > 1 ? atoi (argv[1]) : 20000;
+    u_int32 repeat = argc > 2 ? atoi (argv[2]) : 5;
+    if (repeat == 0) repeat = 1;
+
+    world::area map;
+    generate (map, count);
+
+    printf ("map with %u objects\n", count);
+    measure (map, base::diskio::GZ_FILE, "gz", repeat);
+    measure (map, base::diskio::LZ_FILE, "lz", repeat);
+    measure (map, base::diskio::MAPPED_FILE, "map", repeat);
+    measure (map, base::diskio::XML_FILE, "xml", repeat);
+
+    remove (MODEL);
+    return 0;
+}